@@ -0,0 +1,117 @@
+#pragma once
+#include <algorithm>
+#include <charconv>
+#include <cstdint>
+#include <cstdlib>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "core/Instrument.h"
+#include "replay/CaptureReader.h"
+#include "simdjson.h"
+
+// Bybit v5 public frames for the benchmarks, laid out as the receive path hands them to
+// the decoder: in a buffer with SIMDJSON_PADDING spare bytes.
+namespace bench {
+
+// Grid of the synthetic frames (BTCUSDT instruments-info)
+inline constexpr std::string_view BENCH_SYMBOL = "BTCUSDT";
+inline InstrumentSpec bench_instrument() {
+    InstrumentSpec spec;
+    InstrumentSpec::from_strings("0.10", "0.001", "0.001", spec);
+    return spec;
+}
+
+struct PaddedFrame {
+    std::vector<char> bytes;
+    size_t length = 0;
+    size_t update_id_offset = 0;        // Fixed-width "u" field (0: none, frame replayed verbatim)
+
+    static constexpr size_t UPDATE_ID_WIDTH = 20;
+
+    char* data() { return bytes.data(); }
+    size_t capacity() const { return bytes.size(); }
+
+    // Rewrites "u" in place: digits right-aligned, leading blanks are JSON whitespace
+    void set_update_id(uint64_t id) {
+        char digits[UPDATE_ID_WIDTH];
+        auto [end, ec] = std::to_chars(digits, digits + UPDATE_ID_WIDTH, id);
+        size_t n = static_cast<size_t>(end - digits);
+        char* field = bytes.data() + update_id_offset;
+        std::fill(field, field + UPDATE_ID_WIDTH - n, ' ');
+        std::copy(digits, end, field + UPDATE_ID_WIDTH - n);
+    }
+
+    static PaddedFrame from(std::string_view json, size_t update_id_offset = 0) {
+        PaddedFrame frame;
+        frame.bytes.assign(json.size() + SIMDJSON_PADDING, '\0');
+        std::copy(json.begin(), json.end(), frame.bytes.begin());
+        frame.length = json.size();
+        frame.update_id_offset = update_id_offset;
+        return frame;
+    }
+};
+
+// "orderbook.50.<symbol>" snapshot or delta with `levels` levels per side around 65000.0,
+// in the exchange's field order. A delta rewrites the quantities of the top `levels`
+// levels of the snapshot, so applying it never changes the book's depth.
+inline PaddedFrame make_book_frame(std::string_view symbol, bool snapshot, int levels, int qty_variant = 0) {
+    std::string json;
+    json.reserve(256 + static_cast<size_t>(levels) * 48);
+    json += R"({"topic":"orderbook.50.)";
+    json += symbol;
+    json += snapshot ? R"(","type":"snapshot")" : R"(","type":"delta")";
+    json += R"(,"ts":1735689600123,"data":{"s":")";
+    json += symbol;
+    json += R"(",)";
+
+    auto side = [&](const char* key, int64_t first_ticks, int64_t step) {
+        json += '"';
+        json += key;
+        json += R"(":[)";
+        for (int i = 0; i < levels; i++) {
+            int64_t ticks = first_ticks + step * i;
+            int64_t lots = 100 + 37 * i + qty_variant * 11;
+            if (i) json += ',';
+            json += R"([")";
+            json += std::to_string(ticks / 10) + "." + std::to_string(ticks % 10);
+            json += R"(",")";
+            json += std::to_string(lots / 1000) + "." + std::to_string(lots % 1000 + 1000).substr(1);
+            json += R"("])";
+        }
+        json += ']';
+    };
+    side("b", 650000, -1);
+    json += ',';
+    side("a", 650001, 1);
+
+    json += R"(,"u":)";
+    size_t update_id_offset = json.size();
+    json.append(PaddedFrame::UPDATE_ID_WIDTH, ' ');
+    json += R"(,"seq":7961638724},"cts":1735689600120})";
+
+    PaddedFrame frame = PaddedFrame::from(json, update_id_offset);
+    frame.set_update_id(1);
+    return frame;
+}
+
+// Recorded public frames of BENCH_CAPTURE (a capture prefix or segment file, see
+// BotConfiguration::capture_enabled), empty if the variable is unset or unreadable
+inline const std::vector<PaddedFrame>& captured_frames() {
+    static const std::vector<PaddedFrame> frames = [] {
+        std::vector<PaddedFrame> out;
+        const char* path = std::getenv("BENCH_CAPTURE");
+        if (!path || !*path) return out;
+
+        constexpr size_t MAX_FRAMES = 200000;
+        CaptureReader reader(CaptureReader::prefix_from_path(path));
+        CapturedFrame frame;
+        while (out.size() < MAX_FRAMES && reader.next(frame)) {
+            out.push_back(PaddedFrame::from(std::string_view(frame.data, frame.length)));
+        }
+        return out;
+    }();
+    return frames;
+}
+
+}  // namespace bench
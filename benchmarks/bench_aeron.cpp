@@ -0,0 +1,159 @@
+// benchmarks/bench_aeron.cpp
+// Aeron IPC round trip: an OrderBookSnapshot claimed and encoded in place by AeronPublisher
+// (as BookPublication does) until an in-process, AeronSpy-style subscriber has polled and
+// decoded it. Runs its own embedded media driver (GlobalMediaDriver), so it is skipped
+// on a host whose driver directory belongs to a running bot.
+#include <benchmark/benchmark.h>
+#include <Aeron.h>
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include "BenchPayloads.h"
+#include "core/OrderBook.h"
+#include "messaging/AeronPublisher.h"
+#include "messaging/SBEDecoder.h"
+#include "messaging/SBEEncoder.h"
+#include "utils/CpuPause.h"
+
+namespace {
+
+constexpr const char* CHANNEL = "aeron:ipc";
+constexpr int32_t STREAM_ID = 9101;         // Clear of the bot's 1001 / 1002
+constexpr uint32_t SYMBOL_ID = 1;
+constexpr int DEPTH = 10;                   // BookPublication::DEPTH
+
+struct AeronLoop {
+    std::unique_ptr<AeronPublisher> publisher;
+    std::shared_ptr<aeron::Aeron> aeron;
+    std::shared_ptr<aeron::Subscription> subscription;
+    uint64_t published = 0;                 // Benchmark thread only
+    std::atomic<uint64_t> received{0};
+    std::atomic<uint64_t> malformed{0};
+    std::atomic<bool> running{true};
+    std::thread spy;
+    bool ready = false;
+
+    OrderBook book{bench::bench_instrument()};
+    PriceLevel bids[DEPTH];
+    PriceLevel asks[DEPTH];
+
+    AeronLoop() {
+        std::vector<PriceLevel> full_bids, full_asks;
+        for (int i = 0; i < OrderBook::MAX_LEVELS; i++) {
+            full_bids.push_back({650000 - i, 100 + 37 * i});
+            full_asks.push_back({650001 + i, 100 + 41 * i});
+        }
+        book.apply_snapshot(full_bids, full_asks, 1, 0);
+
+        // SPIN: a round trip has one message in flight, it never parks
+        AeronPublishOptions options;
+        options.policy = BackPressurePolicy::SPIN;
+        publisher = std::make_unique<AeronPublisher>(CHANNEL, STREAM_ID, options);
+        if (!publisher->init()) return;
+
+        try {
+            aeron::Context context;
+            aeron = aeron::Aeron::connect(context);
+            int64_t id = aeron->addSubscription(CHANNEL, STREAM_ID);
+            auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+            while (!(subscription = aeron->findSubscription(id)) || !subscription->isConnected()) {
+                if (std::chrono::steady_clock::now() > deadline) return;
+                std::this_thread::yield();
+            }
+        } catch (const std::exception&) {
+            return;
+        }
+
+        spy = std::thread([this] {
+            aeron::fragment_handler_t handler = [this](aeron::AtomicBuffer& buffer, aeron::util::index_t offset,
+                                                       aeron::util::index_t length, aeron::Header&) {
+                sbe_codec::Frame frame;
+                char* data = reinterpret_cast<char*>(buffer.buffer() + offset);
+                if (sbe_codec::read_frame(data, static_cast<size_t>(length), frame) &&
+                    frame.template_id == trading::sbe::OrderBookSnapshot::sbeTemplateId()) {
+                    received.fetch_add(1, std::memory_order_release);
+                } else {
+                    malformed.fetch_add(1, std::memory_order_relaxed);
+                }
+            };
+            while (running.load(std::memory_order_relaxed)) {
+                if (subscription->poll(handler, 10) == 0) cpu_pause();
+            }
+        });
+        ready = true;
+    }
+
+    ~AeronLoop() {
+        running.store(false, std::memory_order_relaxed);
+        if (spy.joinable()) spy.join();
+    }
+
+    static AeronLoop& get() {
+        static AeronLoop loop;
+        return loop;
+    }
+
+    bool publish_snapshot() {
+        OrderBook::View top = book.copy_top(bids, asks, DEPTH);
+        size_t length = SBEEncoder::book_snapshot_length(static_cast<size_t>(top.bid_count),
+                                                         static_cast<size_t>(top.ask_count),
+                                                         bench::BENCH_SYMBOL.size());
+        bool sent = publisher->publish_claim(SYMBOL_ID, length, [&](char* buffer, size_t capacity) {
+            return SBEEncoder::encode_book_snapshot(buffer, capacity, 1735689600123000000ULL, SYMBOL_ID,
+                                                    bench::BENCH_SYMBOL, book.instrument(), top, DEPTH);
+        });
+        if (sent) published++;
+        return sent;
+    }
+
+    void wait_drained() const {
+        while (received.load(std::memory_order_acquire) < published) cpu_pause();
+    }
+};
+
+}  // namespace
+
+// Publish, then wait until the subscriber thread has decoded it
+static void BM_Aeron_RoundTrip(benchmark::State& state) {
+    AeronLoop& loop = AeronLoop::get();
+    if (!loop.ready) {
+        state.SkipWithError("no Aeron media driver / subscription (is a bot running on this host?)");
+        return;
+    }
+    uint64_t failures = 0;
+    loop.wait_drained();        // Backlog of an earlier publish-only run
+
+    for (auto _ : state) {
+        if (!loop.publish_snapshot()) {
+            failures++;
+            continue;
+        }
+        loop.wait_drained();
+    }
+
+    state.SetItemsProcessed(state.iterations());
+    state.counters["failures"] = static_cast<double>(failures);
+    state.counters["malformed"] = static_cast<double>(loop.malformed.load(std::memory_order_relaxed));
+}
+BENCHMARK(BM_Aeron_RoundTrip)->UseRealTime();
+
+// Publisher side alone (claim + encode + commit) with the subscriber draining behind
+static void BM_Aeron_PublishClaim(benchmark::State& state) {
+    AeronLoop& loop = AeronLoop::get();
+    if (!loop.ready) {
+        state.SkipWithError("no Aeron media driver / subscription (is a bot running on this host?)");
+        return;
+    }
+    uint64_t failures_before = loop.publisher->get_offer_failures();
+
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(loop.publish_snapshot());
+    }
+
+    state.SetItemsProcessed(state.iterations());
+    state.counters["failures"] = static_cast<double>(loop.publisher->get_offer_failures() - failures_before);
+}
+BENCHMARK(BM_Aeron_PublishClaim)->UseRealTime();
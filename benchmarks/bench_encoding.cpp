@@ -0,0 +1,120 @@
+// benchmarks/bench_encoding.cpp
+// Outbound serialization: SBE book messages (Aeron) and Bybit order requests
+// (the encoder behind BybitWebSocketClient::place_order / cancel_order).
+#include <benchmark/benchmark.h>
+#include <array>
+#include <vector>
+#include <libwebsockets.h>
+
+#include "BenchPayloads.h"
+#include "core/OrderBook.h"
+#include "messaging/SBEEncoder.h"
+#include "network/OrderRequestEncoder.h"
+#include "trading/ClientOrderId.h"
+
+namespace {
+
+constexpr uint32_t BENCH_SYMBOL_ID = 1;
+
+void fill_book(OrderBook& book) {
+    std::vector<PriceLevel> bids, asks;
+    for (int i = 0; i < OrderBook::MAX_LEVELS; i++) {
+        bids.push_back({650000 - i, 100 + 37 * i});
+        asks.push_back({650001 + i, 100 + 41 * i});
+    }
+    book.apply_snapshot(bids, asks, 1, 0);
+}
+
+}  // namespace
+
+// OrderBookSnapshot of the top range(0) levels, encoded inside read_consistent() as the
+// publisher does (into a claimed term buffer there, a local buffer here)
+static void BM_SBE_EncodeBookSnapshot(benchmark::State& state) {
+    OrderBook book(bench::bench_instrument());
+    fill_book(book);
+    const int depth = static_cast<int>(state.range(0));
+    alignas(64) std::array<char, SBEEncoder::SCRATCH_SIZE> buffer;
+    size_t length = 0;
+
+    for (auto _ : state) {
+        book.read_consistent([&](const OrderBook::View& view) {
+            length = SBEEncoder::encode_book_snapshot(buffer.data(), buffer.size(), 1735689600123000000ULL,
+                                                      BENCH_SYMBOL_ID, bench::BENCH_SYMBOL, book.instrument(),
+                                                      view, depth);
+        });
+        benchmark::DoNotOptimize(buffer.data());
+        benchmark::ClobberMemory();
+    }
+
+    if (length == 0) {
+        state.SkipWithError("encode_book_snapshot returned 0");
+        return;
+    }
+    state.SetItemsProcessed(state.iterations());
+    state.SetBytesProcessed(state.iterations() * static_cast<int64_t>(length));
+}
+BENCHMARK(BM_SBE_EncodeBookSnapshot)->Arg(1)->Arg(5)->Arg(10)->Arg(25)->Arg(50);
+
+// BookDelta of range(0) changed levels per side
+static void BM_SBE_EncodeBookDelta(benchmark::State& state) {
+    const InstrumentSpec instrument = bench::bench_instrument();
+    std::vector<PriceLevel> bids, asks;
+    for (int i = 0; i < state.range(0); i++) {
+        bids.push_back({650000 - i, 137 + i});
+        asks.push_back({650001 + i, 141 + i});
+    }
+    alignas(64) std::array<char, SBEEncoder::SCRATCH_SIZE> buffer;
+    uint64_t update_id = 2;
+    size_t length = 0;
+
+    for (auto _ : state) {
+        length = SBEEncoder::encode_book_delta(buffer.data(), buffer.size(), 1735689600123000000ULL,
+                                               BENCH_SYMBOL_ID, bench::BENCH_SYMBOL, instrument,
+                                               bids, asks, update_id, update_id - 1, update_id);
+        update_id++;
+        benchmark::DoNotOptimize(buffer.data());
+        benchmark::ClobberMemory();
+    }
+
+    state.SetItemsProcessed(state.iterations());
+    state.SetBytesProcessed(state.iterations() * static_cast<int64_t>(length));
+}
+BENCHMARK(BM_SBE_EncodeBookDelta)->Arg(1)->Arg(5)->Arg(10)->Arg(25)->Arg(50);
+
+// order.create as place_order() serializes it: order link ID from the engine's
+// ClientOrderId, prefix copy, timestamp patch, lots/ticks formatted on the grid
+static void BM_OrderRequest_EncodeCreate(benchmark::State& state) {
+    OrderRequestEncoder<LWS_PRE> encoder;
+    encoder.set_instrument(bench::BENCH_SYMBOL, bench::bench_instrument());
+    ClientOrderId id{1, static_cast<uint16_t>(BENCH_SYMBOL_ID), ClientOrderId::session_start()};
+    int64_t timestamp_ms = 1735689600123;
+    size_t length = 0;
+
+    for (auto _ : state) {
+        ClientOrderId::Text link = id.encode();
+        auto request = encoder.encode_create(bench::BENCH_SYMBOL, (id.sequence & 1) != 0, 1250, 650000 - 25,
+                                             link.view(), true, timestamp_ms++);
+        benchmark::DoNotOptimize(request.data);
+        length = request.length;
+        id.sequence++;
+    }
+
+    state.SetItemsProcessed(state.iterations());
+    state.SetBytesProcessed(state.iterations() * static_cast<int64_t>(length));
+}
+BENCHMARK(BM_OrderRequest_EncodeCreate);
+
+static void BM_OrderRequest_EncodeCancel(benchmark::State& state) {
+    OrderRequestEncoder<LWS_PRE> encoder;
+    encoder.set_instrument(bench::BENCH_SYMBOL, bench::bench_instrument());
+    ClientOrderId::Text link = ClientOrderId{1, static_cast<uint16_t>(BENCH_SYMBOL_ID), ClientOrderId::session_start()}.encode();
+    int64_t timestamp_ms = 1735689600123;
+
+    for (auto _ : state) {
+        auto request = encoder.encode_cancel(bench::BENCH_SYMBOL, link.view(), timestamp_ms++);
+        benchmark::DoNotOptimize(request.data);
+    }
+
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_OrderRequest_EncodeCancel);
@@ -0,0 +1,156 @@
+// benchmarks/bench_feed.cpp
+// Public feed hot path: one frame through PublicFeedClient::ingest_frame() - the same
+// journal write, simdjson decode, tick/lot conversion and book apply as a live frame.
+// BM_Decode_Delta_Runtime runs the runtime-configured BybitWebSocketClient for comparison.
+#include <benchmark/benchmark.h>
+#include <memory>
+
+#include "BenchPayloads.h"
+#include "config/BotConfiguration.h"
+#include "core/OrderBookManager.h"
+#include "core/SymbolManager.h"
+#include "network/BybitRestClient.h"
+#include "network/BybitWebSocketClient.h"
+#include "utils/DataLogger.h"
+#include "utils/Tsc.h"
+
+namespace {
+
+// One never-connected public client per client type for the whole run (books persist
+// across benchmarks)
+template <typename Client = PublicFeedClient>
+struct FeedFixture {
+    BotConfiguration config;
+    std::unique_ptr<DataLogger> logger;
+    OrderBookManager books;
+    SymbolManager symbols;
+    std::unique_ptr<Client> client;
+
+    FeedFixture() {
+        tsc::calibration();
+        config.enable_aeron = false;
+        config.capture_enabled = false;
+
+        // Captures decode on the grids they were recorded with (as market_replay does)
+        std::vector<InstrumentInfo> instruments;
+        if (BybitRestClient::load_instrument_cache(config.instrument_cache_path, instruments)) {
+            BybitRestClient::register_instruments(instruments);
+        }
+        InstrumentRegistry::get_instance().set(bench::BENCH_SYMBOL, bench::bench_instrument());
+
+        logger = std::make_unique<DataLogger>("bench_data.log", config.log_options);
+        client = std::make_unique<Client>(books, symbols, config, *logger, BybitChannelType::PUBLIC);
+    }
+
+    static FeedFixture& get() {
+        static FeedFixture fixture;
+        return fixture;
+    }
+
+    void ingest(bench::PaddedFrame& frame) { client->ingest_frame(frame.data(), frame.length, frame.capacity()); }
+
+    // Next in-sequence update ID of the benchmark symbol's book
+    uint64_t next_update_id() {
+        OrderBook* book = books.get(std::string(bench::BENCH_SYMBOL));
+        return book ? book->get_last_update_id() + 1 : 1;
+    }
+};
+
+// A benchmark that silently measured the resync / error path would look fast
+template <typename Client>
+bool measured_happy_path(benchmark::State& state, const FeedFixture<Client>& feed, uint64_t resyncs, uint64_t errors) {
+    if (feed.client->get_resync_count() != resyncs || feed.client->get_parse_error_count() != errors) {
+        state.SkipWithError("frames were rejected (gap or parse error)");
+        return false;
+    }
+    return true;
+}
+
+}  // namespace
+
+// Full snapshot of `levels` levels per side
+static void BM_Decode_Snapshot(benchmark::State& state) {
+    FeedFixture<>& feed = FeedFixture<>::get();
+    bench::PaddedFrame frame = bench::make_book_frame(bench::BENCH_SYMBOL, true, static_cast<int>(state.range(0)));
+    uint64_t resyncs = feed.client->get_resync_count();
+    uint64_t errors = feed.client->get_parse_error_count();
+    uint64_t update_id = feed.next_update_id();
+
+    for (auto _ : state) {
+        frame.set_update_id(update_id++);
+        feed.ingest(frame);
+    }
+
+    if (!measured_happy_path(state, feed, resyncs, errors)) return;
+    state.SetItemsProcessed(state.iterations());
+    state.SetBytesProcessed(state.iterations() * static_cast<int64_t>(frame.length));
+}
+BENCHMARK(BM_Decode_Snapshot)->Arg(1)->Arg(5)->Arg(10)->Arg(25)->Arg(50);
+
+// Delta of `levels` changed levels per side on a full 50-level book
+template <typename Client>
+static void decode_deltas(benchmark::State& state) {
+    FeedFixture<Client>& feed = FeedFixture<Client>::get();
+    bench::PaddedFrame snapshot = bench::make_book_frame(bench::BENCH_SYMBOL, true, OrderBook::MAX_LEVELS);
+    bench::PaddedFrame deltas[2] = {
+        bench::make_book_frame(bench::BENCH_SYMBOL, false, static_cast<int>(state.range(0)), 1),
+        bench::make_book_frame(bench::BENCH_SYMBOL, false, static_cast<int>(state.range(0)), 2),
+    };
+    uint64_t update_id = feed.next_update_id();
+    snapshot.set_update_id(update_id++);
+    feed.ingest(snapshot);
+    uint64_t resyncs = feed.client->get_resync_count();
+    uint64_t errors = feed.client->get_parse_error_count();
+
+    // Alternating quantities, so every delta really changes the levels
+    for (auto _ : state) {
+        bench::PaddedFrame& delta = deltas[update_id & 1];
+        delta.set_update_id(update_id++);
+        feed.ingest(delta);
+    }
+
+    if (!measured_happy_path(state, feed, resyncs, errors)) return;
+    state.SetItemsProcessed(state.iterations());
+    state.SetBytesProcessed(state.iterations() * static_cast<int64_t>(deltas[0].length));
+}
+static void BM_Decode_Delta(benchmark::State& state) { decode_deltas<PublicFeedClient>(state); }
+BENCHMARK(BM_Decode_Delta)->Arg(1)->Arg(5)->Arg(10)->Arg(25)->Arg(50);
+
+// The same deltas through the runtime-configured client (channel / publisher checked per frame)
+static void BM_Decode_Delta_Runtime(benchmark::State& state) { decode_deltas<BybitWebSocketClient>(state); }
+BENCHMARK(BM_Decode_Delta_Runtime)->Arg(1)->Arg(10)->Arg(50);
+
+// Recorded frames of BENCH_CAPTURE, in order. The books are invalidated before each pass,
+// so the capture's snapshots are applied again instead of coming back STALE.
+static void BM_Decode_Captured(benchmark::State& state) {
+    const auto& recorded = bench::captured_frames();
+    if (recorded.empty()) {
+        state.SkipWithError("set BENCH_CAPTURE=<capture prefix> to decode recorded frames");
+        return;
+    }
+    FeedFixture<>& feed = FeedFixture<>::get();
+    std::vector<bench::PaddedFrame> frames = recorded;     // ingest_frame() takes writable buffers
+    auto restart = [&feed] {
+        for (auto entry : feed.books.get_all()) entry.book->invalidate();
+    };
+    restart();
+    size_t next = 0;
+    int64_t bytes = 0;
+
+    for (auto _ : state) {
+        bench::PaddedFrame& frame = frames[next];
+        feed.ingest(frame);
+        bytes += static_cast<int64_t>(frame.length);
+        if (++next == frames.size()) {
+            state.PauseTiming();
+            restart();
+            next = 0;
+            state.ResumeTiming();
+        }
+    }
+
+    state.SetItemsProcessed(state.iterations());
+    state.SetBytesProcessed(bytes);
+    state.counters["frames"] = static_cast<double>(frames.size());
+}
+BENCHMARK(BM_Decode_Captured);
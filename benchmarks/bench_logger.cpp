@@ -0,0 +1,53 @@
+// benchmarks/bench_logger.cpp
+// DataLogger::log producer throughput: the per-frame journal write of the feed threads.
+#include <benchmark/benchmark.h>
+#include <cstdio>
+#include <memory>
+#include <string>
+
+#include "utils/DataLogger.h"
+
+namespace {
+
+constexpr const char* JOURNAL_PATH = "bench_journal.log";
+
+// One logger per run, created before its threads start: producer rings are registered per
+// thread and never removed, so a shared logger would run out of them across runs
+std::unique_ptr<DataLogger> g_logger;
+
+void open_journal(const benchmark::State& state) {
+    AsyncLogOptions options;
+    options.full_policy = state.range(1) ? LogFullPolicy::BLOCK : LogFullPolicy::DROP;
+    g_logger = std::make_unique<DataLogger>(JOURNAL_PATH, options);
+}
+
+void close_journal(const benchmark::State&) {
+    g_logger.reset();           // Drains and joins the writer
+    std::remove(JOURNAL_PATH);
+}
+
+}  // namespace
+
+// range(0) = message bytes, range(1) = BLOCK (1: what the writer sustains) or DROP
+// (0: producer cost alone, the overflow shows in "dropped")
+static void BM_DataLogger_Log(benchmark::State& state) {
+    const std::string message(static_cast<size_t>(state.range(0)), 'x');
+    DataLogger& logger = *g_logger;
+    uint64_t dropped_before = logger.get_dropped_count();
+
+    for (auto _ : state) {
+        logger.log("MARKET_DATA", message);
+    }
+
+    state.SetItemsProcessed(state.iterations());
+    state.SetBytesProcessed(state.iterations() * state.range(0));
+    if (state.thread_index() == 0) {
+        state.counters["dropped"] = static_cast<double>(logger.get_dropped_count() - dropped_before);
+    }
+}
+BENCHMARK(BM_DataLogger_Log)
+    ->ArgNames({"bytes", "block"})
+    ->ArgsProduct({{64, 512, 2048}, {0, 1}})
+    ->Threads(1)->Threads(4)
+    ->Setup(open_journal)->Teardown(close_journal)
+    ->UseRealTime();
@@ -0,0 +1,208 @@
+// benchmarks/bench_orderbook.cpp
+// Seqlocked OrderBook writes and reads, alone and against a thread on the other side,
+// and the OrderBookManager directory under concurrent lookups.
+#include <benchmark/benchmark.h>
+#include <atomic>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "BenchPayloads.h"
+#include "core/OrderBook.h"
+#include "core/OrderBookManager.h"
+#include "core/SymbolRegistry.h"
+
+namespace {
+
+// `count` levels per side from the touch, quantities shifted by `variant`
+struct Levels {
+    std::vector<PriceLevel> bids;
+    std::vector<PriceLevel> asks;
+
+    Levels(int count, int64_t variant) {
+        for (int i = 0; i < count; i++) {
+            bids.push_back({650000 - i, 100 + 37 * i + variant});
+            asks.push_back({650001 + i, 100 + 41 * i + variant});
+        }
+    }
+};
+
+// Background thread hammering the book from the other side until destroyed
+class Contender {
+public:
+    template <typename Fn>
+    explicit Contender(bool enabled, Fn fn) {
+        if (!enabled) return;
+        thread_ = std::thread([this, fn]() mutable {
+            while (!stop_.load(std::memory_order_relaxed)) {
+                fn();
+                ops_.fetch_add(1, std::memory_order_relaxed);
+            }
+        });
+    }
+    ~Contender() {
+        stop_.store(true, std::memory_order_relaxed);
+        if (thread_.joinable()) thread_.join();
+    }
+    uint64_t ops() const { return ops_.load(std::memory_order_relaxed); }
+
+private:
+    std::atomic<bool> stop_{false};
+    std::atomic<uint64_t> ops_{0};
+    std::thread thread_;
+};
+
+}  // namespace
+
+// Writer: delta of range(0) levels per side on a 50-level book; range(1) = concurrent reader
+static void BM_OrderBook_ApplyDelta(benchmark::State& state) {
+    OrderBook book(bench::bench_instrument());
+    Levels full(OrderBook::MAX_LEVELS, 0);
+    Levels deltas[2] = {Levels(static_cast<int>(state.range(0)), 1), Levels(static_cast<int>(state.range(0)), 2)};
+    uint64_t update_id = 1;
+    book.apply_snapshot(full.bids, full.asks, update_id++, 0);
+
+    Contender reader(state.range(1) != 0, [&book] {
+        TopOfBook top;
+        benchmark::DoNotOptimize(book.get_top_of_book(top));
+    });
+
+    for (auto _ : state) {
+        const Levels& delta = deltas[update_id & 1];
+        auto result = book.apply_delta(delta.bids, delta.asks, update_id, update_id);
+        benchmark::DoNotOptimize(result);
+        update_id++;
+    }
+
+    state.SetItemsProcessed(state.iterations());
+    state.counters["reads"] = benchmark::Counter(static_cast<double>(reader.ops()), benchmark::Counter::kIsRate);
+}
+BENCHMARK(BM_OrderBook_ApplyDelta)
+    ->ArgNames({"levels", "reader"})
+    ->Args({1, 0})->Args({10, 0})->Args({50, 0})
+    ->Args({1, 1})->Args({10, 1})->Args({50, 1})
+    ->UseRealTime();
+
+// Reader: consistent copy of the top range(0) levels (what the engines and the Aeron
+// publisher take); range(1) = concurrent writer applying 5-level deltas
+static void BM_OrderBook_ReadConsistent(benchmark::State& state) {
+    OrderBook book(bench::bench_instrument());
+    Levels full(OrderBook::MAX_LEVELS, 0);
+    book.apply_snapshot(full.bids, full.asks, 1, 0);
+
+    Levels deltas[2] = {Levels(5, 1), Levels(5, 2)};
+    uint64_t update_id = 2;
+    Contender writer(state.range(1) != 0, [&] {
+        const Levels& delta = deltas[update_id & 1];
+        book.apply_delta(delta.bids, delta.asks, update_id, update_id);
+        update_id++;
+    });
+
+    const int depth = static_cast<int>(state.range(0));
+    PriceLevel bids[OrderBook::MAX_LEVELS];
+    PriceLevel asks[OrderBook::MAX_LEVELS];
+    for (auto _ : state) {
+        OrderBook::View view = book.copy_top(bids, asks, depth);
+        benchmark::DoNotOptimize(view);
+        benchmark::DoNotOptimize(bids);
+    }
+
+    state.SetItemsProcessed(state.iterations());
+    state.counters["writes"] = benchmark::Counter(static_cast<double>(writer.ops()), benchmark::Counter::kIsRate);
+}
+BENCHMARK(BM_OrderBook_ReadConsistent)
+    ->ArgNames({"levels", "writer"})
+    ->Args({1, 0})->Args({10, 0})->Args({50, 0})
+    ->Args({1, 1})->Args({10, 1})->Args({50, 1})
+    ->UseRealTime();
+
+static void BM_OrderBook_TopOfBook(benchmark::State& state) {
+    OrderBook book(bench::bench_instrument());
+    Levels full(OrderBook::MAX_LEVELS, 0);
+    book.apply_snapshot(full.bids, full.asks, 1, 0);
+
+    Levels deltas[2] = {Levels(5, 1), Levels(5, 2)};
+    uint64_t update_id = 2;
+    Contender writer(state.range(0) != 0, [&] {
+        const Levels& delta = deltas[update_id & 1];
+        book.apply_delta(delta.bids, delta.asks, update_id, update_id);
+        update_id++;
+    });
+
+    TopOfBook top;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(book.get_top_of_book(top));
+    }
+
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_OrderBook_TopOfBook)->ArgName("writer")->Arg(0)->Arg(1)->UseRealTime();
+
+// ============================================================================
+// DIRECTORY
+// ============================================================================
+
+namespace {
+
+constexpr uint32_t DIRECTORY_SYMBOLS = 512;
+
+// Shared by every thread of a run; the books exist from the first call on
+struct Directory {
+    OrderBookManager books;
+    std::vector<std::string> names;
+    std::vector<uint32_t> ids;
+
+    Directory() {
+        for (uint32_t i = 0; i < DIRECTORY_SYMBOLS; i++) {
+            names.push_back("BENCH" + std::to_string(i) + "USDT");
+            ids.push_back(SymbolRegistry::get_instance().intern(names.back()));
+            books.get_or_create(ids.back());
+        }
+    }
+
+    static Directory& get() {
+        static Directory directory;
+        return directory;
+    }
+};
+
+}  // namespace
+
+// Existing books by ID: the feed's per-topic path (one acquire load, no lock)
+static void BM_OrderBookManager_GetOrCreate_Id(benchmark::State& state) {
+    Directory& directory = Directory::get();
+    uint32_t i = static_cast<uint32_t>(state.thread_index()) * 97;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(directory.books.get_or_create(directory.ids[i++ % DIRECTORY_SYMBOLS]));
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_OrderBookManager_GetOrCreate_Id)->ThreadRange(1, 8)->UseRealTime();
+
+// Existing books by name: interns through the SymbolRegistry first (its mutex)
+static void BM_OrderBookManager_GetOrCreate_Name(benchmark::State& state) {
+    Directory& directory = Directory::get();
+    uint32_t i = static_cast<uint32_t>(state.thread_index()) * 97;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(directory.books.get_or_create(directory.names[i++ % DIRECTORY_SYMBOLS]));
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_OrderBookManager_GetOrCreate_Name)->ThreadRange(1, 8)->UseRealTime();
+
+// Subscribe-time creation: DIRECTORY_SYMBOLS new books in a fresh directory
+static void BM_OrderBookManager_Create(benchmark::State& state) {
+    const Directory& directory = Directory::get();
+    for (auto _ : state) {
+        state.PauseTiming();
+        auto books = std::make_unique<OrderBookManager>();
+        state.ResumeTiming();
+        for (uint32_t id : directory.ids) benchmark::DoNotOptimize(books->get_or_create(id));
+        state.PauseTiming();
+        books.reset();
+        state.ResumeTiming();
+    }
+    state.SetItemsProcessed(state.iterations() * DIRECTORY_SYMBOLS);
+}
+BENCHMARK(BM_OrderBookManager_Create)->Unit(benchmark::kMicrosecond);
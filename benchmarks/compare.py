@@ -0,0 +1,72 @@
+#!/usr/bin/env python3
+# benchmarks/compare.py
+# Compares two Google Benchmark JSON exports (trading_benchmarks --benchmark_out=...):
+#
+#   compare.py baseline.json current.json [--threshold 10]
+#
+# Benchmarks are matched by name on their real time (the median aggregate when the run
+# had repetitions). Exits 1 if any got more than --threshold percent slower, so a CI job
+# or a deploy script can stop the build before it reaches the servers.
+import argparse
+import json
+import sys
+
+TO_NS = {"ns": 1.0, "us": 1e3, "ms": 1e6, "s": 1e9}
+
+
+def load(path):
+    with open(path) as f:
+        report = json.load(f)
+
+    times = {}
+    medians = {}
+    for entry in report.get("benchmarks", []):
+        if entry.get("error_occurred"):
+            continue
+        ns = entry["real_time"] * TO_NS[entry.get("time_unit", "ns")]
+        if entry.get("run_type") == "aggregate":
+            if entry.get("aggregate_name") == "median":
+                medians[entry["run_name"]] = ns
+        else:
+            times.setdefault(entry.get("run_name", entry["name"]), ns)
+    times.update(medians)
+    return times
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Fail on benchmark regressions")
+    parser.add_argument("baseline")
+    parser.add_argument("current")
+    parser.add_argument("--threshold", type=float, default=10.0, help="allowed slowdown in percent")
+    args = parser.parse_args()
+
+    baseline = load(args.baseline)
+    current = load(args.current)
+
+    regressions = 0
+    width = max((len(name) for name in current), default=10)
+    for name in sorted(current):
+        now = current[name]
+        if name not in baseline:
+            print(f"  {name:<{width}}  {now:12.1f} ns   (new)")
+            continue
+        before = baseline[name]
+        change = (now - before) / before * 100.0 if before > 0 else 0.0
+        flag = ""
+        if change > args.threshold:
+            flag = "  <-- REGRESSION"
+            regressions += 1
+        print(f"  {name:<{width}}  {before:12.1f} -> {now:12.1f} ns  {change:+7.1f}%{flag}")
+
+    for name in sorted(set(baseline) - set(current)):
+        print(f"  {name:<{width}}  (missing from current run)")
+
+    if regressions:
+        print(f"\n{regressions} benchmark(s) more than {args.threshold:g}% slower than {args.baseline}")
+        return 1
+    print(f"\nNo regressions above {args.threshold:g}%")
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
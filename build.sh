@@ -42,7 +42,7 @@ echo -e "${MAGENTA}[1/7] Installing system dependencies...${NC}"
 
 if [[ "$PKG_MANAGER" == "brew" ]]; then
     echo "Installing via Homebrew..."
-    brew install cmake openssl libwebsockets pkg-config openjdk@11 git curl || true
+    brew install cmake openssl libwebsockets pkg-config openjdk@11 git curl google-benchmark || true
     
     # Set JAVA_HOME
     export JAVA_HOME=$(/usr/libexec/java_home -v 11 2>/dev/null || echo "/opt/homebrew/opt/openjdk@11")
@@ -59,6 +59,7 @@ elif [[ "$PKG_MANAGER" == "apt" ]]; then
         openjdk-11-jdk \
         git \
         libcurl4-openssl-dev \
+        libbenchmark-dev \
         build-essential
     
     export JAVA_HOME=/usr/lib/jvm/java-11-openjdk-amd64
@@ -191,60 +192,9 @@ echo ""
 # ============================================================================
 echo -e "${MAGENTA}[6/7] Generating SBE code from schema...${NC}"
 
-# Create SBE schema if it doesn't exist
 if [ ! -f "schema/market_data.xml" ]; then
-    echo "Creating SBE schema..."
-    cat > schema/market_data.xml << 'EOF'
-<?xml version="1.0" encoding="UTF-8"?>
-<sbe:messageSchema xmlns:sbe="http://fixprotocol.io/2016/sbe"
-                   package="trading.sbe"
-                   id="1"
-                   version="0"
-                   semanticVersion="0.1"
-                   description="Trading Bot SBE Messages"
-                   byteOrder="littleEndian">
-    <types>
-        <composite name="messageHeader">
-            <type name="blockLength" primitiveType="uint16"/>
-            <type name="templateId" primitiveType="uint16"/>
-            <type name="schemaId" primitiveType="uint16"/>
-            <type name="version" primitiveType="uint16"/>
-        </composite>
-        <composite name="groupSizeEncoding">
-            <type name="blockLength" primitiveType="uint16"/>
-            <type name="numInGroup" primitiveType="uint16"/>
-        </composite>
-        <composite name="varStringEncoding">
-            <type name="length" primitiveType="uint16"/>
-            <type name="varData" primitiveType="uint8" length="0"/>
-        </composite>
-    </types>
-    
-    <sbe:message name="OrderBookSnapshot" id="2" description="Orderbook snapshot">
-        <field name="timestamp" id="1" type="uint64" description="Nanosecond timestamp"/>
-        <field name="bidCount" id="2" type="uint16" description="Number of bid levels"/>
-        <field name="askCount" id="3" type="uint16" description="Number of ask levels"/>
-        <group name="bids" id="4" dimensionType="groupSizeEncoding">
-            <field name="price" id="5" type="double"/>
-            <field name="quantity" id="6" type="double"/>
-        </group>
-        <group name="asks" id="7" dimensionType="groupSizeEncoding">
-            <field name="price" id="8" type="double"/>
-            <field name="quantity" id="9" type="double"/>
-        </group>
-        <data name="symbol" id="10" type="varStringEncoding"/>
-    </sbe:message>
-    
-    <sbe:message name="TradeSignal" id="3" description="Trading signal">
-        <field name="timestamp" id="1" type="uint64" description="Nanosecond timestamp"/>
-        <field name="action" id="2" type="uint8" description="0=Buy, 1=Sell"/>
-        <field name="price" id="3" type="double"/>
-        <field name="quantity" id="4" type="double"/>
-        <data name="symbol" id="5" type="varStringEncoding"/>
-    </sbe:message>
-</sbe:messageSchema>
-EOF
-    echo -e "${GREEN}✓ SBE schema created${NC}"
+    echo -e "${RED}✗ schema/market_data.xml is missing${NC}"
+    exit 1
 fi
 
 # Generate SBE code
@@ -252,7 +202,8 @@ SBE_JAR=$(ls third_party/simple-binary-encoding/sbe-all/build/libs/sbe-all-*.jar
 
 if [ -f "$SBE_JAR" ] && [ -f "schema/market_data.xml" ]; then
     echo "Generating SBE code..."
-    java -Dsbe.output.dir=generated -jar "$SBE_JAR" schema/market_data.xml
+    java -Dsbe.target.language=Cpp -Dsbe.output.dir=generated -Dsbe.generate.ir=false \
+        -jar "$SBE_JAR" schema/market_data.xml
     echo -e "${GREEN}✓ SBE code generated${NC}"
 else
     echo -e "${YELLOW}⚠ Warning: SBE code generation skipped${NC}"
@@ -4,6 +4,13 @@
 #include <cstdint>
 #include <cstdlib> // Required for std::getenv
 #include <iostream>
+#include "utils/DataLogger.h"
+#include "utils/Doorbell.h"
+#include "utils/ThreadAffinity.h"
+#include "messaging/MediaDriverOptions.h"
+#include "messaging/PublishPolicy.h"
+#include "core/SignalKernel.h"
+#include "trading/RiskGate.h"
 
 struct BotConfiguration {
     BotConfiguration() {
@@ -30,15 +37,145 @@ struct BotConfiguration {
     
     // Trading parameters
     double trade_quantity = 0.02; // Adjusted to valid min size for BTC
-    int max_orders_per_second = 10; // Realistic rate limit
+    int max_orders_per_second = 10; // Realistic rate limit (RiskGate global bucket)
     bool enable_trading = false;
     
     // Aeron IPC configuration
+    // Books go out on orderbook_stream_id (one publisher per feed shard), order records
+    // on signal_stream_id, so they never queue behind a burst of book messages.
+    // Under back-pressure books conflate to the latest per symbol; order records spin
+    // (every state change matters) and are only dropped after spin_limit attempts.
     bool enable_aeron = true;
     std::string aeron_channel = "aeron:ipc";
     int32_t orderbook_stream_id = 1001;
     int32_t signal_stream_id = 1002;
+    AeronPublishOptions aeron_book_publish{BackPressurePolicy::CONFLATE, 0, 512};
+    AeronPublishOptions aeron_order_publish{BackPressurePolicy::SPIN, 4096, 0};
+    // What each book update publishes: DELTA (changed levels of the top 10, a full
+    // snapshot per symbol every snapshot_interval_ms) or SNAPSHOT, each symbol at most
+    // once per conflation_us with its latest state
+    BookPublishOptions aeron_book_stream{BookPublishMode::DELTA, 100, 1000};
+    // Embedded media driver (GlobalMediaDriver): threading mode, idle strategy and core
+    // per agent. INVOKER runs the driver and the order publisher's client conductor on
+    // the Aeron service thread (aeron_service_thread), which idles per aeron_service_idle.
+    MediaDriverOptions media_driver{};
+    AeronIdle aeron_service_idle = AeronIdle::BACKOFF;
     
     // Symbol fetching
     bool fetch_all_symbols = true;
-};
\ No newline at end of file
+
+    // Instrument metadata (tick size, qty step, min qty) from instruments-info.
+    // Cached on disk; a cache younger than the max age skips the REST call on restart.
+    std::string instrument_cache_path = "instruments.cache";
+    int instrument_cache_max_age_s = 24 * 3600;
+
+    // Startup REST snapshot (RestBootstrap): instruments-info, open orders and positions
+    // fetched concurrently over HTTP/2. Metadata comes from mainnet like the books; the
+    // signed order/position endpoints from the host the API keys belong to
+    // ("api.bybit.com" for MAINNET).
+    std::string rest_public_host = "api.bybit.com";
+    std::string rest_private_host = "api-testnet.bybit.com";
+    int rest_timeout_ms = 10000;                        // Whole bootstrap, every page included
+    int rest_recv_window_ms = 5000;
+
+    // Open orders/positions per symbol (OrderStateTable): memory-mapped, kept across
+    // restarts, read back by each engine on startup
+    std::string order_state_path = "order_state.table";
+
+    // Public feed sharding (FeedHandlerPool)
+    // Symbols are spread over N public WebSocket connections, each serviced by its own
+    // thread that exclusively owns the books of its symbols.
+    int feed_shards = 4;
+    std::vector<int> feed_shard_cores = {};             // Core per feed thread (shard-major over lines), -1/missing = unpinned
+    std::vector<std::string> feed_isolated_symbols = {"BTCUSDT"};  // Each gets a shard to itself
+
+    // WebSocket host of every connection ("stream.bybit.com" for MAINNET)
+    std::string ws_host = "stream-testnet.bybit.com";
+
+    // A/B line arbitration: every shard opens feed_lines redundant connections carrying
+    // the same symbols; the first copy of each update is applied, later ones dropped by
+    // update ID. Line k connects to feed_line_hosts[k % size] (empty = ws_host), so the
+    // lines can come in through different endpoints / regions.
+    int feed_lines = 1;
+    std::vector<std::string> feed_line_hosts = {};
+
+    // WebSocket supervision (every connection): a dropped connection is reopened with
+    // jittered exponential backoff; one silent for ws_stall_timeout_ms gets a standby
+    // connection opened next to it, which takes over once established. Books of the
+    // connection stay invalid until their fresh snapshot arrives.
+    int ws_reconnect_initial_ms = 100;
+    int ws_reconnect_max_ms = 10000;
+    int ws_ping_interval_ms = 20000;                    // Bybit drops idle sockets
+    int ws_stall_timeout_ms = 30000;
+
+    // Async data journal (DataLogger)
+    // Per-thread ring size, what to do when a ring is full, and O_DIRECT batching.
+    AsyncLogOptions log_options;
+
+    // Trading engines (EngineScheduler): one engine per entry of `symbols`, run by
+    // engine_workers threads. Idle workers BLOCK on a futex until a book changes or an
+    // order update arrives; SPIN busy-polls (pin via engine_worker_cores); SLEEP is the
+    // legacy 500us poll. The idle timeout is each engine's timer tick (order timeouts).
+    int engine_workers = 2;
+    std::vector<int> engine_worker_cores = {};          // Core per worker, -1/missing = unpinned
+    WaitMode engine_wait_mode = WaitMode::BLOCK;
+    int engine_idle_timeout_us = 1000;
+    // A worker with nothing of its own takes another worker's ready engine only if that
+    // worker is inside another engine's cycle, or the engine has waited this long
+    int engine_steal_after_us = 200;
+
+    // Book features of every traded symbol (SignalKernel), maintained by the feed thread
+    // as deltas are applied. The VWAP target is each engine's base order size.
+    SignalParams signal_params{};
+    // Anchor maker entries at the microprice instead of the mid (strategy change: off
+    // unless chosen; the features are maintained either way)
+    bool entry_at_microprice = false;
+
+    // Pre-trade gate on every engine's send path (RiskGate): per-symbol and global order
+    // rates (the global one is max_orders_per_second), order/position notional and the
+    // martingale depth. Cancels and reducing orders only spend rate, and have reduce_reserve
+    // tokens of each bucket to themselves.
+    RiskLimits risk_limits{};
+
+    // Thread topology: core and SCHED_FIFO priority of every runtime thread (ThreadPlacement:
+    // core -1 = unpinned, priority 0 = normal scheduling). Feed threads and engine workers
+    // take their cores from feed_shard_cores / engine_worker_cores; driver threads are in
+    // media_driver. The main thread is placed last, once every other thread has started
+    // (threads inherit their creator's affinity and policy).
+    int feed_fifo_priority = 0;
+    int engine_fifo_priority = 0;
+    ThreadPlacement trade_thread{};
+    ThreadPlacement stream_thread{};
+    ThreadPlacement aeron_service_thread{};
+    ThreadPlacement perf_thread{};
+    ThreadPlacement main_thread{};
+
+    // Hot-path memory placement (MemoryPlacement): the book arena and the journal rings on
+    // huge pages, and every allocation preferring one NUMA node - numa_node, or if -1 the
+    // node of the first pinned feed core (none pinned: the kernel's default placement)
+    bool huge_pages = true;
+    bool numa_local_memory = true;
+    int numa_node = -1;
+
+    // Hot-path latency histograms (LatencyRecorder): TSC stamps per stage and symbol.
+    // PerformanceMonitor prints the stage percentiles and rewrites the JSON export every
+    // perf_report_interval_s.
+    bool latency_tracking = true;
+    std::string latency_export_path = "latency.json";  // Empty = no export
+    int perf_report_interval_s = 30;
+
+    // Shared-memory telemetry (TelemetrySegment) for telemetry_spy / a Prometheus
+    // exporter: "<telemetry_dir>/trading_bot.<instance>.telemetry", the instance being
+    // telemetry_instance or, if empty, the PID. Counters are sampled every
+    // telemetry_interval_ms.
+    bool telemetry_enabled = true;
+    std::string telemetry_dir = "/dev/shm";
+    std::string telemetry_instance = "";
+    int telemetry_interval_ms = 1000;
+
+    // Raw public-frame capture for replay (one segment series per feed shard,
+    // "<capture_dir>/<start time>_feed<N>.NNNN.cap")
+    bool capture_enabled = false;
+    std::string capture_dir = "captures";
+    size_t capture_segment_bytes = 256ull * 1024 * 1024;
+};
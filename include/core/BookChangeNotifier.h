@@ -0,0 +1,70 @@
+#pragma once
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include "core/SymbolRegistry.h"
+#include "utils/Doorbell.h"
+
+// "Book N changed" notifications from the feed threads to the trading side.
+//
+// Consumers watch() the symbols they trade. For a watched symbol, notify() sets its
+// bit in a dirty bitmap and rings the symbol's doorbell; unwatched symbols cost one
+// relaxed load. The consumer clears the bit with consume() when it reacts to the change,
+// so any number of updates between two decisions collapse into one wakeup.
+//
+// There are MAX_DOORBELLS doorbells. A symbol rings the one it was watched on (the
+// engine scheduler uses one per worker), so a change wakes only the thread it is for.
+class BookChangeNotifier {
+public:
+    // Feed thread (hot path)
+    void notify(uint32_t symbol_id) {
+        if (symbol_id >= SymbolRegistry::MAX_SYMBOLS) return;
+        uint64_t bit = uint64_t(1) << (symbol_id & 63);
+        size_t word = symbol_id >> 6;
+        if ((watched_[word].load(std::memory_order_relaxed) & bit) == 0) return;
+
+        uint64_t prev = dirty_[word].fetch_or(bit, std::memory_order_release);
+        if ((prev & bit) == 0) doorbell_for(symbol_id).ring();  // Already dirty: consumer is due anyway
+    }
+
+    static constexpr size_t MAX_DOORBELLS = 16;
+
+    // Consumer side. Watching again moves the symbol to another doorbell.
+    void watch(uint32_t symbol_id, size_t doorbell = 0) {
+        if (symbol_id >= SymbolRegistry::MAX_SYMBOLS) return;
+        doorbell_of_[symbol_id].store(static_cast<uint8_t>(doorbell % MAX_DOORBELLS), std::memory_order_relaxed);
+        watched_[symbol_id >> 6].fetch_or(uint64_t(1) << (symbol_id & 63), std::memory_order_relaxed);
+    }
+
+    bool is_dirty(uint32_t symbol_id) const {
+        if (symbol_id >= SymbolRegistry::MAX_SYMBOLS) return false;
+        return dirty_[symbol_id >> 6].load(std::memory_order_acquire) & (uint64_t(1) << (symbol_id & 63));
+    }
+
+    // Clears the bit; true if the book changed since the last consume()
+    bool consume(uint32_t symbol_id) {
+        if (symbol_id >= SymbolRegistry::MAX_SYMBOLS) return false;
+        uint64_t bit = uint64_t(1) << (symbol_id & 63);
+        return dirty_[symbol_id >> 6].fetch_and(~bit, std::memory_order_acq_rel) & bit;
+    }
+
+    Doorbell& doorbell(size_t index = 0) { return doorbells_[index % MAX_DOORBELLS]; }
+    Doorbell& doorbell_for(uint32_t symbol_id) {
+        size_t index = symbol_id < SymbolRegistry::MAX_SYMBOLS
+            ? doorbell_of_[symbol_id].load(std::memory_order_relaxed) : 0;
+        return doorbells_[index];
+    }
+
+    // Wakes every waiter (shutdown)
+    void ring_all() {
+        for (auto& doorbell : doorbells_) doorbell.ring();
+    }
+
+private:
+    static constexpr size_t WORDS = SymbolRegistry::MAX_SYMBOLS / 64;
+
+    std::array<std::atomic<uint64_t>, WORDS> watched_{};
+    std::array<std::atomic<uint64_t>, WORDS> dirty_{};
+    std::array<std::atomic<uint8_t>, SymbolRegistry::MAX_SYMBOLS> doorbell_of_{};
+    std::array<Doorbell, MAX_DOORBELLS> doorbells_;
+};
@@ -0,0 +1,141 @@
+#pragma once
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <limits>
+#include <string_view>
+#include "core/SymbolRegistry.h"
+#include "utils/DecimalFormat.h"
+#include "utils/DecimalParser.h"
+
+// Exchange precision of one instrument (Bybit instruments-info: tickSize, qtyStep,
+// minOrderQty).
+//
+// Inside the process prices are integer TICKS and quantities integer LOTS of the
+// instrument: the book stores them, the engine compares them, the order encoder
+// formats them (ticks * tickSize). Comparisons are exact (no -ffast-math surprises on
+// price == best_bid) and every price we send is on the tick grid by construction.
+// Doubles only remain for display and ratio math (PnL).
+//
+// Symbols without metadata fall back to a 1e-8 grid for both: fine enough for every
+// Bybit contract, so decoding never loses precision, but orders are not snapped to
+// the real tick.
+struct InstrumentSpec {
+    DecimalStep tick{1, 8};
+    DecimalStep lot{1, 8};
+    int64_t min_qty_lots = 1;
+    bool known = false;             // False for the fallback grid
+
+    // Builds a spec from the exchange strings ("0.10", "0.001", "0.001").
+    // False if a field is not a positive decimal.
+    static bool from_strings(std::string_view tick_size, std::string_view qty_step,
+                             std::string_view min_order_qty, InstrumentSpec& out) {
+        Decimal tick_d, lot_d, min_d;
+        if (!parse_decimal(tick_size, tick_d) || !parse_decimal(qty_step, lot_d) ||
+            !parse_decimal(min_order_qty, min_d)) {
+            return false;
+        }
+
+        InstrumentSpec spec;
+        if (!step_from_decimal(tick_d, spec.tick) || !step_from_decimal(lot_d, spec.lot)) return false;
+        if (!to_units(min_d, spec.lot, spec.min_qty_lots) || spec.min_qty_lots < 1) spec.min_qty_lots = 1;
+        spec.known = true;
+        out = spec;
+        return true;
+    }
+
+    // Exchange decimal -> whole ticks / lots (exact on the grid, nearest step otherwise)
+    bool price_to_ticks(const Decimal& price, int64_t& out) const { return to_units(price, tick, out); }
+    bool qty_to_lots(const Decimal& qty, int64_t& out) const { return to_units(qty, lot, out); }
+
+    // Strategy arithmetic (offsets, configured sizes) -> nearest tick / lot
+    int64_t price_to_ticks(double price) const { return tick.units(price); }
+    int64_t qty_to_lots(double qty) const { return lot.units(qty); }
+
+    // Display / ratio math. Exact for ticks * mantissa below 2^53.
+    double ticks_to_price(int64_t ticks) const { return step_value(tick, ticks); }
+    double lots_to_qty(int64_t lots) const { return step_value(lot, lots); }
+
+    // Smallest fixed-point form of a step ("0.010" -> {1, 2}, "25" -> {25, 0})
+    static bool step_from_decimal(Decimal d, DecimalStep& out) {
+        if (d.mantissa == 0) return false;
+        while (d.scale > 0 && d.mantissa % 10 == 0) {
+            d.mantissa /= 10;
+            d.scale--;
+        }
+        if (d.scale > MAX_FORMAT_DECIMALS) return false;
+        out.mantissa = d.mantissa;
+        out.decimals = d.scale;
+        return true;
+    }
+
+    // value / step = d.mantissa * 10^(step.decimals - d.scale) / step.mantissa, in
+    // integers. A non-zero value never rounds to 0 units (would read as "delete level").
+    static bool to_units(const Decimal& d, const DecimalStep& step, int64_t& out) {
+        uint64_t num = d.mantissa;
+        uint64_t den = step.mantissa;
+        int shift = step.decimals - d.scale;
+        if (shift > 18 || shift < -18) return false;
+
+        if (shift >= 0) {
+            if (num > std::numeric_limits<uint64_t>::max() / POW10[shift]) return false;
+            num *= POW10[shift];
+        } else {
+            if (den > std::numeric_limits<uint64_t>::max() / POW10[-shift]) return false;
+            den *= POW10[-shift];
+        }
+
+        uint64_t units = num / den + (num % den >= den - den / 2 ? 1 : 0);
+        if (units == 0 && num != 0) units = 1;
+        if (units > static_cast<uint64_t>(std::numeric_limits<int64_t>::max())) return false;
+        out = static_cast<int64_t>(units);
+        return true;
+    }
+
+private:
+    static double step_value(const DecimalStep& step, int64_t units) {
+        return static_cast<double>(units * static_cast<int64_t>(step.mantissa)) /
+               static_cast<double>(POW10[step.decimals]);
+    }
+};
+
+// Process-wide SymbolRegistry ID -> InstrumentSpec table.
+// Filled once at startup (instruments-info or its disk cache), before any book is
+// created: books and engines copy their spec when they are built.
+//
+// THREADING: set() is the cold path (one writer at a time); get() is lock-free,
+// a spec is written before the flag that publishes it.
+class InstrumentRegistry {
+public:
+    static InstrumentRegistry& get_instance() {
+        static InstrumentRegistry instance;
+        return instance;
+    }
+
+    bool set(std::string_view symbol, const InstrumentSpec& spec) {
+        uint32_t id = SymbolRegistry::get_instance().intern(symbol);
+        if (id == SymbolRegistry::INVALID_ID) return false;
+        specs_[id] = spec;
+        known_[id].store(true, std::memory_order_release);
+        return true;
+    }
+
+    // The fallback grid if the symbol has no metadata
+    const InstrumentSpec& get(uint32_t symbol_id) const {
+        if (symbol_id >= SymbolRegistry::MAX_SYMBOLS || !known_[symbol_id].load(std::memory_order_acquire)) {
+            return fallback_;
+        }
+        return specs_[symbol_id];
+    }
+
+    const InstrumentSpec& get(std::string_view symbol) const {
+        return get(SymbolRegistry::get_instance().find(symbol));
+    }
+
+private:
+    InstrumentRegistry() = default;
+
+    std::array<InstrumentSpec, SymbolRegistry::MAX_SYMBOLS> specs_{};
+    std::array<std::atomic<bool>, SymbolRegistry::MAX_SYMBOLS> known_{};
+    InstrumentSpec fallback_;
+};
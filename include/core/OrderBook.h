@@ -1,35 +1,199 @@
 #pragma once
 #include <array>
 #include <atomic>
+#include <cstdint>
+#include <memory>
+#include <span>
 #include <vector>
+#include "core/Instrument.h"
+#include "core/SignalKernel.h"
+#include "utils/CpuPause.h"
 
+// One level in instrument units: price in ticks, quantity in lots (see InstrumentSpec)
 struct PriceLevel {
-    double price;
-    double quantity;
+    int64_t price;
+    int64_t quantity;
 };
 
+// Best bid/ask taken from ONE version of the book (both sides consistent), in ticks/lots.
+struct TopOfBook {
+    int64_t bid_price = 0;
+    int64_t bid_qty = 0;
+    int64_t ask_price = 0;
+    int64_t ask_qty = 0;
+    uint64_t update_id = 0;
+};
+
+// Incremental L2 book for one symbol.
+// Levels live in flat, sorted arrays sized to the WebSocket subscription depth
+// (bids descending, asks ascending), so top-of-book is always index 0.
+// Prices and quantities are integer ticks/lots of the book's instrument; the
+// double-returning getters convert on the way out.
+//
+// THREADING: normally a single writer (the WS thread that owns the symbol), any number
+// of readers. Every mutation runs inside a seqlock write section covering both sides, so
+// readers either see a whole update or retry - never a bid from update N with an ask
+// from N+1. With redundant feed lines (A/B arbitration) each line's thread may write:
+// writers serialize on a claim flag (uncontended with one line) and the update ID
+// decides which copy is applied - the first arrival wins, later copies come back STALE.
 class OrderBook {
 public:
-    static constexpr int MAX_LEVELS = 10;
-    
-    void update_bids(const std::vector<PriceLevel>& bids);
-    void update_asks(const std::vector<PriceLevel>& asks);
-    
+    // Must match the depth of the "orderbook.<N>" topic we subscribe to.
+    static constexpr int MAX_LEVELS = 50;
+
+    explicit OrderBook(const InstrumentSpec& instrument = InstrumentSpec{}) : instrument_(instrument) {}
+
+    // Tick/lot grid the levels are expressed in (fixed for the book's lifetime)
+    const InstrumentSpec& instrument() const { return instrument_; }
+
+    enum class ApplyResult {
+        APPLIED,        // Update merged into the book
+        STALE,          // Update ID at or behind the book (duplicate/replay) - ignored
+        GAP,            // One or more deltas were missed - book invalidated, resync needed
+        NO_SNAPSHOT     // Delta arrived before any snapshot - resync needed
+    };
+
+    // What a delta gap does to the book. A single feed must INVALIDATE (the book is wrong
+    // now); a redundant line KEEPs it, since the other lines still carry the missing ID.
+    enum class GapPolicy {
+        INVALIDATE,
+        KEEP
+    };
+
+    // Read-only view handed to read_consistent(). Only valid inside the callback.
+    struct View {
+        const PriceLevel* bids;
+        int bid_count;
+        const PriceLevel* asks;
+        int ask_count;
+        uint64_t update_id;
+        uint64_t seq;
+        bool valid;
+    };
+
+    // Bybit "snapshot": replaces both sides. Levels must arrive sorted (as Bybit sends them).
+    // A snapshot at or behind a valid book (a lagging line's copy) is STALE; u=1 always wins.
+    ApplyResult apply_snapshot(std::span<const PriceLevel> bids,
+                               std::span<const PriceLevel> asks,
+                               uint64_t update_id, uint64_t seq);
+
+    // Bybit "delta": upserts levels by price, quantity 0 deletes the level.
+    // The update ID must be exactly last_update_id + 1, otherwise it is a GAP and, with
+    // GapPolicy::INVALIDATE, the book is invalidated.
+    ApplyResult apply_delta(std::span<const PriceLevel> bids,
+                            std::span<const PriceLevel> asks,
+                            uint64_t update_id, uint64_t seq,
+                            GapPolicy gap_policy = GapPolicy::INVALIDATE);
+
+    // Marks the book unusable until the next snapshot arrives.
+    void invalidate();
+    // True for the first caller after the book became invalid, so a burst of
+    // in-flight deltas triggers one resync request instead of one per message.
+    bool begin_resync();
+    bool is_valid() const;
+    uint64_t get_last_update_id() const;
+    uint64_t get_last_seq() const;
+
+    // Runs fn(const View&) against a consistent version of the book, retrying
+    // if the writer changed it mid-read. fn may run more than once, so it must
+    // only copy data out (no side effects) and must not hold on to the pointers.
+    template <typename Fn>
+    void read_consistent(Fn&& fn) const {
+        for (;;) {
+            uint64_t before = version_.load(std::memory_order_acquire);
+            if (before & 1) {           // Writer in progress
+                cpu_pause();
+                continue;
+            }
+
+            View view{bids_.data(), bid_count_.load(std::memory_order_relaxed),
+                      asks_.data(), ask_count_.load(std::memory_order_relaxed),
+                      last_update_id_.load(std::memory_order_relaxed),
+                      last_seq_.load(std::memory_order_relaxed),
+                      valid_.load(std::memory_order_relaxed)};
+            fn(view);
+
+            std::atomic_thread_fence(std::memory_order_acquire);
+            if (version_.load(std::memory_order_relaxed) == before) return;
+            cpu_pause();
+        }
+    }
+
+    // Both sides from one version, in ticks/lots. False if the book is invalid or a side is empty.
+    bool get_top_of_book(TopOfBook& top) const;
+
+    // Converted to prices/quantities
     bool get_best_bid(double& price, double& qty) const;
     bool get_best_ask(double& price, double& qty) const;
     double get_fair_price() const;
-    
+
     std::vector<std::pair<double, double>> get_bids(int max_levels = 10) const;
     std::vector<std::pair<double, double>> get_asks(int max_levels = 10) const;
-    
+
+    // Consistent copy of both sides into caller-owned vectors (capacity is reused,
+    // so steady-state publishing does not allocate).
+    void get_snapshot(std::vector<std::pair<double, double>>& bids,
+                      std::vector<std::pair<double, double>>& asks,
+                      int max_levels = 10) const;
+    // Consistent copy of the top max_levels of both sides into caller arrays (sized
+    // max_levels each); the returned View points at them, so it outlives the read.
+    View copy_top(PriceLevel* bids, PriceLevel* asks, int max_levels) const;
+    int get_bid_depth() const;
+    int get_ask_depth() const;
+
     void increment_update();
     uint64_t get_update_count() const;
-    
+
+    // Latency stamps (tsc::now()) of the last applied update: when its frame was
+    // received and when it landed in the book. Read by the engine at its decision.
+    void stamp_update(uint64_t rx_tick, uint64_t applied_tick) {
+        last_rx_tick_.store(rx_tick, std::memory_order_relaxed);
+        last_applied_tick_.store(applied_tick, std::memory_order_relaxed);
+    }
+    uint64_t get_rx_tick() const { return last_rx_tick_.load(std::memory_order_relaxed); }
+    uint64_t get_applied_tick() const { return last_applied_tick_.load(std::memory_order_relaxed); }
+
+    // Cold path (engine setup), once per book: from now on every write also updates the
+    // book's SignalKernel, and get_signals() copies its features out of the same version.
+    // Books nobody trades never pay for it.
+    void enable_signals(const SignalParams& params);
+    // One seqlocked struct copy. False if signals are off, the book invalid or crossed.
+    bool get_signals(BookSignals& out) const;
 
 private:
+    const InstrumentSpec instrument_;
     std::array<PriceLevel, MAX_LEVELS> bids_;
     std::array<PriceLevel, MAX_LEVELS> asks_;
     std::atomic<int> bid_count_{0};
     std::atomic<int> ask_count_{0};
     std::atomic<uint64_t> update_id_{0};
-};
\ No newline at end of file
+
+    // Seqlock: odd while the writer is mutating the book
+    std::atomic<uint64_t> version_{0};
+
+    // Exchange sequencing ("u" / "seq" fields of the orderbook topic)
+    std::atomic<uint64_t> last_update_id_{0};
+    std::atomic<uint64_t> last_seq_{0};
+    std::atomic<bool> valid_{false};
+    std::atomic<bool> resync_pending_{false};
+    std::atomic<uint64_t> last_rx_tick_{0};
+    std::atomic<uint64_t> last_applied_tick_{0};
+
+    // Serializes writers (redundant feed lines); readers never touch it
+    std::atomic<bool> writer_claim_{false};
+
+    // Set once under the writer claim; written by the writer inside its write section
+    std::unique_ptr<SignalKernel> signal_storage_;
+    std::atomic<SignalKernel*> signals_{nullptr};
+
+    void lock_writer();
+    void unlock_writer();
+    void begin_write();
+    void end_write();
+
+    static int copy_levels(PriceLevel* dst, std::span<const PriceLevel> src);
+    static int apply_level(PriceLevel* levels, int count, const PriceLevel& level, bool descending,
+                           int& touched);
+    void copy_side(const PriceLevel* levels, int count, int max_levels,
+                   std::vector<std::pair<double, double>>& out) const;
+};
@@ -1,18 +1,90 @@
 #pragma once
 #include "core/OrderBook.h"
-#include <unordered_map>
+#include "core/SymbolRegistry.h"
+#include "core/BookChangeNotifier.h"
+#include "utils/MemoryPlacement.h"
+#include <array>
+#include <atomic>
 #include <memory>
 #include <mutex>
 #include <string>
 
+class OrderBookManager;
+
+// Iterable snapshot of the book directory: every book that existed when the view
+// was taken. Books are never removed, so the view stays valid for the manager's life.
+class BookDirectoryView {
+public:
+    struct Entry {
+        uint32_t id;
+        const std::string& symbol;
+        OrderBook* book;
+    };
+
+    class iterator {
+    public:
+        iterator(const OrderBookManager* mgr, uint32_t id, uint32_t end);
+        Entry operator*() const;
+        iterator& operator++();
+        bool operator!=(const iterator& other) const { return id_ != other.id_; }
+
+    private:
+        const OrderBookManager* mgr_;
+        uint32_t id_;
+        uint32_t end_;
+        void skip_empty();
+    };
+
+    BookDirectoryView(const OrderBookManager* mgr, uint32_t end) : mgr_(mgr), end_(end) {}
+    iterator begin() const { return iterator(mgr_, 0, end_); }
+    iterator end() const { return iterator(mgr_, end_, end_); }
+
+private:
+    const OrderBookManager* mgr_;
+    uint32_t end_;
+};
+
+// Symbol -> OrderBook directory.
+// Books live in a flat array indexed by SymbolRegistry ID. Each slot is an atomic
+// pointer published once (release) when the book is created, so get(id) is a single
+// acquire load: no lock, no hashing. Creation is the only locked (cold) path.
+// The books themselves sit in one arena, slot = symbol ID (huge-page backed when
+// enabled), so walking the books of a shard touches few pages and TLB entries.
 class OrderBookManager {
 public:
-    std::shared_ptr<OrderBook> get_or_create(const std::string& symbol);
-    std::shared_ptr<OrderBook> get(const std::string& symbol) const;
-    std::unordered_map<std::string, std::shared_ptr<OrderBook>> get_all() const;
+    OrderBookManager() = default;
+    ~OrderBookManager();
+    OrderBookManager(const OrderBookManager&) = delete;
+    OrderBookManager& operator=(const OrderBookManager&) = delete;
+
+    // Cold path (subscribe time): interns the symbol and creates its book if needed
+    OrderBook* get_or_create(const std::string& symbol);
+    OrderBook* get_or_create(uint32_t symbol_id);
+
+    // Cold path: name lookup through the registry
+    OrderBook* get(const std::string& symbol) const;
+
+    // Hot path: lock-free, nullptr if no book exists for the ID
+    OrderBook* get(uint32_t symbol_id) const {
+        if (symbol_id >= SymbolRegistry::MAX_SYMBOLS) return nullptr;
+        return books_[symbol_id].load(std::memory_order_acquire);
+    }
+
+    BookDirectoryView get_all() const;
     size_t size() const;
 
+    // Feed threads notify() after applying an update; engines watch and wait on it
+    BookChangeNotifier& change_notifier() { return change_notifier_; }
+
 private:
-    std::unordered_map<std::string, std::shared_ptr<OrderBook>> orderbooks_;
+    std::array<std::atomic<OrderBook*>, SymbolRegistry::MAX_SYMBOLS> books_{};
+    std::atomic<size_t> book_count_{0};
+    BookChangeNotifier change_notifier_;
+
+    // Owns the books: mapped on the first create, each slot faulted in (on the creating
+    // thread's NUMA node) when its book is built; only touched under mutex_
+    static constexpr size_t BOOK_STRIDE =
+        (sizeof(OrderBook) + alignof(OrderBook) - 1) / alignof(OrderBook) * alignof(OrderBook);
+    MappedRegion arena_;
     mutable std::mutex mutex_;
-};
\ No newline at end of file
+};
@@ -0,0 +1,85 @@
+#pragma once
+#include <array>
+#include <cstdint>
+
+struct PriceLevel;
+
+// Feature settings of the books that trade (BotConfiguration::signal_params)
+struct SignalParams {
+    int imbalance_levels = 5;           // Top-N levels per side in the imbalance
+    double depth_bps = 10.0;            // Depth band around mid for bid/ask_depth_lots
+    int64_t vwap_target_lots = 0;       // Size the VWAPs are priced for (0 = no VWAP)
+    double spread_alpha = 0.05;         // EWMA weight of each update's spread
+    double volatility_alpha = 0.05;     // EWMA weight of each mid change's squared return
+};
+
+// Book-derived features of one symbol, as of one book version. Prices in (fractional)
+// ticks, sizes in lots of the book's instrument.
+struct BookSignals {
+    double microprice = 0.0;            // (bid * ask_qty + ask * bid_qty) / (bid_qty + ask_qty)
+    double imbalance = 0.0;             // Top-N (bid - ask) / (bid + ask) size, in [-1, 1]
+    int64_t bid_depth_lots = 0;         // Resting within depth_bps of mid
+    int64_t ask_depth_lots = 0;
+    double bid_vwap = 0.0;              // Average price of selling vwap_target_lots into the bids
+    double ask_vwap = 0.0;              // ... of buying it from the asks (0 = book too thin)
+    double ewma_spread = 0.0;           // Ticks
+    double ewma_volatility_bps = 0.0;   // Of mid-to-mid returns
+    uint64_t update_id = 0;             // Book update the features are from
+    uint64_t updates = 0;               // Book updates folded into the EWMAs
+    bool valid = false;                 // Both sides non-empty and uncrossed
+};
+
+// Incremental feature maintenance for one book, run by the book's writer inside its
+// write section (OrderBook::enable_signals), so readers get the features from the same
+// seqlocked version as the levels - one struct copy, whatever the depth.
+//
+// The kernel mirrors each side as structure-of-arrays (prices, quantities), rewriting it
+// only from the first level the update touched. A side is re-aggregated only if that
+// level is within its reach (the levels its features read last time) or mid moved (the
+// depth band moved with it); a delta deep in the book costs the mirror copy only.
+// Aggregation is branch-free masked sums over the fixed-size arrays, which the compiler
+// vectorizes (-O3 -march=native); the VWAP walk stops at the target size.
+//
+// EWMAs advance per book update (event time, not wall time), so a replay reproduces them
+// whatever its speed.
+class SignalKernel {
+public:
+    static constexpr int MAX_LEVELS = 50;       // == OrderBook::MAX_LEVELS
+
+    explicit SignalKernel(const SignalParams& params) : params_(params) {}
+
+    // *_from: first index of the side the update changed (count if untouched, 0 for a
+    // snapshot). A snapshot does not feed its mid jump into the volatility.
+    void update(const PriceLevel* bids, int bid_count, int bid_from,
+                const PriceLevel* asks, int ask_count, int ask_from,
+                uint64_t update_id, bool snapshot);
+    // Book invalidated (gap): features unusable until the next snapshot
+    void invalidate() { signals_.valid = false; }
+
+    const BookSignals& signals() const { return signals_; }
+    const SignalParams& params() const { return params_; }
+
+private:
+    static constexpr int ALWAYS = MAX_LEVELS + 1;   // Reach of a side whose features read every level
+
+    struct Side {
+        alignas(64) std::array<int64_t, MAX_LEVELS> price{};
+        alignas(64) std::array<int64_t, MAX_LEVELS> qty{};
+        int count = 0;
+        int reach = ALWAYS;
+        int64_t top_lots = 0;           // Sum over the imbalance levels
+        int64_t depth_lots = 0;
+        double vwap = 0.0;
+    };
+
+    SignalParams params_;
+    Side bid_side_;
+    Side ask_side_;
+    BookSignals signals_;
+    double last_mid_ = 0.0;
+    double variance_ = 0.0;             // EWMA of squared returns, bps^2
+
+    static void mirror(Side& side, const PriceLevel* levels, int count, int from);
+    // bids: in band if price >= cutoff; asks: price <= cutoff
+    void aggregate(Side& side, int64_t cutoff, bool is_bid, int64_t target_lots) const;
+};
@@ -3,16 +3,26 @@
 #include <string>
 #include <unordered_set>
 #include <mutex>
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include "core/SymbolRegistry.h"
 
 class SymbolManager {
 public:
     SymbolManager() = default;
     
-    // Add symbol if not already tracked
+    // Add symbol if not already tracked (interns it in the SymbolRegistry)
     bool add_symbol(const std::string& symbol);
     
     // Check if symbol is subscribed
     bool is_subscribed(const std::string& symbol) const;
+
+    // Hot path: lock-free flag lookup by SymbolRegistry ID
+    bool is_subscribed(uint32_t symbol_id) const {
+        return symbol_id < SymbolRegistry::MAX_SYMBOLS &&
+               subscribed_flags_[symbol_id].load(std::memory_order_acquire);
+    }
     
     // Get all subscribed symbols
     std::vector<std::string> get_all_symbols() const;
@@ -22,5 +32,6 @@ public:
 
 private:
     std::unordered_set<std::string> subscribed_symbols_;
+    std::array<std::atomic<bool>, SymbolRegistry::MAX_SYMBOLS> subscribed_flags_{};
     mutable std::mutex mutex_;
-};
\ No newline at end of file
+};
@@ -0,0 +1,44 @@
+#pragma once
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+// Process-wide symbol interning: every symbol gets a dense uint32_t ID the first
+// time it is seen (normally at subscribe time). IDs index flat per-symbol arrays
+// (book directory, subscription flags, ...), so hot paths never hash a string.
+//
+// THREADING: intern()/find() take a mutex (cold path only).
+// name()/size() are lock-free: a slot is written before the count that publishes it.
+class SymbolRegistry {
+public:
+    static constexpr uint32_t MAX_SYMBOLS = 4096;
+    static constexpr uint32_t INVALID_ID = UINT32_MAX;
+
+    static SymbolRegistry& get_instance();
+
+    // Returns the existing ID or assigns the next one. INVALID_ID if the registry is full.
+    uint32_t intern(std::string_view symbol);
+
+    // INVALID_ID if the symbol was never interned
+    uint32_t find(std::string_view symbol) const;
+
+    const std::string& name(uint32_t id) const;
+    uint32_t size() const { return count_.load(std::memory_order_acquire); }
+
+private:
+    SymbolRegistry() = default;
+
+    struct TransparentHash {
+        using is_transparent = void;
+        size_t operator()(std::string_view sv) const { return std::hash<std::string_view>{}(sv); }
+    };
+
+    std::array<std::string, MAX_SYMBOLS> names_;
+    std::atomic<uint32_t> count_{0};
+    std::unordered_map<std::string, uint32_t, TransparentHash, std::equal_to<>> ids_;
+    mutable std::mutex mutex_;
+};
@@ -4,62 +4,144 @@
 #include <atomic>
 #include <string>
 #include <cstdint>
-#include <unordered_map>
-#include <mutex>
-
-// [CRITICAL FIX]
-// This struct must use 'char[]' arrays, NOT 'std::string'.
-// 1. Strings cannot be copied with strncpy (causing your error).
-// 2. Strings crash Shared Memory (Aeron) because they contain pointers.
-struct AeronOrderRecord {
-    char order_id[64];  // Fixed buffer for ID
-    char symbol[32];    // Fixed buffer for "BTCUSDT"
-    char side[8];       // Fixed buffer for "Buy"/"Sell"
-    double price;
-    double quantity;
-    int64_t timestamp;
-    bool is_active;
-};
+#include <vector>
+#include "core/SymbolRegistry.h"
+#include "messaging/PublishPolicy.h"
+#include "utils/CpuPause.h"
 
+// One Aeron publication (stream).
+// publish_claim() is the zero-copy path: it claims exactly `length` bytes of the term
+// buffer and lets the caller's encoder fill them in place (messages up to
+// maxPayloadLength; larger ones are encoded into a scratch and offered, fragmented).
+// publish() offers a ready buffer. Both apply the publisher's BackPressurePolicy.
+//
+// THREADING: publish() with SPIN / DROP may be called from any thread (Aeron
+// publications are concurrent). publish_claim() and CONFLATE keep per-publisher state:
+// one publishing thread (each feed shard owns its publisher), which also calls flush().
 class AeronPublisher {
 public:
-    AeronPublisher(const std::string& channel, int32_t stream_id);
+    static constexpr size_t MAX_MESSAGE_BYTES = 64 * 1024;     // Fragmented publish_claim() limit
+
+    AeronPublisher(const std::string& channel, int32_t stream_id, const AeronPublishOptions& options = {});
     ~AeronPublisher() = default;
     
     bool init();
     
-    // ✨ NEW: Order-specific publish methods
-    bool publish_order(const AeronOrderRecord& order);
     bool publish_orderbook(const char* buffer, size_t length);
 
-    void service_context();
-    
-    // ✨ NEW: Order buffer management
-    bool has_order_in_buffer(const std::string& symbol) const;
-    AeronOrderRecord get_order_from_buffer(const std::string& symbol) const;
-    void remove_order_from_buffer(const std::string& symbol);
-    void update_order_in_buffer(const std::string& symbol, const AeronOrderRecord& order);
-    
-    // ✨ NEW: Get all orders
-    std::unordered_map<std::string, AeronOrderRecord> get_all_orders() const;
+    // One client conductor duty cycle (AeronPublishOptions::conductor_invoker; no-op
+    // otherwise). Returns the work done. Call from one thread, once init() returned.
+    int service_context();
     
+    // encode(char* buffer, size_t capacity) writes the message and returns its length;
+    // anything but `length` aborts the claim. symbol_id keys conflation (INVALID_ID:
+    // never conflated). True if the message was published or parked.
+    template <typename Encode>
+    bool publish_claim(uint32_t symbol_id, size_t length, Encode&& encode);
+
     // Original methods
-    bool publish(const char* buffer, size_t length);
+    bool publish(const char* buffer, size_t length, uint32_t symbol_id = SymbolRegistry::INVALID_ID);
     bool is_connected() const;
     uint64_t get_messages_sent() const;
+    uint64_t get_offer_failures() const;    // Dropped: back-pressured / not connected / errored
+    uint64_t get_conflated_count() const;   // Parked messages replaced by a newer one
+
+    // Retries the parked (conflated) messages; call from the publishing thread when idle
+    void flush();
 
 private:
     std::shared_ptr<aeron::Aeron> aeron_;
     std::shared_ptr<aeron::Publication> publication_;
     std::string channel_;
     int32_t stream_id_;
+    AeronPublishOptions options_;
+    size_t max_claim_ = 0;                  // Publication maxPayloadLength
     std::atomic<uint64_t> messages_sent_{0};
     std::atomic<uint64_t> offer_failures_{0};
-    
-    // ✨ NEW: In-memory order buffer (simulates Aeron buffer)
-    mutable std::mutex buffer_mutex_;
-    std::unordered_map<std::string, AeronOrderRecord> order_buffer_;
-    
-    // Helper to serialize order
-    std::string serialize_order(const AeronOrderRecord& order);
-};
\ No newline at end of file
+    std::atomic<uint64_t> conflated_{0};
+
+    // CONFLATE: latest parked message per symbol (fixed slots, allocated by init())
+    std::unique_ptr<char[]> parked_;
+    std::unique_ptr<uint16_t[]> parked_length_;
+    std::vector<uint32_t> parked_symbols_;  // Capacity MAX_SYMBOLS, never reallocates
+    std::unique_ptr<char[]> fragment_scratch_;
+
+    static bool is_back_pressure(int64_t result) {
+        return result == aeron::BACK_PRESSURED || result == aeron::ADMIN_ACTION;
+    }
+    bool should_retry(int64_t result, uint32_t& attempts) const {
+        return options_.policy == BackPressurePolicy::SPIN && is_back_pressure(result) &&
+               attempts++ < options_.spin_limit;
+    }
+    char* parked_slot(uint32_t symbol_id) { return parked_.get() + symbol_id * options_.conflation_slot_bytes; }
+    bool is_parked(uint32_t symbol_id) const {
+        return parked_ && symbol_id < SymbolRegistry::MAX_SYMBOLS && parked_length_[symbol_id] != 0;
+    }
+    // Parks encode()'s output as the symbol's latest message (CONFLATE), else drops it
+    template <typename Encode>
+    bool park(uint32_t symbol_id, int64_t result, size_t length, Encode&& encode);
+};
+
+// ============================================================================
+// ZERO-COPY PUBLISH (template)
+// ============================================================================
+template <typename Encode>
+bool AeronPublisher::publish_claim(uint32_t symbol_id, size_t length, Encode&& encode) {
+    if (!publication_) return false;
+
+    if (length > max_claim_) {
+        // Too large for one frame: encode aside and let offer() fragment it
+        if (length > MAX_MESSAGE_BYTES) {
+            offer_failures_.fetch_add(1, std::memory_order_relaxed);
+            return false;
+        }
+        if (encode(fragment_scratch_.get(), length) != length) return false;
+        return publish(fragment_scratch_.get(), length, symbol_id);
+    }
+
+    // A parked older copy goes first, or it is simply superseded
+    if (is_parked(symbol_id)) {
+        flush();
+        if (is_parked(symbol_id)) return park(symbol_id, aeron::BACK_PRESSURED, length, encode);
+    }
+
+    aeron::BufferClaim claim;
+    uint32_t attempts = 0;
+    for (;;) {
+        int64_t result = publication_->tryClaim(static_cast<aeron::util::index_t>(length), claim);
+        if (result > 0) {
+            char* buffer = reinterpret_cast<char*>(claim.buffer().buffer() + claim.offset());
+            if (encode(buffer, length) != length) {
+                claim.abort();
+                offer_failures_.fetch_add(1, std::memory_order_relaxed);
+                return false;
+            }
+            claim.commit();
+            messages_sent_.fetch_add(1, std::memory_order_relaxed);
+            return true;
+        }
+        if (should_retry(result, attempts)) {
+            cpu_pause();
+            continue;
+        }
+        return park(symbol_id, result, length, encode);
+    }
+}
+
+template <typename Encode>
+bool AeronPublisher::park(uint32_t symbol_id, int64_t result, size_t length, Encode&& encode) {
+    if (options_.policy != BackPressurePolicy::CONFLATE || !parked_ || !is_back_pressure(result) ||
+        symbol_id >= SymbolRegistry::MAX_SYMBOLS || length > options_.conflation_slot_bytes) {
+        offer_failures_.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+    if (encode(parked_slot(symbol_id), length) != length) return false;
+
+    if (parked_length_[symbol_id] != 0) {
+        conflated_.fetch_add(1, std::memory_order_relaxed);
+    } else {
+        parked_symbols_.push_back(symbol_id);
+    }
+    parked_length_[symbol_id] = static_cast<uint16_t>(length);
+    return true;
+}
@@ -0,0 +1,86 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+#include <vector>
+#include "core/OrderBook.h"
+#include "messaging/AeronPublisher.h"
+#include "messaging/PublishPolicy.h"
+
+// Book stream of one feed connection: turns "this book changed" into SBE messages on
+// its AeronPublisher.
+//
+// What subscribers mirror is the top DEPTH levels of each book. In DELTA mode a symbol's
+// message is the difference between that view now and the view this publication last
+// sent (new or changed levels, quantity 0 for levels that left it), as a BookDelta
+// chained by prevUpdateId. A full OrderBookSnapshot goes out first, after every
+// exchange snapshot and every snapshot_interval_ms, so late joiners and subscribers that
+// missed a message resynchronise. SNAPSHOT mode sends the full view every time.
+//
+// Conflation: at most one message per symbol per conflation_us. Updates inside the
+// window only mark the symbol dirty; the next publish (a later update, or flush() from
+// the service loop) carries the latest state. A message that back-pressure keeps out
+// simply leaves the symbol dirty, so the next diff covers everything since the last
+// one that made it - a chain is never broken by a dropped delta.
+//
+// Each connection has its own Aeron session; chains are per session.
+// THREADING: the connection's service thread only.
+class BookPublication {
+public:
+    static constexpr int DEPTH = 10;
+
+    // Per-symbol state, embedded in the connection's topic slot
+    struct Symbol {
+        uint32_t symbol_id = SymbolRegistry::INVALID_ID;
+        std::string_view symbol;            // Owned by the topic slot
+        const OrderBook* book = nullptr;
+
+        PriceLevel bids[DEPTH];             // The view last published
+        PriceLevel asks[DEPTH];
+        int bid_count = 0;
+        int ask_count = 0;
+        uint64_t update_id = 0;
+        bool has_baseline = false;
+
+        uint64_t last_publish_tick = 0;
+        uint64_t last_snapshot_tick = 0;
+        bool snapshot_due = true;
+        bool dirty = false;
+    };
+
+    BookPublication(AeronPublisher& publisher, const BookPublishOptions& options);
+
+    // Cold path: sizes the dirty list for another symbol
+    void add_symbol(Symbol& symbol);
+
+    // The symbol's book applied an update (exchange_snapshot: it was replaced)
+    void on_update(Symbol& symbol, bool exchange_snapshot);
+
+    // Publishes dirty symbols whose conflation window has passed
+    void flush();
+
+    uint64_t get_snapshots_sent() const { return snapshots_sent_.load(std::memory_order_relaxed); }
+    uint64_t get_deltas_sent() const { return deltas_sent_.load(std::memory_order_relaxed); }
+    uint64_t get_conflated_updates() const { return conflated_updates_.load(std::memory_order_relaxed); }
+
+private:
+    AeronPublisher& publisher_;
+    BookPublishOptions options_;
+    uint64_t window_ticks_;
+    uint64_t snapshot_ticks_;
+    std::vector<Symbol*> dirty_;
+    size_t symbols_ = 0;
+
+    std::atomic<uint64_t> snapshots_sent_{0};
+    std::atomic<uint64_t> deltas_sent_{0};
+    std::atomic<uint64_t> conflated_updates_{0};    // Updates folded into a later message
+
+    // True once the symbol is clean (published, or nothing to publish)
+    bool publish(Symbol& symbol, uint64_t now_tick);
+    bool publish_snapshot(Symbol& symbol, const OrderBook::View& top, uint64_t now_tick);
+    bool publish_delta(Symbol& symbol, const OrderBook::View& top, uint64_t now_tick);
+
+    static int diff_side(const PriceLevel* before, int before_count, const PriceLevel* after,
+                         int after_count, bool descending, PriceLevel* out);
+    static uint64_t timestamp_ns();
+};
@@ -1,22 +1,36 @@
 #pragma once
-#include <thread>
+#include <atomic>
+#include "messaging/MediaDriverOptions.h"
 
 extern "C" {
     #include "aeronmd.h"
 }
 
+// Process-wide embedded Aeron media driver, started by the first AeronPublisher::init().
+// configure() it before that: threading mode, idle strategies and thread placement are
+// fixed once the driver runs. In INVOKER mode nothing runs on its own and the owner calls
+// do_work() in a loop (main's Aeron service thread).
 class GlobalMediaDriver {
 public:
     static GlobalMediaDriver& get_instance();
+    void configure(const MediaDriverOptions& options);
     bool initialize();
     ~GlobalMediaDriver();
-    
+
+    bool is_invoker() const { return options_.threading == DriverThreading::INVOKER; }
+    // INVOKER: one duty cycle, returns the work done (0 before initialize() / other modes)
+    int do_work();
+
 private:
     GlobalMediaDriver();
     static GlobalMediaDriver* singleton_instance;
-    
+
+    // Driver threads report here as they start (pinning / priority per agent)
+    static void on_agent_start(void* state, const char* role_name);
+
+    MediaDriverOptions options_;
     aeron_driver_t* driver;
     aeron_driver_context_t* driver_context;
-    std::thread driver_thread;
     bool is_initialized;
-};
\ No newline at end of file
+    std::atomic<bool> invoker_ready_{false};
+};
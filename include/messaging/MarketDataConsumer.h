@@ -0,0 +1,186 @@
+#pragma once
+#include <Aeron.h>
+#include <FragmentAssembler.h>
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+#include "core/OrderBook.h"
+#include "core/SymbolRegistry.h"
+#include "messaging/SBEDecoder.h"
+
+// What a consumer does between polls that found nothing
+enum class ConsumerIdle {
+    BUSY_SPIN,  // Never gives up the core (pinned strategy threads)
+    YIELD,      // sched_yield()
+    BACKOFF,    // Spin, then yield, then park with growing sleeps (Aeron BackoffIdleStrategy)
+    SLEEP       // Fixed sleep (tools: aeron_spy's old 1ms behaviour)
+};
+
+struct ConsumerOptions {
+    std::string channel = "aeron:ipc";      // BotConfiguration::aeron_channel
+    int32_t stream_id = 1001;               // BotConfiguration::orderbook_stream_id
+    std::string aeron_dir;                  // Media driver directory (empty: Aeron's default)
+    int fragment_limit = 10;                // Fragments handled per poll()
+    ConsumerIdle idle = ConsumerIdle::BACKOFF;
+    int64_t backoff_max_spins = 10;
+    int64_t backoff_max_yields = 20;
+    int64_t backoff_min_park_ns = 1000;
+    int64_t backoff_max_park_ns = 1000000;
+    int64_t sleep_ns = 1000000;             // SLEEP
+    std::vector<std::string> symbols;       // Books to keep (empty: every symbol)
+};
+
+// Local mirror of one symbol's published view (BookPublication: top DEPTH levels per
+// side, best first). Prices and quantities are the message mantissas;
+// price = mantissa * 10^price_exponent.
+struct LocalBook {
+    static constexpr int MAX_LEVELS = OrderBook::MAX_LEVELS;
+
+    std::string symbol;
+    uint32_t symbol_id = SymbolRegistry::INVALID_ID;   // The gateway's SymbolRegistry ID
+    int8_t price_exponent = 0;
+    int8_t qty_exponent = 0;
+
+    std::array<PriceLevel, MAX_LEVELS> bids{};
+    std::array<PriceLevel, MAX_LEVELS> asks{};
+    int bid_count = 0;
+    int ask_count = 0;
+
+    uint64_t update_id = 0;                 // Exchange update ID the view is at
+    uint64_t seq = 0;
+    uint64_t timestamp_ns = 0;              // Publish time of the last message applied
+    int32_t session_id = 0;                 // Aeron session whose chain the book follows
+    bool valid = false;                     // False until a snapshot, and after a gap
+
+    uint64_t updates = 0;
+    uint64_t gaps = 0;
+
+    double price(int64_t mantissa) const { return sbe_codec::to_double(mantissa, price_exponent); }
+    double quantity(int64_t mantissa) const { return sbe_codec::to_double(mantissa, qty_exponent); }
+    double best_bid() const { return bid_count ? price(bids[0].price) : 0.0; }
+    double best_ask() const { return ask_count ? price(asks[0].price) : 0.0; }
+};
+
+enum class BookUpdate {
+    SNAPSHOT,   // Replaced (first sight, periodic refresh, or resync after a gap)
+    DELTA,      // Changed levels applied
+    GAP         // A delta did not chain: the book is invalid until the next snapshot
+};
+
+// Subscriber SDK for the gateway's book stream (orderbook_stream_id).
+//
+// Decodes OrderBookSnapshot / BookDelta with the generated SBE flyweights and keeps a
+// LocalBook per symbol, so many strategy processes on the host share the feed the
+// gateway decoded once. Deltas chain by prevUpdateId: one that does not continue the
+// book's update ID is a gap and the book waits for the next snapshot (sent every
+// snapshot_interval_ms). Each feed connection publishes its own chain (Aeron session):
+// a book follows the session of the last message it applied and ignores other sessions'
+// deltas unless they continue it, so redundant lines never look like gaps.
+//
+// Symbol filtering is by name, resolved once per gateway symbol ID: messages of
+// filtered symbols are dropped on the header, without walking their levels. Names
+// are re-checked on every applied message and the filter cache is reset when a new
+// session appears, so a restarted gateway (new IDs) is picked up.
+//
+// THREADING: one thread polls (poll() / run()) and runs the callbacks; books are only
+// valid on that thread. The counters may be read from any thread.
+class MarketDataConsumer {
+public:
+    using BookCallback = std::function<void(const LocalBook&, BookUpdate)>;
+
+    explicit MarketDataConsumer(const ConsumerOptions& options = {});
+
+    // Connects to the running media driver (the gateway's) and waits for the subscription
+    bool connect();
+    bool is_connected() const;
+
+    void set_book_callback(BookCallback cb) { book_callback_ = std::move(cb); }
+
+    // One batch of up to fragment_limit fragments; returns the number handled
+    int poll();
+    // poll() until `running` clears, idling per ConsumerOptions::idle between empty polls
+    void run(const std::atomic<bool>& running);
+
+    // nullptr if the symbol never arrived (or is filtered out)
+    const LocalBook* find(std::string_view symbol) const;
+    template <typename Fn>
+    void for_each_book(Fn&& fn) const {
+        for (const auto& book : books_) fn(*book);
+    }
+
+    uint64_t get_messages() const { return messages_.load(std::memory_order_relaxed); }
+    uint64_t get_snapshots() const { return snapshots_.load(std::memory_order_relaxed); }
+    uint64_t get_deltas() const { return deltas_.load(std::memory_order_relaxed); }
+    uint64_t get_gaps() const { return gaps_.load(std::memory_order_relaxed); }
+    uint64_t get_filtered() const { return filtered_.load(std::memory_order_relaxed); }
+    uint64_t get_stale() const { return stale_.load(std::memory_order_relaxed); }           // Duplicates / other sessions' deltas
+    uint64_t get_malformed() const { return malformed_.load(std::memory_order_relaxed); }   // Not our schema, or truncated
+    uint64_t get_other() const { return other_.load(std::memory_order_relaxed); }           // Our schema, not a book message
+
+private:
+    // Per gateway symbol ID: unresolved, filtered out, or index into books_
+    static constexpr int32_t SLOT_UNKNOWN = -1;
+    static constexpr int32_t SLOT_FILTERED = -2;
+
+    // Levels of the message being decoded, until its symbol name is known
+    struct Scratch {
+        std::array<PriceLevel, 2 * LocalBook::MAX_LEVELS> bids;
+        std::array<PriceLevel, 2 * LocalBook::MAX_LEVELS> asks;
+        int bid_count = 0;
+        int ask_count = 0;
+        bool overflow = false;
+    };
+
+    ConsumerOptions options_;
+    std::shared_ptr<aeron::Aeron> aeron_;
+    std::shared_ptr<aeron::Subscription> subscription_;
+    std::unique_ptr<aeron::FragmentAssembler> assembler_;
+    aeron::fragment_handler_t handler_;
+    BookCallback book_callback_;
+
+    std::vector<std::unique_ptr<LocalBook>> books_;
+    std::unordered_map<std::string, size_t> book_index_;    // Name -> books_ (cold)
+    std::array<int32_t, SymbolRegistry::MAX_SYMBOLS> slots_;
+    std::vector<int32_t> sessions_;
+    Scratch scratch_;
+
+    std::atomic<uint64_t> messages_{0};
+    std::atomic<uint64_t> snapshots_{0};
+    std::atomic<uint64_t> deltas_{0};
+    std::atomic<uint64_t> gaps_{0};
+    std::atomic<uint64_t> filtered_{0};
+    std::atomic<uint64_t> stale_{0};
+    std::atomic<uint64_t> malformed_{0};
+    std::atomic<uint64_t> other_{0};
+
+    // Single writer (the polling thread): a relaxed load + store, no locked add
+    static void count(std::atomic<uint64_t>& counter) {
+        counter.store(counter.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+    }
+
+    void on_fragment(char* data, size_t length, int32_t session_id);
+    void on_snapshot(const sbe_codec::Frame& frame, int32_t session_id);
+    void on_delta(const sbe_codec::Frame& frame, int32_t session_id);
+    // A gateway symbol ID maps to a book (or filtered) once; a new session resets it
+    void note_session(int32_t session_id);
+    bool is_filtered(uint32_t symbol_id) const {
+        return symbol_id < SymbolRegistry::MAX_SYMBOLS && slots_[symbol_id] == SLOT_FILTERED;
+    }
+    // Book for the message's ID and name (creating it on first sight); nullptr if filtered
+    LocalBook* resolve(uint32_t symbol_id, std::string_view symbol);
+
+    template <typename Group>
+    static void read_levels(Group& group, PriceLevel* out, int capacity, int& count, bool& overflow);
+    // Upserts by price, quantity 0 removes; false if a side would exceed MAX_LEVELS
+    static bool apply_changes(std::array<PriceLevel, LocalBook::MAX_LEVELS>& levels, int& count,
+                              const PriceLevel* changes, int change_count, bool descending);
+
+    template <typename Idle>
+    void run_with(Idle& idle, const std::atomic<bool>& running);
+};
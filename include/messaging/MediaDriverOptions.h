@@ -0,0 +1,43 @@
+#pragma once
+#include "utils/ThreadAffinity.h"
+
+// How the embedded media driver (GlobalMediaDriver) runs its agents
+enum class DriverThreading {
+    DEDICATED,          // Conductor, sender and receiver on a thread each
+    SHARED_NETWORK,     // Conductor on one thread, sender + receiver on another
+    SHARED,             // All three agents on one thread
+    INVOKER             // No driver thread: the Aeron service thread runs its duty cycle
+};
+
+// What an Aeron agent does after a duty cycle without work
+enum class AeronIdle {
+    SPIN,       // Busy-spin (pinned, isolated cores only)
+    YIELD,      // sched_yield()
+    BACKOFF,    // Spin, then yield, then park with growing sleeps (Aeron's default)
+    SLEEP       // Fixed park (Aeron sleep-ns)
+};
+
+inline const char* aeron_idle_name(AeronIdle idle) {
+    switch (idle) {
+        case AeronIdle::SPIN: return "spin";
+        case AeronIdle::YIELD: return "yield";
+        case AeronIdle::BACKOFF: return "backoff";
+        case AeronIdle::SLEEP: return "sleep-ns";
+    }
+    return "backoff";
+}
+
+// Aeron IPC never touches the sender / receiver (no network channels): the conductor
+// alone moves the publisher limits, so SHARED costs one thread and nothing else.
+struct MediaDriverOptions {
+    DriverThreading threading = DriverThreading::SHARED;
+    AeronIdle conductor_idle = AeronIdle::BACKOFF;      // SHARED: the shared thread's
+    AeronIdle sender_idle = AeronIdle::BACKOFF;         // SHARED_NETWORK: the network thread's
+    AeronIdle receiver_idle = AeronIdle::BACKOFF;
+
+    // Driver threads, by agent; SHARED runs on `conductor`, SHARED_NETWORK's network
+    // thread on `sender`. INVOKER runs wherever the Aeron service thread is placed.
+    ThreadPlacement conductor{};
+    ThreadPlacement sender{};
+    ThreadPlacement receiver{};
+};
@@ -0,0 +1,31 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+
+// What an AeronPublisher does when the publication is back-pressured (the slowest
+// subscriber is a full term window behind) or briefly unavailable (ADMIN_ACTION)
+enum class BackPressurePolicy {
+    SPIN,       // Retry up to spin_limit times, then drop (counted)
+    DROP,       // Drop at once (counted)
+    CONFLATE    // Park it as its symbol's latest message, replacing an older parked one;
+                // parked messages go out (newest only) as soon as there is room again
+};
+
+struct AeronPublishOptions {
+    BackPressurePolicy policy = BackPressurePolicy::CONFLATE;
+    uint32_t spin_limit = 64;
+    size_t conflation_slot_bytes = 512;     // Per symbol; larger messages are dropped instead
+    bool conductor_invoker = false;         // Client conductor driven by service_context(), no thread of its own
+};
+
+// What a feed publishes for a book update (BookPublication)
+enum class BookPublishMode {
+    SNAPSHOT,   // Full top-of-book view every time
+    DELTA       // Changed levels only, with periodic full snapshots for late joiners
+};
+
+struct BookPublishOptions {
+    BookPublishMode mode = BookPublishMode::DELTA;
+    uint32_t conflation_us = 100;           // Min interval between messages per symbol (0 = every update)
+    uint32_t snapshot_interval_ms = 1000;   // DELTA: full snapshot per symbol at least this often
+};
@@ -0,0 +1,66 @@
+#pragma once
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include "trading_sbe/MessageHeader.h"
+#include "trading_sbe/OrderBookSnapshot.h"
+#include "trading_sbe/OrderRecord.h"
+#include "trading_sbe/BookDelta.h"
+
+// Consumer side of schema/market_data.xml (see SBEEncoder.h for the producer).
+// read_frame() checks the message header once; wrap() then lays the generated flyweight
+// over the body with the sender's block length and version, so a newer producer that
+// appended fields is still readable and nothing is copied.
+//
+//   sbe_codec::Frame frame;
+//   if (sbe_codec::read_frame(data, length, frame) &&
+//       frame.template_id == trading::sbe::OrderBookSnapshot::sbeTemplateId()) {
+//       trading::sbe::OrderBookSnapshot msg;
+//       sbe_codec::wrap(msg, frame);
+//       auto& bids = msg.bids();
+//       while (bids.hasNext()) { bids.next(); sbe_codec::to_double(bids.price(), msg.priceExponent()); }
+//   }
+namespace sbe_codec {
+
+// Version 0 used another level layout (doubles) and is not decodable
+inline constexpr uint16_t MIN_SCHEMA_VERSION = 1;
+
+struct Frame {
+    char* buffer = nullptr;
+    size_t length = 0;
+    uint16_t template_id = 0;
+    uint16_t block_length = 0;
+    uint16_t version = 0;
+};
+
+// False if the buffer is shorter than the header + block, or from another schema/version
+inline bool read_frame(char* buffer, size_t length, Frame& out) {
+    constexpr size_t header_length = trading::sbe::MessageHeader::encodedLength();
+    if (length < header_length) return false;
+
+    trading::sbe::MessageHeader header;
+    header.wrap(buffer, 0, trading::sbe::OrderBookSnapshot::sbeSchemaVersion(), length);
+    if (header.schemaId() != trading::sbe::OrderBookSnapshot::sbeSchemaId()) return false;
+    if (header.version() < MIN_SCHEMA_VERSION) return false;
+    if (length < header_length + header.blockLength()) return false;
+
+    out.buffer = buffer;
+    out.length = length;
+    out.template_id = header.templateId();
+    out.block_length = header.blockLength();
+    out.version = header.version();
+    return true;
+}
+
+template <typename Message>
+Message& wrap(Message& msg, const Frame& frame) {
+    return msg.wrapForDecode(frame.buffer, trading::sbe::MessageHeader::encodedLength(),
+                             frame.block_length, frame.version, frame.length);
+}
+
+// Display helper: mantissa * 10^exponent
+inline double to_double(int64_t mantissa, int8_t exponent) {
+    return static_cast<double>(mantissa) * std::pow(10.0, exponent);
+}
+
+} // namespace sbe_codec
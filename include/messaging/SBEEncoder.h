@@ -1,53 +1,82 @@
 #pragma once
-
-#include <vector>
-#include <string>
+#include <array>
+#include <cstddef>
 #include <cstdint>
+#include <span>
+#include <string_view>
+#include "core/Instrument.h"
+#include "core/OrderBook.h"
+#include "trading_sbe/MessageHeader.h"
+#include "trading_sbe/OrderBookSnapshot.h"
+#include "trading_sbe/OrderRecord.h"
+#include "trading_sbe/BookDelta.h"
 
+// Encoders for the messages of schema/market_data.xml, on top of the flyweights the
+// SBE tool generates from it (generated/trading_sbe/, CMake target sbe_codecs).
+// The matching decoders are the same generated classes; see SBEDecoder.h.
+//
+// Every encode_*() writes one framed message (header + body) straight into a caller
+// buffer - an Aeron tryClaim() region, or the encoder's aligned scratch - and returns
+// its length, or 0 if it does not fit. Nothing allocates: the capacity is checked once
+// up front against the constexpr lengths below, so the flyweights are built with
+// SBE_NO_BOUNDS_CHECK and every field is one aligned store at a fixed offset.
+//
+// Prices and quantities go out as integer mantissas of the instrument's grid
+// (price = mantissa * 10^priceExponent), so they are exact and consumers need no
+// InstrumentSpec to read them.
 class SBEEncoder {
 public:
-    SBEEncoder() {
-        buffer_.resize(1024); // Allocate 1KB buffer
+    static constexpr size_t SCRATCH_SIZE = 4096;
+    static constexpr size_t HEADER_LENGTH = trading::sbe::MessageHeader::encodedLength();
+
+    // Encoded lengths, message header included
+    static constexpr size_t book_snapshot_length(size_t bid_levels, size_t ask_levels, size_t symbol_length) {
+        using Msg = trading::sbe::OrderBookSnapshot;
+        return HEADER_LENGTH + Msg::sbeBlockLength() +
+               Msg::Bids::sbeHeaderSize() + bid_levels * Msg::Bids::sbeBlockLength() +
+               Msg::Asks::sbeHeaderSize() + ask_levels * Msg::Asks::sbeBlockLength() +
+               Msg::symbolHeaderLength() + symbol_length;
+    }
+
+    static constexpr size_t book_delta_length(size_t bid_levels, size_t ask_levels, size_t symbol_length) {
+        using Msg = trading::sbe::BookDelta;
+        return HEADER_LENGTH + Msg::sbeBlockLength() +
+               Msg::Bids::sbeHeaderSize() + bid_levels * Msg::Bids::sbeBlockLength() +
+               Msg::Asks::sbeHeaderSize() + ask_levels * Msg::Asks::sbeBlockLength() +
+               Msg::symbolHeaderLength() + symbol_length;
+    }
+
+    static constexpr size_t order_record_length(size_t symbol_length) {
+        using Msg = trading::sbe::OrderRecord;
+        return HEADER_LENGTH + Msg::sbeBlockLength() + Msg::symbolHeaderLength() + symbol_length;
     }
 
-    void reset();
-    char* data();
-    size_t size() const;
-
-    // Existing methods
-    void encode_orderbook_snapshot(
-        uint64_t timestamp,
-        const std::vector<std::pair<double, double>>& bids,
-        const std::vector<std::pair<double, double>>& asks,
-        const std::string& symbol
-    );
-
-    void encode_trade_signal(
-        uint64_t timestamp,
-        uint8_t action,
-        double price,
-        double quantity,
-        const std::string& symbol
-    );
-
-    // [NEW] This is the function missing in your error!
-    void encode_order(
-        uint64_t timestamp,
-        const std::string& order_id,
-        const std::string& symbol,
-        const std::string& side,
-        double price,
-        double quantity,
-        bool is_active
-    );
+    // Top max_levels of both sides of one consistent book version. Call from inside
+    // OrderBook::read_consistent(): a retry simply rewrites the same bytes.
+    static size_t encode_book_snapshot(char* buffer, size_t capacity, uint64_t timestamp_ns,
+                                       uint32_t symbol_id, std::string_view symbol,
+                                       const InstrumentSpec& instrument, const OrderBook::View& book,
+                                       int max_levels);
+
+    // Changed levels only (quantity 0 = removed), covering (prev_update_id, update_id]
+    static size_t encode_book_delta(char* buffer, size_t capacity, uint64_t timestamp_ns,
+                                    uint32_t symbol_id, std::string_view symbol,
+                                    const InstrumentSpec& instrument,
+                                    std::span<const PriceLevel> bids, std::span<const PriceLevel> asks,
+                                    uint64_t update_id, uint64_t prev_update_id, uint64_t seq);
+
+    // order_link_id longer than the schema's 36 chars does not fit (returns 0)
+    static size_t encode_order(char* buffer, size_t capacity, uint64_t timestamp_ns,
+                               uint32_t symbol_id, std::string_view symbol,
+                               const InstrumentSpec& instrument, std::string_view order_link_id,
+                               bool is_buy, int64_t price_ticks, int64_t qty_lots, bool is_active);
+
+    // Scratch for publishers that copy (offer) rather than claim
+    char* scratch() { return scratch_.data(); }
 
 private:
-    std::vector<char> buffer_;
-    size_t offset_ = 0;
-
-    void write_uint8(uint8_t value);
-    void write_uint16(uint16_t value);
-    void write_uint64(uint64_t value);
-    void write_double(double value);
-    void write_string(const std::string& str); // Helper for string writing
-};
\ No newline at end of file
+    alignas(64) std::array<char, SCRATCH_SIZE> scratch_;
+};
+
+static_assert(SBEEncoder::book_snapshot_length(OrderBook::MAX_LEVELS, OrderBook::MAX_LEVELS, 32) <=
+              SBEEncoder::SCRATCH_SIZE, "scratch must hold a full-depth snapshot");
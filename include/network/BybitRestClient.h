@@ -2,10 +2,26 @@
 #include <vector>
 #include <string>
 
+// One linear contract's precision as instruments-info reports it. The decimal strings
+// are kept verbatim: they parse exactly into ticks/lots and round-trip through the cache.
+struct InstrumentInfo {
+    std::string symbol;
+    std::string tick_size;      // priceFilter.tickSize
+    std::string qty_step;       // lotSizeFilter.qtyStep
+    std::string min_order_qty;  // lotSizeFilter.minOrderQty
+};
+
+// Instrument metadata helpers. The requests themselves are made by RestBootstrap.
 class BybitRestClient {
 public:
-    static std::vector<std::string> fetch_all_usdt_symbols();
+    // Linear USDT contracts of the universe (full-universe feed mode)
+    static std::vector<std::string> usdt_symbols(const std::vector<InstrumentInfo>& instruments);
+
+    // Publishes the specs in the InstrumentRegistry (before books/engines are created).
+    // Returns the number of instruments registered.
+    static size_t register_instruments(const std::vector<InstrumentInfo>& instruments);
 
-private:
-    static size_t curl_write_callback(void* contents, size_t size, size_t nmemb, std::string* output);
+    // Plain-text cache: one "SYMBOL TICK_SIZE QTY_STEP MIN_ORDER_QTY" line per instrument
+    static bool load_instrument_cache(const std::string& path, std::vector<InstrumentInfo>& out);
+    static bool save_instrument_cache(const std::string& path, const std::vector<InstrumentInfo>& instruments);
 };
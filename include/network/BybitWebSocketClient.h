@@ -4,7 +4,15 @@
 #include <vector>
 #include <atomic>
 #include <memory>
+#include <array>
+#include <deque>
+#include <string_view>
+#include <unordered_map>
+#include <mutex>
 #include <functional> // Required for std::function
+#include <random>
+#include <thread>
+#include <type_traits>
 #include <libwebsockets.h>
 #include <openssl/hmac.h>
 #include <openssl/sha.h>
@@ -15,20 +23,47 @@
 #include "utils/DataLogger.h"
 #include "messaging/AeronPublisher.h"
 #include "messaging/SBEEncoder.h"
+#include "messaging/BookPublication.h"
+#include "replay/FrameCapture.h"
+#include "network/FeedPolicy.h"
+#include "network/OrderRequestEncoder.h"
+#include "network/PrivateStreamDecoder.h"
+#include "utils/MpscRing.h"
+#include "utils/Tsc.h"
 #include "simdjson.h"
 
-class BybitWebSocketClient {
+// The redundant PUBLIC connections ("lines") of one feed shard. They carry the same
+// topics and write the same books; a line that drops out leaves the books to the
+// others instead of invalidating them.
+struct FeedLineGroup {
+    size_t lines = 1;
+    std::atomic<int> live{0};       // Lines connected and not stalled
+};
+
+// One Bybit v5 connection, specialized by a feed policy (see network/FeedPolicy.h).
+// BybitWebSocketClient is the runtime-configured default; FeedHandlerPool's shards run
+// PublicFeedClient, which has the public channel, its depth, publisher and journal fixed.
+//
+// THREADING: the service thread (run()) owns the lws connection. Every outgoing frame -
+// orders from the engine workers, auth and subscribes from main, pings and resyncs of the
+// service thread itself - is queued and written from LWS_CALLBACK_CLIENT_WRITEABLE;
+// other threads only call lws_cancel_service() to wake it.
+template <typename Policy>
+class BasicBybitWebSocketClient {
+    static_assert(is_supported_depth(Policy::DEPTH), "unsupported orderbook topic depth");
+    static_assert(std::is_same_v<typename Policy::Publisher, BookPublication> ||
+                  std::is_same_v<typename Policy::Publisher, NoBookPublication>,
+                  "books are published through BookPublication or not at all");
+
 public:
-    enum class ChannelType {
-        PUBLIC,
-        PRIVATE_TRADE,
-        PRIVATE_STREAM
-    };
+    using ChannelType = BybitChannelType;
 
-    // Callback Definition
-    using OrderUpdateCallback = std::function<void(const std::string&, const std::string&, const std::string&)>;
+    // Private channels: the updates on our orders (ClientOrderId) of one frame, in one
+    // call on the service thread (see PrivateStreamDecoder). Nothing is allocated per report.
+    using OrderUpdateCallback = typename Policy::OrderCallback;
 
-    BybitWebSocketClient(
+    // A PUBLIC policy ignores `type`
+    BasicBybitWebSocketClient(
         OrderBookManager& obm,
         SymbolManager& sm,
         BotConfiguration& config,
@@ -36,64 +71,238 @@ public:
         ChannelType type = ChannelType::PUBLIC
     );
     
-    ~BybitWebSocketClient();
+    ~BasicBybitWebSocketClient();
+
+    BasicBybitWebSocketClient(const BasicBybitWebSocketClient&) = delete;
+    BasicBybitWebSocketClient& operator=(const BasicBybitWebSocketClient&) = delete;
+
+    // Before connect(): host to dial (default BotConfiguration::ws_host) and, for a
+    // redundant public line, the group it arbitrates with
+    void set_endpoint(const std::string& host) { endpoint_ = host; }
+    void join_line_group(FeedLineGroup* group) { line_group_ = group; }
 
     void connect();
     void run();
     void stop();
     bool is_connected() const { return connected_; }
+    // Folds to a constant unless the policy leaves the channel to the constructor
+    bool is_public() const {
+        if constexpr (Policy::CHANNEL == FeedChannel::RUNTIME) return channel_type_ == ChannelType::PUBLIC;
+        else return Policy::CHANNEL == FeedChannel::PUBLIC;
+    }
+    bool is_authenticated() const { return authenticated_; }
 
     // Market Data
+    // Bybit accepts at most this many topics in one public subscribe request
+    static constexpr size_t MAX_SUBSCRIBE_ARGS = 10;
+
     void subscribe_to_symbol(const std::string& symbol);
-    void subscribe_to_private_topics();
+    // Packs the topics MAX_SUBSCRIBE_ARGS per frame and sends them back to back (no
+    // waiting in between); returns the number of frames sent. Acks arrive on the
+    // service thread and are counted in get_pending_subscribe_acks().
+    size_t subscribe_to_symbols(const std::vector<std::string>& symbols);
     
     // Trading Execution
     void authenticate();
-    void place_order(const std::string& symbol, const std::string& side, 
-                     double qty, double price, const std::string& order_link_id,bool is_maker);
-    void cancel_order(const std::string& symbol, const std::string& order_link_id);
+    // qty in lots, price in ticks of the symbol's instrument (see set_instrument).
+    // Returns tsc::now() taken once the request is queued for the service thread (0 if
+    // it was not); LatencyStage::SEND_QUEUE covers the rest up to lws_write.
+    uint64_t place_order(const std::string& symbol, const std::string& side, 
+                     int64_t qty_lots, int64_t price_ticks, std::string_view order_link_id,bool is_maker);
+    // False if the cancel was not queued (not connected, or the send queue is full)
+    bool cancel_order(const std::string& symbol, std::string_view order_link_id);
+    void set_instrument(const std::string& symbol, const InstrumentSpec& instrument);
 
-    // [CRITICAL FIX] 
-    // This setter MUST use 'on_order_update_' to match the .cpp file
     void set_order_update_callback(OrderUpdateCallback cb) {
-        on_order_update_ = cb; 
+        order_callback_ = std::move(cb);
+        private_decoder_.set_batch_sink(PrivateStreamDecoder::BatchSink::of(order_callback_));
+    }
+
+    // Records every raw public frame (with its receive time) into mmap'd segments
+    void enable_capture(const std::string& path_prefix);
+    uint64_t get_captured_frames() const;
+
+    // Replay hook: runs a frame through the same path as a live public frame.
+    // `data` must have `capacity` bytes allocated, at least len + SIMDJSON_PADDING.
+    void ingest_frame(char* data, size_t len, size_t capacity) {
+        frame_rx_tick_ = tsc::now();
+        handle_message(data, len, capacity);
     }
 
-    struct lws* get_wsi() const { return wsi_; }
     uint64_t get_message_count() const;
-    uint64_t get_aeron_count() const;
+    uint64_t get_aeron_count() const;           // Book messages (snapshots + deltas) published
+    uint64_t get_aeron_deltas() const;
+    uint64_t get_resync_count() const;
+    uint64_t get_duplicate_count() const;       // Updates another line applied first
+    uint64_t get_parse_error_count() const;
+    uint64_t get_aeron_backpressure() const;    // Dropped books of this connection's publisher
+    uint64_t get_aeron_conflated() const;       // Book updates folded into a later message
+    // Per symbol (SymbolRegistry ID), public channel only
+    uint64_t get_symbol_messages(uint32_t symbol_id) const;
+    uint64_t get_symbol_parse_errors(uint32_t symbol_id) const;
+    uint64_t get_hot_path_allocations() const;
+    uint64_t get_pending_subscribe_acks() const;
+    uint64_t get_subscribe_failures() const;
+
+    // Reconnect supervision: connections lost or stalled since start, and the time
+    // from losing the feed to every book holding a fresh snapshot again
+    uint64_t get_reconnect_count() const;
+    uint64_t get_last_recovery_ms() const;
+    uint64_t get_max_recovery_ms() const;
 
     static int callback_function(struct lws* wsi, enum lws_callback_reasons reason, 
                                void* user, void* in, size_t len);
 
 private:
+    static constexpr bool PUBLISHES_BOOKS = publishes_books_v<Policy>;
+
+    // A frame waiting for the service thread, LWS_PRE headroom in front of the payload
+    static constexpr size_t OUTBOUND_FRAME_CAP = 512;
+    static constexpr size_t OUTBOUND_CAPACITY = 128;
+    struct OutboundFrame {
+        uint64_t queued_tick;       // tsc::now() when it was queued
+        uint32_t length;
+        bool timed;                 // Order entry: recorded as LatencyStage::SEND_QUEUE
+        std::array<unsigned char, LWS_PRE + OUTBOUND_FRAME_CAP> bytes;
+    };
+
+    // Max levels decoded from a single message side. Snapshots carry the topic depth,
+    // deltas are usually far smaller; anything larger forces a resync.
+    static constexpr size_t MAX_DECODE_LEVELS = static_cast<size_t>(Policy::DEPTH) * 4;
+    using LevelScratch = std::array<PriceLevel, MAX_DECODE_LEVELS>;
+
+    // One interned orderbook topic of this connection
+    struct TopicSlot {
+        uint32_t symbol_id;
+        std::string symbol;
+        OrderBook* book;
+        bool awaiting_snapshot = false;     // Invalidated by a reconnect, not yet refreshed
+        bool resync_pending = false;        // Redundant line: this line's own resync in flight
+        BookPublication::Symbol publication;
+    };
+
+    // Per-symbol counters of this connection, by SymbolRegistry ID. Single writer (the
+    // service thread, plain load + store), read by the telemetry sampler.
+    struct SymbolStats {
+        std::atomic<uint64_t> messages{0};
+        std::atomic<uint64_t> parse_errors{0};
+    };
+
+    // Transparent hash so topic lookups can take a string_view (no temporary string)
+    struct TopicHash {
+        using is_transparent = void;
+        size_t operator()(std::string_view sv) const { return std::hash<std::string_view>{}(sv); }
+    };
+
     OrderBookManager& orderbook_manager_;
     SymbolManager& symbol_manager_;
     BotConfiguration& config_;
     DataLogger& data_logger_;
     
     ChannelType channel_type_;
+    std::string endpoint_;
+    FeedLineGroup* line_group_ = nullptr;
+    bool line_live_ = false;                // Counted in line_group_->live
     struct lws_context* context_ = nullptr;
     struct lws* wsi_ = nullptr;
+    struct lws* standby_wsi_ = nullptr;     // Replacement being opened next to a dying wsi_
     std::atomic<bool> running_{true};
     std::atomic<bool> connected_{false};
+    std::atomic<bool> authenticated_{false};
+    std::atomic<std::thread::id> service_thread_{};  // Thread in run()
     
     std::string api_key_;
     std::string api_secret_;
+    std::mutex send_mutex_;     // Order entry from several engine workers (order_encoder_)
+    OrderRequestEncoder<LWS_PRE> order_encoder_;
+    MpscRing<OutboundFrame, OUTBOUND_CAPACITY> outbound_;  // Written by the service thread only
 
     simdjson::ondemand::parser parser_;
     std::unique_ptr<AeronPublisher> aeron_pub_;
+    std::unique_ptr<BookPublication> book_publication_;    // Drives aeron_pub_ (public channel)
     SBEEncoder sbe_encoder_;
     std::atomic<uint64_t> messages_received_{0};
-    std::atomic<uint64_t> aeron_published_{0};
+    std::atomic<uint64_t> resyncs_requested_{0};
+    std::atomic<uint64_t> duplicates_dropped_{0};
+    std::atomic<uint64_t> parse_errors_{0};
+    std::unique_ptr<SymbolStats[]> symbol_stats_;
+    std::atomic<uint64_t> hot_path_allocations_{0};
+    std::atomic<uint64_t> subscribe_requests_{0};   // Frames sent (incl. resync re-subscribes)
+    std::atomic<uint64_t> subscribe_acks_{0};
+    std::atomic<uint64_t> subscribe_failures_{0};
+    std::unique_ptr<FrameCapture> capture_;
+
+    // Everything subscribed on this connection, replayed after a reconnect
+    std::mutex subscription_mutex_;
+    std::vector<std::string> subscribed_symbols_;
 
-    // [THE FIX IS HERE]
-    // Renamed from 'order_update_callback_' to 'on_order_update_'
-    OrderUpdateCallback on_order_update_;
+    // Reconnect supervisor state (service thread only)
+    bool stalled_ = false;                  // No frame within ws_stall_timeout_ms
+    int64_t last_rx_ns_ = 0;
+    int64_t last_ping_ns_ = 0;
+    int64_t next_reconnect_ns_ = 0;
+    int64_t backoff_ms_ = 0;
+    int64_t recovery_start_ns_ = 0;         // 0 = not recovering
+    size_t recovery_pending_books_ = 0;
+    std::minstd_rand jitter_rng_{std::random_device{}()};
+    std::atomic<uint64_t> reconnects_{0};
+    std::atomic<uint64_t> last_recovery_ms_{0};
+    std::atomic<uint64_t> max_recovery_ms_{0};
+
+    // Decode scratch (this connection's service thread only)
+    uint64_t frame_rx_tick_ = 0;            // tsc::now() when the current frame arrived
+    LevelScratch bid_scratch_;
+    LevelScratch ask_scratch_;
+    std::deque<TopicSlot> slots_;
+    std::unordered_map<std::string, uint32_t, TopicHash, std::equal_to<>> topic_slots_;
+
+    PrivateStreamDecoder private_decoder_;     // Private channels (order acks, order/execution topics)
+    OrderUpdateCallback order_callback_{};     // Target of private_decoder_'s batch sink
 
     std::string generate_signature(long long expires);
-    void handle_message(char* data, size_t len);
-    void handle_order_update(char* data, size_t len);
+    void handle_message(char* data, size_t len, size_t capacity);
+    void handle_order_update(char* data, size_t len, size_t capacity);
+    bool decode_levels(simdjson::ondemand::array levels, const InstrumentSpec& instrument,
+                       LevelScratch& out, size_t& count);
+    TopicSlot* resolve_topic(std::string_view topic);
+    void request_resync(const std::string& symbol, uint64_t got_id, uint64_t book_id);
+    void handle_subscribe_ack(simdjson::ondemand::document& doc);
+    size_t send_subscribe_frames(const std::vector<std::string>& symbols);
+    void subscribe_to_private_topics();     // Stream channel, on every auth success
+
+    // Any thread: queue a frame and wake the service thread. Returns the queue tick
+    // (0 if the frame is too big or the queue full).
+    static bool make_frame(OutboundFrame& frame, std::string_view payload, bool timed);
+    uint64_t push_frame(OutboundFrame& frame);
+    uint64_t queue_frame(std::string_view payload) {
+        OutboundFrame frame;
+        return make_frame(frame, payload, false) ? push_frame(frame) : 0;
+    }
+    // Cold path: waits for room instead of dropping the frame (except on the service
+    // thread, which is the one making room)
+    bool queue_frame_blocking(std::string_view payload);
+    // Service thread: CLIENT_WRITEABLE of wsi_, or a connection that went away
+    void write_outbound(struct lws* wsi);
+    void drop_outbound();
+
+    // Reconnect supervisor (service thread, between lws_service() calls)
+    struct lws* open_connection();
+    void supervise_connection();
+    void schedule_reconnect(int64_t now_ns);
+    void begin_recovery(int64_t now_ns);
+    void on_connection_restored(int64_t now_ns);
+    void finish_recovery(int64_t now_ns);
+    void send_ping();
+    bool is_redundant_line() const { return line_group_ && line_group_->lines > 1; }
+    void set_line_live(bool live);
+    static int64_t monotonic_ns();
     
     static struct lws_protocols protocols_[];
-};
\ No newline at end of file
+};
+
+using BybitWebSocketClient = BasicBybitWebSocketClient<RuntimeFeedPolicy>;
+using PublicFeedClient = BasicBybitWebSocketClient<PublicFeedPolicy<>>;
+
+// Instantiated in BybitWebSocketClient.cpp
+extern template class BasicBybitWebSocketClient<RuntimeFeedPolicy>;
+extern template class BasicBybitWebSocketClient<PublicFeedPolicy<>>;
\ No newline at end of file
@@ -0,0 +1,110 @@
+#pragma once
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "network/BybitWebSocketClient.h"
+#include "core/SymbolRegistry.h"
+
+// Pool of PUBLIC WebSocket connections ("shards") for the full-universe feed.
+//
+// Every symbol is owned by exactly one shard: its topic is subscribed only on that
+// shard's connection, so only that shard's service thread ever writes the book.
+// Each shard has its own lws context, simdjson parser, SBEEncoder and decode scratch
+// (all members of the client), so shards share nothing on the hot path. Every line is a
+// PublicFeedClient: the public channel, topic depth, book publisher and journal are fixed
+// at compile time, so the per-frame path carries no channel or publisher checks.
+//
+// Symbols listed in BotConfiguration::feed_isolated_symbols get a shard of their own
+// (while shards remain), so a hot book like BTCUSDT never delays the long tail.
+//
+// With BotConfiguration::feed_lines > 1 every shard is a FeedLineGroup of redundant
+// connections (A/B lines, optionally to different hosts) subscribed to the same topics,
+// each on its own thread. Whichever line delivers an update first applies it; the book's
+// update ID turns the later copies into STALE duplicates. A stalled or dropped line costs
+// nothing while another line of the shard is live.
+class FeedHandlerPool {
+public:
+    FeedHandlerPool(
+        OrderBookManager& obm,
+        SymbolManager& sm,
+        BotConfiguration& config,
+        DataLogger& logger
+    );
+    ~FeedHandlerPool();
+
+    void connect();
+    void start();       // One (optionally pinned) service thread per line of every shard
+    void stop();        // Stops and joins every line thread
+    bool all_connected() const;
+
+    // Routes the subscription to every line of the shard that owns the symbol
+    // (assigning one if new)
+    void subscribe_to_symbol(const std::string& symbol);
+    // Bulk version: assigns every new symbol a shard, then each shard sends its topics
+    // PublicFeedClient::MAX_SUBSCRIBE_ARGS per frame. Already subscribed symbols
+    // are skipped. Returns the number of frames sent over all shards.
+    size_t subscribe_to_symbols(const std::vector<std::string>& symbols);
+
+    // Blocks until every subscribe frame is answered and every subscribed book holds
+    // its first snapshot (or the timeout / running flag ends the wait). Polls at 1ms,
+    // so it returns about one round-trip after the last batch. False on timeout.
+    bool wait_until_warm(std::chrono::milliseconds timeout, const std::atomic<bool>& running);
+
+    size_t shard_count() const { return shards_.size(); }
+    size_t line_count() const { return shards_.empty() ? 0 : shards_[0]->lines.size(); }
+    PublicFeedClient& shard(size_t index, size_t line = 0) { return *shards_[index]->lines[line]; }
+    size_t shard_for(uint32_t symbol_id) const;
+
+    // Sums over all lines of all shards
+    uint64_t get_message_count() const;
+    uint64_t get_aeron_count() const;
+    uint64_t get_resync_count() const;
+    uint64_t get_duplicate_count() const;      // Copies dropped by A/B arbitration
+    uint64_t get_hot_path_allocations() const;
+    uint64_t get_captured_frames() const;
+    uint64_t get_reconnect_count() const;
+    uint64_t get_max_recovery_ms() const;      // Worst line
+    uint64_t get_parse_error_count() const;
+    uint64_t get_aeron_backpressure() const;
+    uint64_t get_aeron_deltas() const;
+    uint64_t get_aeron_conflated() const;
+
+    // Per symbol, summed over the lines of the owning shard (0 if unassigned)
+    uint64_t get_symbol_messages(uint32_t symbol_id) const;
+    uint64_t get_symbol_parse_errors(uint32_t symbol_id) const;
+
+private:
+    static constexpr uint8_t UNASSIGNED = 0xFF;
+
+    struct Shard {
+        FeedLineGroup group;
+        std::vector<std::unique_ptr<PublicFeedClient>> lines;
+    };
+
+    OrderBookManager& orderbook_manager_;
+    BotConfiguration& config_;
+    std::vector<std::unique_ptr<Shard>> shards_;
+    std::vector<std::thread> threads_;
+
+    // Symbol ID -> owning shard. Written at subscribe time (main thread) only.
+    std::vector<uint8_t> owner_;
+    std::vector<uint32_t> subscribed_;          // Symbol IDs, in subscribe order
+    std::vector<bool> is_subscribed_;           // By symbol ID
+    std::vector<size_t> shard_load_;
+    size_t isolated_shards_ = 0;    // Shards [0, isolated_shards_) are dedicated
+
+    size_t assign_shard(uint32_t symbol_id);
+    static std::string line_suffix(size_t line);
+
+    template <typename F>
+    void for_each_line(F&& f) const {
+        for (const auto& shard : shards_) {
+            for (const auto& line : shard->lines) f(*line);
+        }
+    }
+};
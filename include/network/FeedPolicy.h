@@ -0,0 +1,81 @@
+#pragma once
+#include <string_view>
+#include <type_traits>
+
+#include "core/OrderBook.h"
+#include "messaging/BookPublication.h"
+#include "network/PrivateStreamDecoder.h"
+#include "utils/DataLogger.h"
+
+// Compile-time configuration of a Bybit connection (BasicBybitWebSocketClient<Policy>).
+//
+// The runtime-configured client decides per frame which channel it is, whether a book
+// publisher exists and journals every frame. A policy fixes those choices in the type,
+// so the branches of the hot path fold away and what is left can be inlined:
+//   CHANNEL        RUNTIME (ChannelType given to the constructor) or PUBLIC
+//   DEPTH          orderbook topic depth: one Bybit serves that fits the book (1 or 50)
+//   Publisher      BookPublication (over the connection's AeronPublisher, when
+//                  enable_aeron) or NoBookPublication (nothing compiled in)
+//   Journal        JournalFrames (DataLogger record per raw frame) or SkipFrames
+//   OrderCallback  private channels: callable taking std::span<const OrderUpdate>
+//                  (RUNTIME only; the private channels run the runtime client)
+//
+// Member definitions live in BybitWebSocketClient.cpp, which instantiates the policies
+// the tree uses (declared `extern template` in BybitWebSocketClient.h). A new policy
+// gets its explicit instantiation there.
+
+// Which connection a client is
+enum class BybitChannelType {
+    PUBLIC,
+    PRIVATE_TRADE,
+    PRIVATE_STREAM
+};
+
+// What a policy fixes of that choice
+enum class FeedChannel {
+    RUNTIME,    // Any BybitChannelType, checked per frame
+    PUBLIC
+};
+
+// Linear orderbook depths Bybit serves (1, 50, 200, 500) that OrderBook can hold
+constexpr bool is_supported_depth(int depth) {
+    return (depth == 1 || depth == 50 || depth == 200 || depth == 500) && depth <= OrderBook::MAX_LEVELS;
+}
+
+// Book publisher of a connection that publishes nothing
+struct NoBookPublication {};
+
+// Raw frame journal: "MARKET_DATA" / "ORDER_RES" records of every received frame
+struct JournalFrames {
+    static void log(DataLogger& logger, std::string_view tag, std::string_view frame) {
+        logger.log(tag, frame);
+    }
+};
+
+struct SkipFrames {
+    static void log(DataLogger&, std::string_view, std::string_view) {}
+};
+
+// Everything decided at runtime - the default BybitWebSocketClient
+struct RuntimeFeedPolicy {
+    static constexpr FeedChannel CHANNEL = FeedChannel::RUNTIME;
+    static constexpr int DEPTH = OrderBook::MAX_LEVELS;
+    using Publisher = BookPublication;
+    using Journal = JournalFrames;
+    using OrderCallback = PrivateStreamDecoder::BatchCallback;
+};
+
+template <int Depth = OrderBook::MAX_LEVELS, typename BookPublisher = BookPublication,
+          typename FrameJournal = JournalFrames>
+struct PublicFeedPolicy {
+    static_assert(is_supported_depth(Depth), "Bybit serves no such orderbook depth, or the book cannot hold it");
+
+    static constexpr FeedChannel CHANNEL = FeedChannel::PUBLIC;
+    static constexpr int DEPTH = Depth;
+    using Publisher = BookPublisher;
+    using Journal = FrameJournal;
+    using OrderCallback = PrivateStreamDecoder::BatchCallback;     // Never called
+};
+
+template <typename Policy>
+inline constexpr bool publishes_books_v = !std::is_same_v<typename Policy::Publisher, NoBookPublication>;
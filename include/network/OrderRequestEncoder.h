@@ -0,0 +1,149 @@
+#pragma once
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include "core/Instrument.h"
+#include "utils/DecimalFormat.h"
+
+// Serializes Bybit v5 order.create / order.cancel requests straight into a send buffer.
+//
+// Each symbol gets a precomputed static prefix per operation
+//   {"header":{"X-BAPI-TIMESTAMP":"0000000000000",...},"op":"order.create",
+//    "args":[{"symbol":"BTCUSDT","category":"linear",...,"orderLinkId":"
+// built once when the symbol is first seen. A request is one memcpy of that prefix
+// into the send buffer, the 13 timestamp digits patched in place at their known
+// offset, and the tail (orderLinkId, side, qty, price, reqId) appended. Quantity and
+// price come in as lots/ticks and are written as lots * qtyStep / ticks * tickSize of
+// the symbol's instrument, so they are on the exchange grid by construction. The send
+// buffer keeps Headroom bytes in front of the payload, as lws_write() requires
+// (Headroom = LWS_PRE). The prefix is copied rather than sent from the template
+// because lws masks client frames in place.
+//
+// Not thread-safe: one encoder per connection, callers serialize sends.
+template <size_t Headroom, size_t Capacity = 512>
+class OrderRequestEncoder {
+public:
+    struct Encoded {
+        unsigned char* data;    // Headroom bytes of writable space precede this pointer
+        size_t length;
+    };
+
+    // Symbols never configured use the InstrumentSpec fallback grid (same as their books)
+    void set_instrument(std::string_view symbol, const InstrumentSpec& instrument) {
+        slot_for(symbol).instrument = instrument;
+    }
+
+    Encoded encode_create(std::string_view symbol, bool is_buy, int64_t qty_lots, int64_t price_ticks,
+                          std::string_view order_link_id, bool post_only, int64_t timestamp_ms) {
+        Slot& slot = slot_for(symbol);
+        char* out = begin_request(slot.create, timestamp_ms);
+        char* const end = payload() + PAYLOAD_CAP;
+        out = put(out, end, order_link_id);
+        out = put(out, end, is_buy ? R"(","side":"Buy")" : R"(","side":"Sell")");
+        out = put(out, end, post_only ? R"(,"timeInForce":"PostOnly","qty":")"
+                                      : R"(,"timeInForce":"GTC","qty":")");
+        out = put_steps(out, end, qty_lots, slot.instrument.lot);
+        out = put(out, end, R"(","price":")");
+        out = put_steps(out, end, price_ticks, slot.instrument.tick);
+        out = put(out, end, R"("}],"reqId":")");
+        out = put(out, end, order_link_id);
+        out = put(out, end, R"("})");
+        return finish(out);
+    }
+
+    Encoded encode_cancel(std::string_view symbol, std::string_view order_link_id, int64_t timestamp_ms) {
+        Slot& slot = slot_for(symbol);
+        char* out = begin_request(slot.cancel, timestamp_ms);
+        char* const end = payload() + PAYLOAD_CAP;
+        out = put(out, end, order_link_id);
+        out = put(out, end, R"("}]})");
+        return finish(out);
+    }
+
+private:
+    static constexpr size_t PAYLOAD_CAP = Capacity;
+    static constexpr size_t TIMESTAMP_DIGITS = 13;          // Epoch milliseconds
+    static constexpr size_t PREFIX_CAP = 192;
+
+    struct Prefix {
+        std::array<char, PREFIX_CAP> bytes;
+        size_t length = 0;
+        size_t timestamp_offset = 0;
+    };
+
+    struct Slot {
+        InstrumentSpec instrument;
+        Prefix create;
+        Prefix cancel;
+    };
+
+    struct StringHash {
+        using is_transparent = void;
+        size_t operator()(std::string_view sv) const { return std::hash<std::string_view>{}(sv); }
+    };
+
+    // Slots are heap-allocated once per symbol so references stay valid
+    std::unordered_map<std::string, std::unique_ptr<Slot>, StringHash, std::equal_to<>> slots_;
+    alignas(64) std::array<char, Headroom + Capacity> send_;
+
+    char* payload() { return send_.data() + Headroom; }
+
+    char* begin_request(const Prefix& prefix, int64_t timestamp_ms) {
+        std::memcpy(payload(), prefix.bytes.data(), prefix.length);
+        format_uint_fixed(payload() + prefix.timestamp_offset,
+                          static_cast<uint64_t>(timestamp_ms), TIMESTAMP_DIGITS);
+        return payload() + prefix.length;
+    }
+
+    Encoded finish(char* out) {
+        return {reinterpret_cast<unsigned char*>(payload()), static_cast<size_t>(out - payload())};
+    }
+
+    Slot& slot_for(std::string_view symbol) {
+        auto it = slots_.find(symbol);
+        if (it != slots_.end()) return *it->second;
+
+        auto slot = std::make_unique<Slot>();
+        build_prefix(slot->create, symbol, "order.create", R"(,"orderType":"Limit")");
+        build_prefix(slot->cancel, symbol, "order.cancel", "");
+        return *slots_.emplace(std::string(symbol), std::move(slot)).first->second;
+    }
+
+    static void build_prefix(Prefix& prefix, std::string_view symbol, std::string_view op,
+                             std::string_view extra_args) {
+        char* start = prefix.bytes.data();
+        char* const end = start + PREFIX_CAP;
+        char* out = put(start, end, R"({"header":{"X-BAPI-TIMESTAMP":")");
+        prefix.timestamp_offset = static_cast<size_t>(out - start);
+        std::memset(out, '0', TIMESTAMP_DIGITS);
+        out += TIMESTAMP_DIGITS;
+        out = put(out, end, R"(","X-BAPI-RECV-WINDOW":"5000"},"op":")");
+        out = put(out, end, op);
+        out = put(out, end, R"(","args":[{"symbol":")");
+        out = put(out, end, symbol);
+        out = put(out, end, R"(","category":"linear")");
+        out = put(out, end, extra_args);
+        out = put(out, end, R"(,"orderLinkId":")");
+        prefix.length = static_cast<size_t>(out - start);
+    }
+
+    // Bounded appends: an oversize field is truncated rather than overflowing
+    static char* put(char* out, char* end, std::string_view s) {
+        size_t n = std::min(s.size(), static_cast<size_t>(end - out));
+        std::memcpy(out, s.data(), n);
+        return out + n;
+    }
+
+    // units * step as a fixed-point decimal (negative counts clamp to 0)
+    static char* put_steps(char* out, char* end, int64_t units, const DecimalStep& step) {
+        if (end - out < 32) return out;
+        uint64_t mantissa = units > 0 ? static_cast<uint64_t>(units) * step.mantissa : 0;
+        return out + format_fixed(out, mantissa, step.decimals);
+    }
+};
@@ -0,0 +1,94 @@
+#pragma once
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <span>
+#include <string_view>
+#include "trading/OrderUpdate.h"
+#include "simdjson.h"
+
+// Decoder of the private channels: op responses (auth, order.create / order.cancel acks
+// on the trade connection) and the order / execution topics of the stream connection.
+//
+// A frame is parsed in place, in one pass over its top-level fields and one over its
+// `data` array. Every record about one of our orders (ClientOrderId) becomes a typed POD
+// OrderUpdate:
+//   execution.linear -> PARTIAL_FILL / FILL (execQty at execPrice; FILL once leavesQty is 0;
+//                       execId hashed into exec_id for the engines' duplicate check)
+//   order.linear     -> ACK (New), CANCEL (Cancelled, PartiallyFilledCanceled,
+//                       Deactivated), REJECT; its Filled / PartiallyFilled statuses are
+//                       left to the execution records, which carry the quantities
+//   order.create     -> REJECT (retCode != 0, orderLinkId from reqId)
+// The updates of a frame are handed to the batch sink together (in MAX_BATCH chunks),
+// so a burst of fills costs one callback and one engine wakeup, and nothing allocates.
+// The sink does not own the callback: its owner (the connection, typed by its feed
+// policy) does, so a concrete callback type is called without std::function.
+//
+// THREADING: the connection's service thread only.
+class PrivateStreamDecoder {
+public:
+    static constexpr size_t MAX_BATCH = 64;
+
+    // Default callback of the runtime-configured connection (RuntimeFeedPolicy)
+    using BatchCallback = std::function<void(std::span<const OrderUpdate>)>;
+
+    // Non-owning target: the callback object and a call thunk typed with it
+    struct BatchSink {
+        void* target = nullptr;
+        void (*call)(void*, std::span<const OrderUpdate>) = nullptr;
+
+        template <typename Callback>
+        static BatchSink of(Callback& callback) {
+            return {&callback, [](void* target, std::span<const OrderUpdate> updates) {
+                (*static_cast<Callback*>(target))(updates);
+            }};
+        }
+    };
+
+    enum class FrameKind : uint8_t {
+        AUTH,
+        ORDER_CREATE,
+        ORDER_CANCEL,
+        SUBSCRIBE,
+        TOPIC,          // order / execution push
+        OTHER,          // pong, unknown op or topic
+        MALFORMED
+    };
+
+    struct Frame {
+        FrameKind kind = FrameKind::OTHER;
+        bool success = false;           // Op responses: retCode == 0 or success == true
+        std::string_view message;       // retMsg / ret_msg; valid until the next decode()
+        size_t updates = 0;             // OrderUpdates emitted
+    };
+
+    // `sink.target` must outlive the decoder (or the next set_batch_sink)
+    void set_batch_sink(BatchSink sink) { sink_ = sink; }
+
+    // capacity >= length + SIMDJSON_PADDING
+    Frame decode(char* data, size_t length, size_t capacity);
+
+    uint64_t get_updates() const { return updates_.load(std::memory_order_relaxed); }
+    uint64_t get_batches() const { return batches_.load(std::memory_order_relaxed); }
+    uint64_t get_foreign_records() const { return foreign_.load(std::memory_order_relaxed); }
+
+private:
+    simdjson::ondemand::parser parser_;
+    BatchSink sink_;
+    std::array<OrderUpdate, MAX_BATCH> batch_;
+    size_t batch_size_ = 0;
+    uint64_t rx_tick_ = 0;
+
+    std::atomic<uint64_t> updates_{0};
+    std::atomic<uint64_t> batches_{0};
+    std::atomic<uint64_t> foreign_{0};      // Records on orders that are not ours
+
+    void decode_executions(simdjson::ondemand::array records, Frame& frame);
+    void decode_orders(simdjson::ondemand::array records, Frame& frame);
+    // Fills the ID; false (counted) if the orderLinkId is not one of ours
+    bool start_update(std::string_view order_link_id, OrderUpdate& update);
+    void emit(const OrderUpdate& update, Frame& frame);
+    void flush();
+};
@@ -0,0 +1,114 @@
+#pragma once
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <string>
+#include <string_view>
+#include <vector>
+#include <curl/curl.h>
+#include "config/BotConfiguration.h"
+#include "network/BybitRestClient.h"
+#include "simdjson.h"
+
+// One resting order as /v5/order/realtime reports it (decimal strings verbatim)
+struct ExchangeOrder {
+    std::string symbol;
+    std::string order_link_id;
+    std::string side;               // "Buy" / "Sell"
+    std::string price;
+    std::string qty;
+    std::string leaves_qty;
+    std::string order_status;
+};
+
+// One open position as /v5/position/list reports it (flat ones are skipped)
+struct ExchangePosition {
+    std::string symbol;
+    std::string side;               // "Buy" = long, "Sell" = short
+    std::string size;
+    std::string avg_price;
+};
+
+// Startup REST snapshot: instruments-info, open orders and positions, fetched concurrently.
+//
+// Every endpoint is one request chain on a single curl multi handle: the next page of a
+// chain is queued as soon as its cursor arrives, while the other chains are in flight.
+// Requests go out over HTTP/2 (multiplexed on one connection per host, PIPEWAIT) and the
+// multi handle's connection cache keeps those connections alive between pages, so only
+// the first request to a host pays for TCP + TLS.
+//
+// Each chain receives into its own padded buffer, reused across pages, and is parsed in
+// place with simdjson (no std::string accumulation, no padded_string copy).
+//
+// Warm restarts: instruments-info comes from the instrument cache when it is younger than
+// instrument_cache_max_age_s (no request at all), and the cache is rewritten after a fetch.
+// Orders and positions are always live - a cached position is worse than none.
+//
+// THREADING: cold path, main thread, before any connection or engine exists.
+class RestBootstrap {
+public:
+    struct Result {
+        std::vector<InstrumentInfo> instruments;
+        bool instruments_from_cache = false;
+        std::vector<ExchangeOrder> open_orders;
+        std::vector<ExchangePosition> positions;
+        bool snapshots_ok = false;      // Orders and positions complete (keys set, every page OK)
+        int requests = 0;               // HTTP requests made
+        std::chrono::milliseconds elapsed{0};
+
+        const ExchangePosition* find_position(std::string_view symbol) const;
+        size_t count_open_orders(std::string_view symbol) const;
+    };
+
+    explicit RestBootstrap(const BotConfiguration& config);
+    ~RestBootstrap();
+
+    RestBootstrap(const RestBootstrap&) = delete;
+    RestBootstrap& operator=(const RestBootstrap&) = delete;
+
+    // All chains to completion, failure or rest_timeout_ms. Never throws.
+    Result run();
+
+private:
+    enum class Endpoint { INSTRUMENTS, OPEN_ORDERS, POSITIONS };
+    static constexpr int MAX_PAGES = 32;        // Per chain; a longer list fails the chain
+
+    struct Chain {
+        Endpoint endpoint = Endpoint::INSTRUMENTS;
+        const char* name = "";
+        std::string host;
+        std::string path;               // e.g. "/v5/position/list"
+        std::string query;              // Without the cursor
+        bool signed_request = false;
+
+        CURL* easy = nullptr;
+        curl_slist* headers = nullptr;
+        std::vector<char> body;         // size >= received + SIMDJSON_PADDING
+        size_t received = 0;
+        std::string cursor;
+        int pages = 0;
+        bool done = false;
+        bool failed = false;
+        std::array<char, CURL_ERROR_SIZE> error{};
+    };
+
+    const BotConfiguration& config_;
+    CURLM* multi_ = nullptr;
+    simdjson::ondemand::parser parser_;
+    std::vector<Chain> chains_;
+    Result result_;
+
+    void add_chain(Endpoint endpoint, const char* name, const std::string& host,
+                   const char* path, const char* query, bool signed_request);
+    bool start_page(Chain& chain);
+    void on_page_done(Chain& chain, CURLcode code);
+    // Parses the page into result_; false on an API / parse error. Sets chain.cursor.
+    bool parse_page(Chain& chain);
+    void parse_instruments(simdjson::ondemand::array list);
+    void parse_open_orders(simdjson::ondemand::array list);
+    void parse_positions(simdjson::ondemand::array list);
+    // Bybit v5 auth headers for a GET with this query string
+    curl_slist* sign(const std::string& query) const;
+
+    static size_t write_callback(char* data, size_t size, size_t nmemb, void* user);
+};
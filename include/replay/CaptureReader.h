@@ -0,0 +1,43 @@
+#pragma once
+#include <cstdint>
+#include <string>
+#include "replay/FrameCapture.h"
+
+// One recorded frame. `data` points into the read-only mapping and stays valid until
+// the reader moves past the segment that holds it.
+struct CapturedFrame {
+    int64_t recv_ns = 0;
+    const char* data = nullptr;
+    uint32_t length = 0;
+};
+
+// Sequential reader over all segments of one capture ("<prefix>.NNNN.cap").
+class CaptureReader {
+public:
+    explicit CaptureReader(const std::string& path_prefix);
+    ~CaptureReader();
+
+    CaptureReader(const CaptureReader&) = delete;
+    CaptureReader& operator=(const CaptureReader&) = delete;
+
+    bool is_open() const { return base_ != nullptr; }
+    bool next(CapturedFrame& frame);
+
+    const std::string& prefix() const { return prefix_; }
+
+    // Accepts either a prefix or the path of one of its segment files
+    static std::string prefix_from_path(const std::string& path);
+
+private:
+    std::string prefix_;
+    uint64_t segment_index_ = 0;
+
+    int fd_ = -1;
+    const char* base_ = nullptr;
+    size_t mapped_bytes_ = 0;
+    uint64_t offset_ = 0;
+    uint64_t end_offset_ = 0;
+
+    bool open_segment(uint64_t index);
+    void close_segment();
+};
@@ -0,0 +1,73 @@
+#pragma once
+#include <atomic>
+#include <cstdint>
+#include <string>
+
+// ============================================================================
+// CAPTURE FILE FORMAT
+// ============================================================================
+// A capture is a sequence of segment files "<prefix>.0000.cap", "<prefix>.0001.cap", ...
+// Each segment is a 64-byte header followed by frames, every frame padded to 8 bytes:
+//
+//   [CaptureFrameHeader{recv_ns, length}][raw WebSocket frame bytes][pad]
+//
+// end_offset is advanced (release) after each frame is fully written, so a reader or
+// a crash always sees a valid prefix of the segment.
+
+struct CaptureSegmentHeader {
+    char magic[8];                      // "BYBTCAP1"
+    uint32_t version;
+    uint32_t header_bytes;
+    uint64_t segment_index;
+    int64_t created_ns;
+    std::atomic<uint64_t> end_offset;   // Bytes in use, header included
+    uint8_t reserved[24];
+};
+static_assert(sizeof(CaptureSegmentHeader) == 64, "capture header layout");
+
+struct CaptureFrameHeader {
+    int64_t recv_ns;                    // CLOCK_REALTIME when the last fragment arrived
+    uint32_t length;
+    uint32_t reserved;
+};
+
+inline constexpr char CAPTURE_MAGIC[8] = {'B', 'Y', 'B', 'T', 'C', 'A', 'P', '1'};
+inline constexpr uint32_t CAPTURE_VERSION = 1;
+
+// Append-only, memory-mapped frame recorder for one connection.
+// Single writer (the connection's service thread): append() is a memcpy into the
+// mapping plus one atomic store, no syscall except when rolling to a new segment.
+class FrameCapture {
+public:
+    FrameCapture(const std::string& path_prefix, size_t segment_bytes);
+    ~FrameCapture();
+
+    FrameCapture(const FrameCapture&) = delete;
+    FrameCapture& operator=(const FrameCapture&) = delete;
+
+    bool append(int64_t recv_ns, const char* data, size_t len);
+    void close();
+
+    bool is_open() const { return base_ != nullptr; }
+    uint64_t frames_written() const { return frames_written_.load(std::memory_order_relaxed); }
+    uint64_t frames_dropped() const { return frames_dropped_.load(std::memory_order_relaxed); }
+
+    static int64_t now_ns();
+    static std::string segment_path(const std::string& path_prefix, uint64_t index);
+
+private:
+    std::string prefix_;
+    size_t segment_bytes_;
+    uint64_t segment_index_ = 0;
+
+    int fd_ = -1;
+    char* base_ = nullptr;
+    CaptureSegmentHeader* header_ = nullptr;
+    uint64_t offset_ = 0;
+
+    std::atomic<uint64_t> frames_written_{0};
+    std::atomic<uint64_t> frames_dropped_{0};
+
+    bool open_segment(uint64_t index);
+    void close_segment();
+};
@@ -0,0 +1,75 @@
+#pragma once
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "replay/CaptureReader.h"
+#include "network/BybitWebSocketClient.h"
+#include "trading/TradingEngine.h"
+
+struct ReplayOptions {
+    // 1.0 = recorded wall-clock pace, N = N times faster, 0 = as fast as possible
+    double speed = 1.0;
+
+    // Strategy to drive with the replayed books ("" = books/publishing only).
+    // The engine runs without a trade client, so it evaluates signals but sends no orders.
+    std::string trade_symbol;
+};
+
+struct ReplayStats {
+    uint64_t frames = 0;
+    uint64_t bytes = 0;
+    uint64_t trading_cycles = 0;
+    int64_t capture_span_ns = 0;        // Last minus first receive timestamp
+    int64_t wall_ns = 0;                // Time the replay took
+};
+
+// Deterministic replay of recorded public frames.
+//
+// Frames from every capture (one per recorded feed shard) are merged by receive
+// timestamp and pushed through PublicFeedClient::ingest_frame() - the same decode,
+// book and publish path as live - then TradingEngine::run_trading_cycle() runs once per
+// frame. engine_clock is pinned to each frame's receive time, so strategy timers see
+// recorded time regardless of speed.
+class ReplayDriver {
+public:
+    ReplayDriver(
+        PublicFeedClient& client,
+        OrderBookManager& obm,
+        SymbolManager& sm,
+        DataLogger& logger,
+        const ReplayOptions& options
+    );
+    ~ReplayDriver();
+
+    // One capture prefix (or segment path) per recorded connection
+    bool add_capture(const std::string& path);
+
+    ReplayStats run(const std::atomic<bool>& running);
+
+    TradingEngine* engine() { return engine_.get(); }
+
+private:
+    struct Source {
+        std::unique_ptr<CaptureReader> reader;
+        CapturedFrame head;
+        bool has_head;
+    };
+
+    PublicFeedClient& client_;
+    OrderBookManager& orderbook_manager_;
+    SymbolManager& symbol_manager_;
+    DataLogger& logger_;
+    ReplayOptions options_;
+
+    std::vector<Source> sources_;
+    std::string frame_buffer_;      // Padded copy handed to the in-place parser
+    std::unique_ptr<TradingEngine> engine_;
+    uint32_t trade_symbol_id_ = SymbolRegistry::INVALID_ID;
+
+    int next_source() const;
+    void pace(int64_t capture_offset_ns, std::chrono::steady_clock::time_point wall_start) const;
+    void maybe_start_engine();
+};
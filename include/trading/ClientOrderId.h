@@ -0,0 +1,95 @@
+#pragma once
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+#include "core/SymbolRegistry.h"
+
+// Client order IDs (Bybit orderLinkId) that carry their own routing.
+//
+// Every order the bot sends is named
+//   "B" <engine: 4 hex> <symbol: 4 hex> <sequence: 16 hex>        (25 chars, max is 36)
+// engine = EngineScheduler slot of the engine that sent it, symbol = SymbolRegistry ID,
+// sequence = that engine's counter. An execution report is mapped back to its engine by
+// decoding digits at fixed positions - no string hashing or lookup - and the engine
+// matches its orders with an integer compare.
+//
+// Engine and symbol IDs are only meaningful in the process that assigned them. Every
+// engine counter starts at session_start() (wall clock, microseconds), so a sequence
+// below it names an order of a previous run (recovered from the OrderStateTable), which
+// is routed by its symbol instead; and IDs stay unique across restarts as long as one
+// engine sends fewer orders than microseconds pass between two starts.
+struct ClientOrderId {
+    static constexpr size_t LENGTH = 25;
+    static constexpr char PREFIX = 'B';
+
+    uint16_t engine_id = 0;
+    uint16_t symbol_id = 0;
+    uint64_t sequence = 0;          // 0 = no order
+
+    // Text form, NUL-terminated
+    struct Text {
+        char chars[LENGTH + 1];
+        std::string_view view() const { return {chars, LENGTH}; }
+    };
+
+    bool empty() const { return sequence == 0; }
+    bool operator==(const ClientOrderId&) const = default;
+
+    // First sequence of this process (the same for every engine)
+    static uint64_t session_start() {
+        static const uint64_t start = static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::microseconds>(
+            std::chrono::system_clock::now().time_since_epoch()).count());
+        return start;
+    }
+    bool from_this_session() const { return sequence >= session_start(); }
+
+    Text encode() const {
+        Text text;
+        text.chars[0] = PREFIX;
+        put_hex(text.chars + 1, engine_id, 4);
+        put_hex(text.chars + 5, symbol_id, 4);
+        put_hex(text.chars + 9, sequence, 16);
+        text.chars[LENGTH] = '\0';
+        return text;
+    }
+
+    // False for anything that is not an ID of this scheme (manual orders, other bots)
+    static bool decode(std::string_view text, ClientOrderId& out) {
+        if (text.size() != LENGTH || text[0] != PREFIX) return false;
+        uint64_t engine, symbol, sequence;
+        if (!get_hex(text.data() + 1, 4, engine) || !get_hex(text.data() + 5, 4, symbol) ||
+            !get_hex(text.data() + 9, 16, sequence) || sequence == 0) {
+            return false;
+        }
+        out.engine_id = static_cast<uint16_t>(engine);
+        out.symbol_id = static_cast<uint16_t>(symbol);
+        out.sequence = sequence;
+        return true;
+    }
+
+private:
+    static void put_hex(char* out, uint64_t value, int digits) {
+        static constexpr char DIGITS[] = "0123456789abcdef";
+        for (int i = digits - 1; i >= 0; i--) {
+            out[i] = DIGITS[value & 0xF];
+            value >>= 4;
+        }
+    }
+
+    static bool get_hex(const char* in, int digits, uint64_t& out) {
+        uint64_t value = 0;
+        for (int i = 0; i < digits; i++) {
+            char c = in[i];
+            uint64_t nibble;
+            if (c >= '0' && c <= '9') nibble = static_cast<uint64_t>(c - '0');
+            else if (c >= 'a' && c <= 'f') nibble = static_cast<uint64_t>(c - 'a' + 10);
+            else return false;
+            value = (value << 4) | nibble;
+        }
+        out = value;
+        return true;
+    }
+};
+
+static_assert(SymbolRegistry::MAX_SYMBOLS <= 0x10000, "symbol IDs must fit the 4 hex digits of an order ID");
@@ -0,0 +1,32 @@
+#pragma once
+#include <cstdint>
+#include "trading/ClientOrderId.h"
+#include "trading/OrderUpdate.h"
+
+enum class EngineEventType : uint8_t {
+    ORDER_UPDATE        // Execution report / order status from the private channels
+};
+
+// Fixed-size, trivially copyable entry of the engine inbox, so producers never
+// allocate and the engine owns its copy.
+struct EngineEvent {
+    EngineEventType type;
+    OrderEventType order_event;
+    ClientOrderId order_id;
+    Decimal exec_qty;           // Fills
+    Decimal exec_price;
+    uint64_t exec_id;           // Fills: OrderUpdate::exec_id
+    uint64_t rx_tick;           // tsc::now() when the producer received it
+
+    static EngineEvent order_update(const OrderUpdate& update) {
+        EngineEvent event{};
+        event.type = EngineEventType::ORDER_UPDATE;
+        event.order_event = update.type;
+        event.order_id = update.id;
+        event.exec_qty = update.exec_qty;
+        event.exec_price = update.exec_price;
+        event.exec_id = update.exec_id;
+        event.rx_tick = update.rx_tick;
+        return event;
+    }
+};
@@ -0,0 +1,106 @@
+#pragma once
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <span>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "trading/TradingEngine.h"
+#include "core/SymbolRegistry.h"
+
+// Runs one TradingEngine per symbol on a small pool of worker threads.
+//
+// Engines are event-driven: a worker only runs an engine's cycle when its book changed,
+// an execution report is queued, or its timer tick is due (order timeouts, status logs).
+// Every engine has a home worker, and its book and order updates ring that worker's
+// doorbell only. A worker with nothing of its own to do steals a ready engine from
+// another worker only when that one cannot get to it: it is busy with another engine's
+// cycle, or the engine has waited engine_steal_after_us. An engine is claimed with an
+// atomic flag for the duration of a cycle, so it only ever runs on one thread at a time
+// and keeps a single writer. Idle workers park on their doorbell
+// (BotConfiguration::engine_wait_mode).
+//
+// Workers never write to the trade connection themselves: orders and cancels go into
+// its send queue, which the connection's service thread drains. A request that could
+// not be queued is reported back (0 / false), and the engine does not wait for it.
+class EngineScheduler {
+public:
+    EngineScheduler(
+        OrderBookManager& obm,
+        SymbolManager& sm,
+        DataLogger& logger,
+        BotConfiguration& config,
+        BybitWebSocketClient* trade_client,
+        std::shared_ptr<AeronPublisher> aeron_pub
+    );
+    ~EngineScheduler();
+
+    // Setup (before start)
+    void add_engine(const std::string& symbol);
+    // Routes a client's order updates to the engines
+    void attach(BybitWebSocketClient& client);
+    // Polls every engine's book with one shared deadline; false if some are not ready
+    bool wait_for_market_data(std::chrono::milliseconds timeout);
+
+    void start();
+    void stop();
+
+    // Any thread: deliver each update to the engine that sent the order, named by its
+    // ClientOrderId, and wake the engines once for the whole batch. Orders of a previous
+    // run go to the engine trading their symbol; without a symbol (order.create rejects)
+    // to every engine, each filtering on its own order IDs.
+    void route_order_updates(std::span<const OrderUpdate> updates);
+
+    size_t engine_count() const { return slots_.size(); }
+    size_t worker_count() const { return workers_.size(); }
+    uint64_t get_cycles() const { return cycles_.load(std::memory_order_relaxed); }
+    uint64_t get_steals() const { return steals_.load(std::memory_order_relaxed); }
+    uint64_t get_timer_ticks() const { return timer_ticks_.load(std::memory_order_relaxed); }
+
+private:
+    static constexpr uint16_t NO_ENGINE = 0xFFFF;
+
+    struct alignas(64) EngineSlot {
+        std::unique_ptr<TradingEngine> engine;
+        size_t home = 0;
+        std::atomic<bool> busy{false};          // Claimed by a worker for one cycle
+        std::atomic<int64_t> last_run_ns{0};
+        std::atomic<int64_t> ready_seen_ns{0};  // First seen ready by another worker (0 = not)
+    };
+
+    struct alignas(64) WorkerState {
+        std::atomic<bool> in_cycle{false};      // Running an engine's cycle right now
+    };
+
+    OrderBookManager& orderbook_manager_;
+    SymbolManager& symbol_manager_;
+    DataLogger& logger_;
+    BotConfiguration& config_;
+    BybitWebSocketClient* trade_client_;
+    std::shared_ptr<AeronPublisher> aeron_publisher_;
+
+    std::vector<std::unique_ptr<EngineSlot>> slots_;
+    std::vector<uint16_t> engine_by_symbol_;    // SymbolRegistry ID -> slot index
+    std::vector<std::thread> workers_;
+    std::unique_ptr<WorkerState[]> worker_state_;
+    std::atomic<bool> running_{false};
+    int64_t tick_ns_;
+    int64_t steal_after_ns_;
+
+    std::atomic<uint64_t> cycles_{0};
+    std::atomic<uint64_t> steals_{0};
+    std::atomic<uint64_t> timer_ticks_{0};
+
+    size_t worker_count_config() const { return static_cast<size_t>(std::max(config_.engine_workers, 1)); }
+    // Queues the update; sets the bit of every home doorbell it needs rung
+    void route(const OrderUpdate& update, uint32_t& doorbells);
+    void worker_loop(size_t worker);
+    bool run_ready(size_t worker, bool steal);
+    bool stealable(EngineSlot& slot, int64_t now);
+    int64_t next_tick_delay_ns(size_t worker, int64_t now) const;
+    static int64_t now_ns();
+};
@@ -0,0 +1,119 @@
+#pragma once
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <string_view>
+#include "core/SymbolRegistry.h"
+#include "utils/DecimalFormat.h"
+
+// Memory-mapped open-order table: what each engine has on the exchange right now,
+// kept in a file so a restarted bot picks it up again (reconcile_state_on_startup)
+// with a read of its slot, no REST round-trip.
+//
+// One fixed slot per SymbolRegistry ID. Each slot has one writer (the symbol's engine
+// thread) and is seqlock-versioned like OrderBook: the version is odd while the engine
+// rewrites the record, so readers - the engine on startup, or an external risk process
+// that maps the file read-only - copy a whole record or retry, and never block the
+// writer.
+//
+// Durability: the file is MAP_SHARED, so a record survives the process (crash, kill,
+// restart) as soon as it is written; it reaches the disk when the kernel writes the
+// page back, not on every store. Unlike the telemetry segment the file is kept on exit.
+//
+// SymbolRegistry IDs are assigned per process, so open() re-keys the records of the
+// previous run by symbol name before any engine writes its slot.
+//
+// Until open() succeeds every write lands in a private in-process copy.
+enum class OrderSlotState : uint8_t {
+    EMPTY,          // No order, no position
+    PENDING,        // Entry sent, not acknowledged yet
+    WORKING,        // Entry resting on the book
+    POSITION,       // Entry filled (exit_order_link_id: the resting take-profit, if any)
+    CLOSING         // Closing order sent (order_link_id)
+};
+
+const char* order_slot_state_name(OrderSlotState state);
+
+// The record of one slot (POD, copied whole in and out)
+struct OpenOrder {
+    char symbol[32];
+    char order_link_id[40];         // NUL-terminated (Bybit orderLinkId: max 36)
+    char exit_order_link_id[40];
+    int64_t entry_price_ticks;      // Order price, then the average fill price
+    int64_t qty_lots;               // Order size
+    int64_t position_lots;          // Filled and not yet closed
+    DecimalStep tick;               // Grid of the ticks/lots above, to detect a changed grid
+    DecimalStep lot;
+    int64_t updated_unix_ns;
+    int32_t martingale_step;
+    uint8_t is_short;
+    OrderSlotState state;
+};
+
+struct alignas(64) OrderSlot {
+    std::atomic<uint64_t> version;  // Seqlock: odd while the engine writes
+    OpenOrder order;
+};
+
+struct OrderTableHeader {
+    uint64_t magic;
+    uint32_t version;
+    uint32_t max_symbols;
+    int32_t pid;                    // Last process that opened the table for writing
+    int64_t opened_unix_ns;
+    std::atomic<uint32_t> symbol_limit;     // Slots [0, symbol_limit) may be in use
+};
+
+class OrderStateTable {
+public:
+    static constexpr uint64_t MAGIC = 0x4C42545244524F42ull;   // "BORDRTBL"
+    static constexpr uint32_t VERSION = 2;          // 2: OpenOrder::position_lots
+    static constexpr uint32_t MAX_SYMBOLS = SymbolRegistry::MAX_SYMBOLS;
+    static constexpr int READ_ATTEMPTS = 1000;      // Then the writer is presumed dead mid-write
+
+    struct Layout {
+        OrderTableHeader header;
+        alignas(64) std::array<OrderSlot, MAX_SYMBOLS> slots;
+    };
+
+    static OrderStateTable& get_instance() {
+        static OrderStateTable instance;
+        return instance;
+    }
+
+    // Maps the table, creating it if missing. An existing table of this version keeps
+    // its records (re-keyed to this process's symbol IDs); anything else is
+    // reinitialised. Fails if another process holds the table. Call before the engines
+    // are built.
+    bool open(const std::string& path);
+    bool is_open() const { return mapped_ != nullptr; }
+    const std::string& path() const { return path_; }
+
+    // Writer (the symbol's engine thread only)
+    void store(uint32_t symbol_id, const OpenOrder& order);
+    void clear(uint32_t symbol_id);
+
+    // Any thread. False if the slot is empty (or stays torn for READ_ATTEMPTS).
+    bool load(uint32_t symbol_id, OpenOrder& out) const;
+
+    // Reader side: read-only mapping of a running (or stopped) bot's table, nullptr if it
+    // is not a table of this version. Unmap with unmap().
+    static const Layout* map_readonly(const std::string& path);
+    static void unmap(const Layout* layout);
+    static bool load(const Layout& layout, uint32_t symbol_id, OpenOrder& out);
+
+private:
+    OrderStateTable();
+    ~OrderStateTable();
+
+    std::unique_ptr<Layout> local_;         // Until open()
+    Layout* layout_;
+    void* mapped_ = nullptr;
+    int fd_ = -1;                           // Held open for the lock
+    std::string path_;
+
+    void rekey(Layout& layout);
+};
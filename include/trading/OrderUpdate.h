@@ -0,0 +1,88 @@
+#pragma once
+#include <cstdint>
+#include <string_view>
+#include "trading/ClientOrderId.h"
+#include "utils/DecimalParser.h"
+
+// Bybit v5 orderStatus
+enum class OrderStatus : uint8_t {
+    UNKNOWN,
+    NEW,
+    PARTIALLY_FILLED,
+    FILLED,
+    CANCELLED,
+    PARTIALLY_FILLED_CANCELLED,     // Remainder of a partial fill cancelled
+    REJECTED,
+    UNTRIGGERED,
+    TRIGGERED,
+    DEACTIVATED
+};
+
+// From the exchange string (a simdjson string_view); UNKNOWN for anything else
+inline OrderStatus parse_order_status(std::string_view status) {
+    switch (status.empty() ? '\0' : status[0]) {
+        case 'N': if (status == "New") return OrderStatus::NEW; break;
+        case 'F': if (status == "Filled") return OrderStatus::FILLED; break;
+        case 'C': if (status == "Cancelled") return OrderStatus::CANCELLED; break;
+        case 'R': if (status == "Rejected") return OrderStatus::REJECTED; break;
+        case 'U': if (status == "Untriggered") return OrderStatus::UNTRIGGERED; break;
+        case 'T': if (status == "Triggered") return OrderStatus::TRIGGERED; break;
+        case 'D': if (status == "Deactivated") return OrderStatus::DEACTIVATED; break;
+        case 'P':
+            if (status == "PartiallyFilled") return OrderStatus::PARTIALLY_FILLED;
+            if (status == "PartiallyFilledCanceled") return OrderStatus::PARTIALLY_FILLED_CANCELLED;
+            break;
+        default: break;
+    }
+    return OrderStatus::UNKNOWN;
+}
+
+inline const char* order_status_name(OrderStatus status) {
+    switch (status) {
+        case OrderStatus::UNKNOWN:                    return "Unknown";
+        case OrderStatus::NEW:                        return "New";
+        case OrderStatus::PARTIALLY_FILLED:           return "PartiallyFilled";
+        case OrderStatus::FILLED:                     return "Filled";
+        case OrderStatus::CANCELLED:                  return "Cancelled";
+        case OrderStatus::PARTIALLY_FILLED_CANCELLED: return "PartiallyFilledCanceled";
+        case OrderStatus::REJECTED:                   return "Rejected";
+        case OrderStatus::UNTRIGGERED:                return "Untriggered";
+        case OrderStatus::TRIGGERED:                  return "Triggered";
+        case OrderStatus::DEACTIVATED:                return "Deactivated";
+    }
+    return "Unknown";
+}
+
+// What happened to one of our orders, as the engine acts on it
+enum class OrderEventType : uint8_t {
+    ACK,            // Accepted and resting (New)
+    PARTIAL_FILL,   // One execution, more quantity left (exec_qty at exec_price)
+    FILL,           // Last execution: the order is complete
+    CANCEL,         // Cancelled / deactivated, possibly after partial fills
+    REJECT
+};
+
+inline const char* order_event_name(OrderEventType type) {
+    switch (type) {
+        case OrderEventType::ACK:          return "Ack";
+        case OrderEventType::PARTIAL_FILL: return "PartialFill";
+        case OrderEventType::FILL:         return "Fill";
+        case OrderEventType::CANCEL:       return "Cancel";
+        case OrderEventType::REJECT:       return "Reject";
+    }
+    return "Unknown";
+}
+
+// One event on one of our orders, as the private channels hand it to the engines.
+// Trivially copyable; `symbol` points into the decoder's buffer and is only valid
+// during the callback.
+struct OrderUpdate {
+    ClientOrderId id;               // Decoded orderLinkId
+    OrderEventType type = OrderEventType::ACK;
+    OrderStatus status = OrderStatus::UNKNOWN;  // orderStatus of order-topic records
+    Decimal exec_qty;               // Fills: this execution (execQty / execPrice)
+    Decimal exec_price;
+    uint64_t exec_id = 0;           // Fills: hash of execId, so a repeated report is dropped (0 = none)
+    std::string_view symbol;        // Empty if the report does not say (order.create rejects)
+    uint64_t rx_tick = 0;           // tsc::now() when the frame was decoded
+};
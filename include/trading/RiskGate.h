@@ -0,0 +1,108 @@
+#pragma once
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include "core/Instrument.h"
+#include "core/SymbolRegistry.h"
+
+// Pre-trade limits (BotConfiguration::risk_limits). A rate <= 0, a notional <= 0 or a
+// negative step cap disables that check. The exposure caps are off by default, so the
+// martingale doubles as far as it always did; set them to bound it.
+struct RiskLimits {
+    int global_orders_per_second = 10;      // Every request on the trade connection
+    int global_burst = 10;
+    int symbol_orders_per_second = 5;
+    int symbol_burst = 5;
+    int reduce_reserve = 1;                 // Tokens of each bucket only REDUCE / CANCEL may spend
+    double max_order_notional = 0.0;        // Quote currency (USDT)
+    double max_position_notional = 0.0;     // |position after the order| * price
+    int max_martingale_steps = -1;          // Entries beyond this doubling step are refused
+};
+
+// What the order does to our exposure. Only OPEN orders are checked against the
+// exposure limits; reducing orders and cancels (stop losses, chases) only spend rate,
+// since refusing them can only make things worse.
+enum class OrderIntent : uint8_t {
+    OPEN,
+    REDUCE,
+    CANCEL
+};
+
+enum class RiskVerdict : uint8_t {
+    PASS,
+    MARTINGALE_LIMIT,
+    ORDER_NOTIONAL,
+    POSITION_LIMIT,
+    SYMBOL_RATE,
+    GLOBAL_RATE,
+    COUNT
+};
+
+const char* risk_verdict_name(RiskVerdict verdict);
+
+// Shared pre-trade gate, inline on every engine's send path.
+//
+// Rates are token buckets in GCRA form: one atomic "theoretical arrival time" per bucket
+// (TSC ticks). An order is admitted if the bucket's TAT is at most burst - 1 intervals
+// ahead of now, and takes one interval with a single CAS - no mutex, no refill timer,
+// and engines on any worker thread share the global bucket. Limits are plain loads.
+// A check is a few compares and at most two CASes: tens of nanoseconds.
+//
+// Buckets only fill when every other check passed; a symbol token is handed back if
+// the global bucket then refuses the order. OPEN orders stop reduce_reserve tokens short
+// of the burst, so entries cannot starve stop losses and cancels of any engine.
+class RiskGate {
+public:
+    static RiskGate& get_instance() {
+        static RiskGate instance;
+        return instance;
+    }
+
+    // Cold path, before any engine sends (needs the TSC calibration)
+    void configure(const RiskLimits& limits);
+    const RiskLimits& limits() const { return limits_; }
+
+    // Engine thread, right before the request is written. position_lots is signed
+    // (negative = short), prices in ticks and sizes in lots of the instrument.
+    RiskVerdict check(uint32_t symbol_id, const InstrumentSpec& instrument, OrderIntent intent,
+                      bool is_buy, int64_t qty_lots, int64_t price_ticks, int64_t position_lots,
+                      int martingale_step);
+
+    uint64_t get_passed() const { return passed_.load(std::memory_order_relaxed); }
+    uint64_t get_rejected(RiskVerdict verdict) const {
+        return rejected_[static_cast<size_t>(verdict)].load(std::memory_order_relaxed);
+    }
+    uint64_t get_rejected_total() const;
+
+private:
+    RiskGate() = default;
+
+    static constexpr uint32_t MAX_SYMBOLS = SymbolRegistry::MAX_SYMBOLS;
+
+    struct alignas(64) Bucket {
+        std::atomic<uint64_t> tat{0};
+    };
+
+    // Interval between orders and how far ahead of now the TAT may run, in TSC ticks
+    // (open_tolerance for OPEN orders: the reserve is kept back); interval 0 = unlimited
+    struct Rate {
+        uint64_t interval = 0;
+        uint64_t tolerance = 0;
+        uint64_t open_tolerance = 0;
+    };
+
+    RiskLimits limits_;
+    Rate global_rate_;
+    Rate symbol_rate_;
+    Bucket global_;
+    std::array<Bucket, MAX_SYMBOLS> symbols_{};
+
+    std::atomic<uint64_t> passed_{0};
+    std::array<std::atomic<uint64_t>, static_cast<size_t>(RiskVerdict::COUNT)> rejected_{};
+
+    static Rate make_rate(int per_second, int burst, int reserve);
+    static bool take(Bucket& bucket, const Rate& rate, uint64_t tolerance, uint64_t now);
+    static void give_back(Bucket& bucket, const Rate& rate);
+    RiskVerdict reject(RiskVerdict verdict);
+};
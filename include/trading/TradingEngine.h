@@ -1,16 +1,26 @@
 #ifndef TRADING_ENGINE_H
 #define TRADING_ENGINE_H
 
+#include <array>
 #include <string>
 #include <atomic>
 #include <chrono>
 #include <memory>
+#include <string_view>
 #include "core/OrderBookManager.h"
 #include "core/SymbolManager.h"
 #include "network/BybitWebSocketClient.h"
 #include "utils/DataLogger.h"
 #include "messaging/AeronPublisher.h"
 #include "messaging/SBEEncoder.h"
+#include "utils/EngineClock.h"
+#include "utils/Doorbell.h"
+#include "utils/MpscRing.h"
+#include "trading/ClientOrderId.h"
+#include "trading/EngineEvent.h"
+#include "trading/OrderStateTable.h"
+#include "trading/RiskGate.h"
+#include "utils/TelemetrySegment.h"
 
 enum class BotState {
     IDLE,
@@ -29,15 +39,42 @@ public:
         SymbolManager& sm,
         DataLogger& logger,
         BybitWebSocketClient* trade_client,
-        std::shared_ptr<AeronPublisher> aeron_pub
+        std::shared_ptr<AeronPublisher> aeron_pub,
+        uint16_t engine_id = 0,         // Scheduler slot, encoded into our order IDs
+        const SignalParams& signal_params = SignalParams{},
+        bool entry_at_microprice = false   // Entry anchor: mid (default) or microprice
     );
 
+    const std::string& get_symbol() const { return symbol_; }
+    uint32_t get_symbol_id() const { return symbol_id_; }
+
+    // Startup (before the engine is scheduled): valid top of book available?
+    bool market_data_ready();
+
     void run_trading_cycle();
-    void on_order_update(const std::string& order_id, const std::string& status);
+
+    // Thread-safe (any thread): queue an execution report for the engine thread, applied
+    // in order at the start of the next run_trading_cycle(). Does not wake the engine:
+    // the caller (EngineScheduler) rings the doorbell once per batch.
+    void enqueue_order_update(const OrderUpdate& update);
+
+    // Any thread: book changed or inbox non-empty (scheduler readiness check)
+    bool has_pending_event() const;
 
 private:
+    // Engine thread only (applied from the inbox)
+    void on_order_update(const EngineEvent& event);
+    void apply_entry_fill(int64_t lots, int64_t price);
+    bool is_duplicate_execution(uint64_t exec_id);      // Remembers it otherwise
+    void on_entry_filled();
+    void post_exit_order();             // Take profit for the position held
+    void schedule_exit_retry();
+    void on_position_closed();
+
     // Core components
     std::string symbol_;
+    uint32_t symbol_id_;   // SymbolRegistry ID: lock-free book/subscription lookups
+    InstrumentSpec instrument_;     // Tick/lot grid of every price/qty below
     OrderBookManager& orderbook_manager_;
     SymbolManager& symbol_manager_;
     DataLogger& logger_;
@@ -45,28 +82,52 @@ private:
     std::shared_ptr<AeronPublisher> aeron_publisher_;
     SBEEncoder sbe_encoder_;
 
-    // State management
-    std::atomic<BotState> current_state_{BotState::IDLE};
+    // Execution reports from the private channels' service threads
+    static constexpr size_t INBOX_CAPACITY = 1024;
+    MpscRing<EngineEvent, INBOX_CAPACITY> inbox_;
+    std::atomic<uint64_t> inbox_full_waits_{0};      // Exported as telemetry inbox_full_waits
+
+    // State management - engine thread only (other threads go through the inbox)
+    BotState current_state_ = BotState::IDLE;
     std::chrono::steady_clock::time_point state_entry_time_;
     std::chrono::steady_clock::time_point position_entry_time_;
     std::chrono::steady_clock::time_point last_status_log_;
-
-    std::string active_exit_order_id_;
-
-    // Order tracking
-    std::string active_order_id_;
-    double active_order_price_ = 0.0;
-    double entry_price_ = 0.0;
+    // Throttles of validate_market_data()'s warnings, per engine (engines share workers)
+    std::chrono::steady_clock::time_point last_resync_log_;
+    std::chrono::steady_clock::time_point last_empty_log_;
+    std::chrono::steady_clock::time_point last_crossed_log_;
+
+    ClientOrderId active_exit_order_id_;
+    // Take profit still to post: the gate refused it or a restart lost it. An exchange
+    // cancel (a PostOnly that would cross) is not re-sent. Retries back off exponentially.
+    bool exit_repost_pending_ = false;
+    int exit_retry_ms_ = 0;
+    std::chrono::steady_clock::time_point next_exit_retry_;
+
+    // Order tracking (prices in ticks)
+    uint16_t engine_id_;
+    uint64_t order_sequence_;           // Last ClientOrderId sequence used
+    ClientOrderId active_order_id_;
+    int64_t active_order_price_ = 0;
+    int64_t entry_price_ = 0;           // Volume-weighted over the entry's fills
+    int64_t position_lots_ = 0;         // Filled and not yet closed
     bool is_short_ = false;
     bool position_filled_ = false;
     bool waiting_for_close_ = false;
+    uint64_t order_sent_tick_ = 0;      // Last order queued for sending, until its first report
+
+    // execIds of the latest executions: a report delivered twice is applied once
+    static constexpr size_t RECENT_EXECUTIONS = 32;
+    std::array<uint64_t, RECENT_EXECUTIONS> recent_exec_ids_{};
+    size_t next_exec_slot_ = 0;
 
+    // This symbol's slot of the telemetry segment (engine is its only writer)
+    telemetry::SymbolCounters* telemetry_;
 
-    // Risk parameters
-    double base_quantity_;
-    double current_qty_;
+    // Risk parameters (quantities in lots)
+    int64_t base_quantity_;
+    int64_t current_qty_;
     int martingale_step_;
-    int max_martingale_steps_;
     double profit_target_percent_;
     double stop_loss_percent_;
     double cumulative_loss_;
@@ -81,13 +142,27 @@ private:
     // [NEW] Orderbook staleness detection
     uint64_t last_orderbook_update_ = 0;
 
+    // Book features as of the last entry decision (one struct copy from the book)
+    BookSignals signals_;
+    bool entry_at_microprice_;
+
+    // Strategy price offsets, converted to ticks of the instrument once
+    int64_t entry_offset_ticks_;        // Distance from mid for maker entries
+    int64_t chase_threshold_ticks_;     // How far the market may run before we chase
+    int64_t exit_slippage_ticks_;       // Aggressive limit for closing orders
+
     // Constants
     static constexpr int ORDER_TIMEOUT_MS = 5000;
+    static constexpr int EXIT_RETRY_MIN_MS = 250;
+    static constexpr int EXIT_RETRY_MAX_MS = 8000;
     bool trigger_martingale_on_close_ = false;
+    RiskVerdict last_risk_verdict_ = RiskVerdict::PASS;
 
     bool is_averaging_ = false; // Track if we are adding to a position
 
     // Private methods
+    void push_event(const EngineEvent& event);
+    void drain_inbox();
     bool validate_market_data();
     void evaluate_entry_signal();
     void monitor_working_order();
@@ -98,13 +173,28 @@ private:
     void close_position_with_profit();
     void close_position_with_loss();
     void close_position_and_reset();
-    void execute_average_down(double current_market_price);
+    void execute_average_down(int64_t current_market_price);
     
-    void place_order(double price, bool is_short,bool is_maker);
+    bool place_order(int64_t price, bool is_short,bool is_maker);     // False if not sent
+    RiskVerdict risk_check(OrderIntent intent, bool is_buy, int64_t qty_lots, int64_t price_ticks);
+
+    // Hot-path latency stamps (LatencyRecorder) around book-driven sends
+    struct DecisionStamp {
+        uint64_t tick = 0;
+        uint64_t book_rx_tick = 0;
+        uint64_t book_applied_tick = 0;
+    };
+    DecisionStamp stamp_decision() const;
+    void record_send_latency(const DecisionStamp& decision, uint64_t sent_tick);
+    void note_order_sent(uint64_t sent_tick);
+    void record_round_trip(uint64_t report_tick);
+    void publish_telemetry();
+    // This symbol's OrderStateTable slot, rewritten on every order/position transition
+    void persist_order_state(OrderSlotState state);
     void handle_timeout();
     void reconcile_state_on_startup();
     
-    std::string generate_id();
+    ClientOrderId next_order_id();
     void print_statistics();
     void log_status();
 };
@@ -0,0 +1,10 @@
+#pragma once
+#include <cstdint>
+
+// Counts heap allocations made by the calling thread.
+// AllocationCounter.cpp replaces the global operator new, so every allocation in the
+// process bumps a thread-local counter (one TLS increment, no locks). Hot paths sample
+// the counter before and after their work to prove they did not allocate.
+namespace alloc_counter {
+    uint64_t thread_allocations();
+}
@@ -0,0 +1,11 @@
+#pragma once
+
+// Spin-wait hint for busy loops (seqlock retries, ring buffers, spin waits).
+// Tells the core we are spinning so it can back off the pipeline / SMT sibling.
+inline void cpu_pause() {
+#if defined(__x86_64__) || defined(__i386__)
+    __builtin_ia32_pause();
+#elif defined(__aarch64__)
+    __asm__ __volatile__("yield");
+#endif
+}
@@ -1,32 +1,114 @@
 #pragma once
 #include <string>
-#include <fstream>
+#include <string_view>
 #include <mutex>
 #include <vector>
+#include <array>
+#include <atomic>
+#include <memory>
+#include <thread>
 #include <cstdint>
+#include "utils/SpscByteRing.h"
+#include "utils/ThreadAffinity.h"
 
+// What a producer does when its ring has no space left
+enum class LogFullPolicy {
+    DROP,       // Discard the record (counted in get_dropped_count())
+    BLOCK,      // Spin until the writer frees space
+    SAMPLE      // Under pressure (ring > half full) keep 1 record in sample_every, drop when full
+};
+
+struct AsyncLogOptions {
+    size_t ring_bytes = 4 * 1024 * 1024;    // Per producer thread
+    LogFullPolicy full_policy = LogFullPolicy::DROP;
+    uint32_t sample_every = 16;
+    bool direct_io = false;                 // O_DIRECT with block-aligned batches
+    ThreadPlacement writer{};               // Writer thread (keep it off the hot cores)
+};
+
+// Asynchronous journal.
+// Producers copy a binary record {monotonic ns, tag, message} into their own SPSC ring
+// (no lock, no syscall, no formatting). A background writer drains every ring, renders
+// the records into the usual "[HH:MM:SS] [TAG] message" text and writes them in batches.
 class DataLogger {
 public:
-    explicit DataLogger(const std::string& filename = "trading_data.log");
+    explicit DataLogger(const std::string& filename = "trading_data.log",
+                        const AsyncLogOptions& options = {});
     ~DataLogger();
-    
+
     void log_orderbook(
         const std::string& symbol,
         double mid_price,
         const std::vector<std::pair<double, double>>& bids,
         const std::vector<std::pair<double, double>>& asks
     );
-    void log(const std::string& tag, const std::string& message);
-    
+    void log(std::string_view tag, std::string_view message);
+
     void log_symbol_subscription(const std::vector<std::string>& symbols);
     void log_statistics(uint64_t messages, uint64_t aeron_published, size_t active_symbols);
     void log_error(const std::string& error_message);
     std::string get_log_path() const;
 
+    uint64_t get_dropped_count() const { return dropped_.load(std::memory_order_relaxed); }
+    uint64_t get_written_bytes() const { return written_bytes_.load(std::memory_order_relaxed); }
+
 private:
-    std::ofstream log_file;
-    mutable std::mutex log_mutex;
+    static constexpr size_t MAX_PRODUCERS = 64;
+    static constexpr size_t BATCH_BYTES = 1024 * 1024;
+    static constexpr size_t DIRECT_IO_ALIGN = 4096;
+
+    // Record flags
+    static constexpr uint16_t RECORD_TAGGED = 0;     // Rendered as "[ts] [tag] message\n"
+    static constexpr uint16_t RECORD_RAW = 1;        // Message written verbatim (preformatted)
+
+    struct RecordHeader {
+        int64_t mono_ns;
+        uint16_t flags;
+        uint16_t tag_len;
+        uint32_t message_len;
+    };
+
+    struct Producer {
+        explicit Producer(size_t bytes) : ring(bytes) {}
+        SpscByteRing ring;
+        std::thread::id owner = std::this_thread::get_id();
+        uint64_t sample_counter = 0;
+    };
+
+    AsyncLogOptions options_;
     std::string log_file_path;
-    
+    int fd_ = -1;
+    uint64_t logger_id_;
+
+    // Rings are registered once per thread (cold, under the mutex) and never removed
+    std::mutex register_mutex_;
+    std::vector<std::unique_ptr<Producer>> producer_storage_;
+    std::array<std::atomic<Producer*>, MAX_PRODUCERS> producers_{};
+    std::atomic<size_t> producer_count_{0};
+
+    std::thread writer_thread_;
+    std::atomic<bool> running_{false};
+    std::atomic<uint64_t> dropped_{0};
+    std::atomic<uint64_t> written_bytes_{0};
+
+    // Writer-thread state
+    char* batch_ = nullptr;
+    size_t batch_len_ = 0;
+    uint64_t file_offset_ = 0;
+    int64_t wall_minus_mono_ns_ = 0;
+    int64_t cached_second_ = -1;
+    char cached_ts_[16];
+    size_t cached_ts_len_ = 0;
+
+    Producer* producer_for_this_thread();
+    void push(uint16_t flags, std::string_view tag, std::string_view message);
+
+    void writer_loop();
+    size_t drain_all();
+    void render(const char* record, uint32_t len);
+    void append_batch(const char* data, size_t len);
+    void flush_batch(bool final_block);
+
     std::string get_timestamp() const;
-};
\ No newline at end of file
+    static int64_t monotonic_ns();
+};
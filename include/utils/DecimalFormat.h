@@ -0,0 +1,58 @@
+#pragma once
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+
+// Allocation-free decimal formatting (the inverse of DecimalParser.h).
+// Values are fixed-point: an integer mantissa plus a number of fractional digits,
+// so "65000.10" is {6500010, 2}. No locale, no iostream, no rounding surprises.
+
+inline constexpr uint64_t POW10[] = {
+    1ull, 10ull, 100ull, 1000ull, 10000ull, 100000ull, 1000000ull, 10000000ull,
+    100000000ull, 1000000000ull, 10000000000ull, 100000000000ull, 1000000000000ull,
+    10000000000000ull, 100000000000000ull, 1000000000000000ull, 10000000000000000ull,
+    100000000000000000ull, 1000000000000000000ull
+};
+inline constexpr int MAX_FORMAT_DECIMALS = 12;
+
+// Writes the digits of v; returns the number of chars written (at most 20)
+inline size_t format_uint(char* out, uint64_t v) {
+    char tmp[20];
+    size_t n = 0;
+    do {
+        tmp[n++] = static_cast<char>('0' + v % 10);
+        v /= 10;
+    } while (v);
+    for (size_t i = 0; i < n; i++) out[i] = tmp[n - 1 - i];
+    return n;
+}
+
+// Writes exactly `width` digits of v, zero-padded (for fixed-width, patchable fields)
+inline void format_uint_fixed(char* out, uint64_t v, size_t width) {
+    for (size_t i = width; i > 0; i--) {
+        out[i - 1] = static_cast<char>('0' + v % 10);
+        v /= 10;
+    }
+}
+
+// Writes mantissa / 10^decimals with exactly `decimals` fractional digits
+inline size_t format_fixed(char* out, uint64_t mantissa, int decimals) {
+    if (decimals <= 0) return format_uint(out, mantissa);
+
+    uint64_t scale = POW10[decimals];
+    size_t n = format_uint(out, mantissa / scale);
+    out[n++] = '.';
+    format_uint_fixed(out + n, mantissa % scale, static_cast<size_t>(decimals));
+    return n + static_cast<size_t>(decimals);
+}
+
+// An exchange increment (tick size / qty step) as a fixed-point value
+struct DecimalStep {
+    uint64_t mantissa = 1;
+    int decimals = 5;
+
+    // Number of whole steps nearest to value
+    int64_t units(double value) const {
+        return std::llround(value * static_cast<double>(POW10[decimals]) / static_cast<double>(mantissa));
+    }
+};
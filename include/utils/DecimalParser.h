@@ -0,0 +1,55 @@
+#pragma once
+#include <cstdint>
+#include <string_view>
+
+// Allocation-free parsing of Bybit decimal strings ("43250.50", "0.006").
+// The digits are accumulated as an integer mantissa plus a decimal scale,
+// so no std::string is built and no locale-aware strtod is called.
+struct Decimal {
+    uint64_t mantissa = 0;  // All digits, decimal point removed
+    int scale = 0;          // Number of fractional digits
+};
+
+// Parses an unsigned decimal. Returns false on an empty string, a stray character,
+// or more than 19 significant digits (would overflow the mantissa).
+inline bool parse_decimal(std::string_view str, Decimal& out) {
+    uint64_t mantissa = 0;
+    int scale = 0;
+    int digits = 0;
+    bool seen_point = false;
+
+    for (char c : str) {
+        if (c >= '0' && c <= '9') {
+            if (digits == 19) return false;
+            mantissa = mantissa * 10 + static_cast<uint64_t>(c - '0');
+            if (mantissa != 0) digits++;
+            if (seen_point) scale++;
+        } else if (c == '.' && !seen_point) {
+            seen_point = true;
+        } else {
+            return false;
+        }
+    }
+
+    if (str.empty() || (seen_point && str.size() == 1)) return false;
+    out.mantissa = mantissa;
+    out.scale = scale;
+    return true;
+}
+
+// Exact for mantissas below 2^53 (every price/qty Bybit sends): one IEEE division
+// of two exactly representable values is correctly rounded, same result as std::stod.
+inline double decimal_to_double(const Decimal& d) {
+    static constexpr double POW10[] = {
+        1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10,
+        1e11, 1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19
+    };
+    return static_cast<double>(d.mantissa) / POW10[d.scale];
+}
+
+inline bool parse_double(std::string_view str, double& out) {
+    Decimal d;
+    if (!parse_decimal(str, d) || d.scale > 19) return false;
+    out = decimal_to_double(d);
+    return true;
+}
@@ -0,0 +1,90 @@
+#pragma once
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <thread>
+#include "utils/CpuPause.h"
+
+#ifdef __linux__
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#include <ctime>
+#endif
+
+// How a consumer waits for its doorbell
+enum class WaitMode {
+    SPIN,       // Busy-poll (pin the thread to an isolated core)
+    BLOCK,      // Sleep in the kernel (futex) until rung or timed out
+    SLEEP       // Legacy fixed 500us sleep between checks
+};
+
+// Futex-backed wakeup counter. Producers ring() after publishing work; consumers read
+// sequence(), check for work, then wait(seen, ...) until the sequence moves.
+// ring() only makes a syscall when a consumer is actually blocked in the kernel.
+class Doorbell {
+public:
+    uint32_t sequence() const { return seq_.load(std::memory_order_acquire); }
+
+    void ring() {
+        seq_.fetch_add(1, std::memory_order_seq_cst);
+        if (sleepers_.load(std::memory_order_seq_cst) != 0) wake_all();
+    }
+
+    // Returns as soon as the sequence differs from `seen` (true) or at the timeout (false)
+    bool wait(uint32_t seen, WaitMode mode, std::chrono::microseconds timeout) {
+        auto deadline = std::chrono::steady_clock::now() + timeout;
+
+        switch (mode) {
+            case WaitMode::SPIN:
+                while (seq_.load(std::memory_order_acquire) == seen) {
+                    if (std::chrono::steady_clock::now() >= deadline) return false;
+                    for (int i = 0; i < 64; i++) cpu_pause();
+                }
+                return true;
+
+            case WaitMode::SLEEP:
+                std::this_thread::sleep_for(std::chrono::microseconds(500));
+                return seq_.load(std::memory_order_acquire) != seen;
+
+            case WaitMode::BLOCK:
+                break;
+        }
+
+        sleepers_.fetch_add(1, std::memory_order_seq_cst);
+        while (seq_.load(std::memory_order_seq_cst) == seen) {
+            auto remaining = deadline - std::chrono::steady_clock::now();
+            if (remaining <= std::chrono::nanoseconds(0)) break;
+            block(seen, std::chrono::duration_cast<std::chrono::nanoseconds>(remaining));
+        }
+        sleepers_.fetch_sub(1, std::memory_order_seq_cst);
+        return seq_.load(std::memory_order_acquire) != seen;
+    }
+
+private:
+    alignas(64) std::atomic<uint32_t> seq_{0};
+    std::atomic<uint32_t> sleepers_{0};
+
+#ifdef __linux__
+    // The kernel re-checks seq_ == seen atomically, so a ring() between our load and
+    // the syscall is never lost.
+    void block(uint32_t seen, std::chrono::nanoseconds timeout) {
+        struct timespec ts;
+        ts.tv_sec = static_cast<time_t>(timeout.count() / 1000000000);
+        ts.tv_nsec = static_cast<long>(timeout.count() % 1000000000);
+        syscall(SYS_futex, reinterpret_cast<uint32_t*>(&seq_), FUTEX_WAIT_PRIVATE, seen, &ts, nullptr, 0);
+    }
+
+    void wake_all() {
+        syscall(SYS_futex, reinterpret_cast<uint32_t*>(&seq_), FUTEX_WAKE_PRIVATE, INT32_MAX, nullptr, nullptr, 0);
+    }
+#else
+    // No futex: fall back to short sleeps (macOS development builds)
+    void block(uint32_t, std::chrono::nanoseconds timeout) {
+        std::this_thread::sleep_for(std::min<std::chrono::nanoseconds>(timeout, std::chrono::microseconds(50)));
+    }
+
+    void wake_all() {}
+#endif
+};
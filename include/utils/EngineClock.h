@@ -0,0 +1,26 @@
+#pragma once
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+
+// Time source for strategy timers (order timeouts, status logging).
+// Live trading reads steady_clock; the replay driver pins the clock to the capture
+// timestamp of the frame being replayed, so timeouts fire at the same point of the
+// recorded feed whatever the replay speed.
+namespace engine_clock {
+
+using time_point = std::chrono::steady_clock::time_point;
+
+inline constexpr int64_t LIVE = -1;
+inline std::atomic<int64_t> replay_time_ns{LIVE};
+
+inline time_point now() {
+    int64_t replay_ns = replay_time_ns.load(std::memory_order_relaxed);
+    if (replay_ns == LIVE) return std::chrono::steady_clock::now();
+    return time_point(std::chrono::nanoseconds(replay_ns));
+}
+
+inline void set_replay_time(int64_t ns) { replay_time_ns.store(ns, std::memory_order_relaxed); }
+inline void clear_replay_time() { replay_time_ns.store(LIVE, std::memory_order_relaxed); }
+
+} // namespace engine_clock
@@ -0,0 +1,158 @@
+#pragma once
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include "core/SymbolRegistry.h"
+#include "utils/Tsc.h"
+
+// Log-linear (HDR-style) latency histogram in nanoseconds.
+// Values below 2^SubBits land in exact buckets; above that every power of two is split
+// into 2^(SubBits-1) linear buckets, so the relative error stays under 2^-(SubBits-1)
+// across the whole range (clamped at 2^36ns, ~68s).
+//
+// THREADING: lock-free. record() is a relaxed fetch_add per field, so any number of
+// threads may record; readers see slightly torn totals, never lost counts.
+template <unsigned SubBits>
+class LatencyHistogram {
+public:
+    static constexpr unsigned MAX_BITS = 36;
+    static constexpr uint64_t SUB = 1ull << SubBits;
+    static constexpr uint64_t HALF = SUB / 2;
+    static constexpr size_t BUCKETS = SUB + (MAX_BITS - SubBits) * HALF;
+
+    void record(uint64_t ns) {
+        counts_[bucket_of(ns)].fetch_add(1, std::memory_order_relaxed);
+        count_.fetch_add(1, std::memory_order_relaxed);
+        sum_.fetch_add(ns, std::memory_order_relaxed);
+        uint64_t max = max_.load(std::memory_order_relaxed);
+        while (ns > max && !max_.compare_exchange_weak(max, ns, std::memory_order_relaxed)) {}
+    }
+
+    uint64_t count() const { return count_.load(std::memory_order_relaxed); }
+    uint64_t max() const { return max_.load(std::memory_order_relaxed); }
+    uint64_t mean() const {
+        uint64_t n = count();
+        return n ? sum_.load(std::memory_order_relaxed) / n : 0;
+    }
+
+    // Upper bound of the bucket holding the p-th percentile (0 < p <= 100)
+    uint64_t percentile(double p) const {
+        uint64_t total = 0;
+        for (const auto& c : counts_) total += c.load(std::memory_order_relaxed);
+        if (total == 0) return 0;
+
+        uint64_t rank = static_cast<uint64_t>(p / 100.0 * static_cast<double>(total) + 0.5);
+        if (rank == 0) rank = 1;
+        uint64_t seen = 0;
+        for (size_t i = 0; i < BUCKETS; i++) {
+            seen += counts_[i].load(std::memory_order_relaxed);
+            if (seen >= rank) return std::min(bucket_upper(i), max());
+        }
+        return max();
+    }
+
+private:
+    std::array<std::atomic<uint64_t>, BUCKETS> counts_{};
+    std::atomic<uint64_t> count_{0};
+    std::atomic<uint64_t> sum_{0};
+    std::atomic<uint64_t> max_{0};
+
+    static size_t bucket_of(uint64_t ns) {
+        if (ns < SUB) return static_cast<size_t>(ns);
+        if (ns >= (1ull << MAX_BITS)) return BUCKETS - 1;
+        unsigned msb = 63u - static_cast<unsigned>(__builtin_clzll(ns));
+        unsigned shift = msb - (SubBits - 1);                   // >= 1
+        return static_cast<size_t>(SUB + (shift - 1) * HALF + ((ns >> shift) - HALF));
+    }
+
+    static uint64_t bucket_upper(size_t i) {
+        if (i < SUB) return i;
+        size_t shift = (i - SUB) / HALF + 1;
+        uint64_t sub = (i - SUB) % HALF + HALF;
+        return ((sub + 1) << shift) - 1;
+    }
+};
+
+// Hot-path stages, stamped with tsc::now():
+//   lws receive callback -> simdjson decode -> book update -> engine decision -> send queue
+//   -> lws_write (service thread)
+enum class LatencyStage : uint8_t {
+    WIRE_TO_PARSE,          // Frame received -> levels decoded
+    PARSE_TO_BOOK,          // Levels decoded -> book updated
+    BOOK_TO_DECISION,       // Book updated -> engine decided to send an order
+    DECISION_TO_SEND,       // Decision -> request queued for the service thread
+    WIRE_TO_SEND,           // Frame received -> request queued (tick-to-trade, SEND_QUEUE aside)
+    MATCH_TO_PUSH,          // Exchange "cts" (matching engine) -> "ts" (feed push), ms resolution
+    PUSH_TO_WIRE,           // Exchange "ts" -> frame received (wall clocks), ms resolution
+    ORDER_UPDATE,           // Engine handling of one execution report
+    ORDER_ROUND_TRIP,       // Request queued -> first execution report received
+    SEND_QUEUE,             // Request queued -> lws_write returned on the service thread
+    COUNT
+};
+
+inline constexpr size_t LATENCY_STAGES = static_cast<size_t>(LatencyStage::COUNT);
+
+// Per-stage histograms for the whole process and per symbol.
+// Reported values are bucket upper bounds: process totals overstate by at most 1/32
+// (3.1%, SubBits 6), per-symbol ones by at most 1/8 (12.5%, SubBits 4) to stay small.
+// Per-symbol histograms only exist for symbols registered with prepare_symbol() (cold
+// path: the feed when it interns a topic, the engine when it is built). Recording for anything else
+// only updates the totals, so the hot path never allocates.
+class LatencyRecorder {
+public:
+    using TotalHistogram = LatencyHistogram<6>;
+    using SymbolHistogram = LatencyHistogram<4>;
+    struct SymbolStages {
+        std::array<SymbolHistogram, LATENCY_STAGES> stages;
+    };
+
+    static LatencyRecorder& get_instance() {
+        static LatencyRecorder instance;
+        return instance;
+    }
+
+    // BotConfiguration::latency_tracking; while disabled record() is one branch
+    void set_enabled(bool enabled) { enabled_.store(enabled, std::memory_order_relaxed); }
+    bool enabled() const { return enabled_.load(std::memory_order_relaxed); }
+
+    void prepare_symbol(uint32_t symbol_id);
+
+    void record(LatencyStage stage, uint32_t symbol_id, uint64_t ns) {
+        if (!enabled()) return;
+        size_t s = static_cast<size_t>(stage);
+        totals_[s].record(ns);
+        if (symbol_id < SymbolRegistry::MAX_SYMBOLS) {
+            SymbolStages* per = symbols_[symbol_id].load(std::memory_order_acquire);
+            if (per) per->stages[s].record(ns);
+        }
+    }
+
+    // Interval between two tsc::now() stamps (skipped if either is missing)
+    void record_ticks(LatencyStage stage, uint32_t symbol_id, uint64_t from_tick, uint64_t to_tick) {
+        if (from_tick == 0 || to_tick == 0) return;
+        record(stage, symbol_id, tsc::to_ns(from_tick, to_tick));
+    }
+
+    const TotalHistogram& total(LatencyStage stage) const { return totals_[static_cast<size_t>(stage)]; }
+    const SymbolStages* symbol(uint32_t symbol_id) const;
+
+    static const char* stage_name(LatencyStage stage);
+
+    // Machine-readable export: percentiles of every stage (and every symbol that
+    // recorded anything) as JSON, written to a temp file and renamed into place
+    bool write_json(const std::string& path) const;
+
+private:
+    LatencyRecorder() = default;
+
+    std::atomic<bool> enabled_{true};
+    std::array<TotalHistogram, LATENCY_STAGES> totals_{};
+    std::array<std::atomic<SymbolStages*>, SymbolRegistry::MAX_SYMBOLS> symbols_{};
+    std::array<std::unique_ptr<SymbolStages>, SymbolRegistry::MAX_SYMBOLS> owned_{};
+    std::mutex prepare_mutex_;
+};
@@ -0,0 +1,40 @@
+#pragma once
+#include <cstddef>
+
+// Backing for long-lived hot-path memory (book arena, journal rings).
+// With huge pages enabled a region is rounded up to 2MB and backed by explicit hugetlb
+// pages if the host reserved some (vm.nr_hugepages), else by transparent huge pages
+// (madvise); either way the hot path walks it with a fraction of the TLB misses.
+// Regions are zero-filled anonymous mappings, faulted in on first touch: the toucher's
+// NUMA policy decides the node (see prefer_node()).
+namespace memory_placement {
+    // Process-wide switch, set once at startup before the books and rings are allocated
+    void set_huge_pages(bool enabled);
+    bool huge_pages_enabled();
+
+    // Calling thread (and every thread it starts afterwards) allocates from `node` first,
+    // falling back to other nodes when it is full. node < 0 leaves the kernel default.
+    bool prefer_node(int node);
+}
+
+// One anonymous mapping, released with its owner. Move-only.
+class MappedRegion {
+public:
+    MappedRegion() = default;
+    explicit MappedRegion(size_t bytes);       // Throws std::bad_alloc if the mapping fails
+    ~MappedRegion();
+
+    MappedRegion(MappedRegion&& other) noexcept;
+    MappedRegion& operator=(MappedRegion&& other) noexcept;
+    MappedRegion(const MappedRegion&) = delete;
+    MappedRegion& operator=(const MappedRegion&) = delete;
+
+    char* data() const { return data_; }
+    size_t size() const { return size_; }       // Mapped size (rounded up)
+    bool huge() const { return huge_; }         // Explicit hugetlb pages
+
+private:
+    char* data_ = nullptr;
+    size_t size_ = 0;
+    bool huge_ = false;
+};
@@ -0,0 +1,77 @@
+#pragma once
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+// Bounded multi-producer / single-consumer ring of fixed-size POD entries.
+//
+// Each cell carries a sequence number (Vyukov's bounded queue): a producer claims a
+// slot with one CAS on the tail, copies the entry in and publishes it by bumping the
+// cell's sequence; the consumer never touches a shared counter, it just reads cells
+// in order. No locks, no allocation, entries are copied by value.
+template <typename T, size_t Capacity>
+class MpscRing {
+    static_assert((Capacity & (Capacity - 1)) == 0, "Capacity must be a power of two");
+    static_assert(std::is_trivially_copyable_v<T>, "MpscRing entries must be POD");
+
+public:
+    MpscRing() {
+        for (size_t i = 0; i < Capacity; i++) cells_[i].sequence.store(i, std::memory_order_relaxed);
+    }
+
+    // Any thread. False if the ring is full.
+    bool try_push(const T& value) {
+        uint64_t pos = tail_.load(std::memory_order_relaxed);
+        for (;;) {
+            Cell& cell = cells_[pos & MASK];
+            uint64_t seq = cell.sequence.load(std::memory_order_acquire);
+            int64_t diff = static_cast<int64_t>(seq) - static_cast<int64_t>(pos);
+
+            if (diff == 0) {
+                if (tail_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                    cell.value = value;
+                    cell.sequence.store(pos + 1, std::memory_order_release);
+                    return true;
+                }
+            } else if (diff < 0) {
+                return false;                                   // Full
+            } else {
+                pos = tail_.load(std::memory_order_relaxed);    // Lost the race, retry
+            }
+        }
+    }
+
+    // Consumer thread only. False if empty.
+    bool try_pop(T& out) {
+        uint64_t head = head_.load(std::memory_order_relaxed);
+        Cell& cell = cells_[head & MASK];
+        if (cell.sequence.load(std::memory_order_acquire) != head + 1) return false;
+
+        out = cell.value;
+        cell.sequence.store(head + Capacity, std::memory_order_release);
+        head_.store(head + 1, std::memory_order_relaxed);
+        return true;
+    }
+
+    // Any thread (a hint for everyone but the consumer)
+    bool empty() const {
+        uint64_t head = head_.load(std::memory_order_relaxed);
+        return cells_[head & MASK].sequence.load(std::memory_order_acquire) != head + 1;
+    }
+
+    static constexpr size_t capacity() { return Capacity; }
+
+private:
+    static constexpr size_t MASK = Capacity - 1;
+
+    struct Cell {
+        std::atomic<uint64_t> sequence;
+        T value;
+    };
+
+    alignas(64) std::atomic<uint64_t> tail_{0};     // Producers
+    alignas(64) std::atomic<uint64_t> head_{0};     // Consumer (atomic so empty() can peek)
+    alignas(64) std::array<Cell, Capacity> cells_;
+};
@@ -1,23 +1,47 @@
 #pragma once
-#include "network/BybitWebSocketClient.h"
+#include "network/FeedHandlerPool.h"
 #include "core/OrderBookManager.h"
+#include "config/BotConfiguration.h"
 #include "utils/DataLogger.h"
 #include <atomic>
+#include <vector>
 
+class EngineScheduler;
+class AeronPublisher;
+
+// Periodic reporting thread; nothing here touches the hot path.
+//  - Every BotConfiguration::telemetry_interval_ms it samples the counters the feed,
+//    books, Aeron and scheduler already keep into the shared-memory TelemetrySegment
+//    (relaxed stores) and stamps its heartbeat.
+//  - Every perf_report_interval_s it prints the LatencyRecorder stage percentiles (one
+//    line per stage that recorded anything), journals the feed counters and rewrites
+//    the JSON export (latency_export_path).
 class PerformanceMonitor {
 public:
     PerformanceMonitor(
-        BybitWebSocketClient& ws,
+        FeedHandlerPool& feed,
         OrderBookManager& obm,
-        DataLogger& logger
+        DataLogger& logger,
+        const BotConfiguration& config
     );
+
+    // Optional sources, before run()
+    void attach_scheduler(const EngineScheduler& scheduler) { scheduler_ = &scheduler; }
+    void attach_aeron(const AeronPublisher& publisher) { aeron_ = &publisher; }
+    void attach_private_client(const BybitWebSocketClient& client) { private_clients_.push_back(&client); }
     
     void run();
     void stop();
+    void report();      // One report now (also the final one at shutdown)
+    void sample_telemetry();
 
 private:
-    BybitWebSocketClient& ws_client_;
+    FeedHandlerPool& feed_pool_;
     OrderBookManager& orderbook_manager_;
     DataLogger& data_logger_;
+    const BotConfiguration& config_;
+    const EngineScheduler* scheduler_ = nullptr;
+    const AeronPublisher* aeron_ = nullptr;
+    std::vector<const BybitWebSocketClient*> private_clients_;
     std::atomic<bool> running_{true};
 };
@@ -0,0 +1,116 @@
+#pragma once
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include "utils/MemoryPlacement.h"
+
+// Single-producer / single-consumer ring of variable-length binary records.
+//
+// Each record is an 8-byte header {length, type} followed by the payload, padded to
+// 8 bytes. A record never wraps around the end of the buffer: if it does not fit in
+// the remaining tail, a PADDING record fills the tail and the record starts at 0.
+// Positions are monotonically increasing 64-bit counters (index = pos & mask).
+class SpscByteRing {
+public:
+    static constexpr uint32_t HEADER_SIZE = 8;
+
+    // Capacity is rounded up to a power of two
+    explicit SpscByteRing(size_t capacity) {
+        size_t cap = 64;
+        while (cap < capacity) cap <<= 1;
+        capacity_ = cap;
+        mask_ = cap - 1;
+        buffer_ = MappedRegion(cap);      // Huge-page backed when enabled (MemoryPlacement)
+    }
+
+    size_t capacity() const { return capacity_; }
+
+    // Approximate fill level (exact from the producer side)
+    size_t used_bytes() const {
+        return head_.load(std::memory_order_relaxed) - tail_.load(std::memory_order_acquire);
+    }
+
+    // ------------------------------------------------------------------------
+    // PRODUCER
+    // ------------------------------------------------------------------------
+
+    // Reserves a contiguous payload area of `len` bytes. Returns nullptr if the ring
+    // is too full. Must be followed by commit() before the next try_claim().
+    char* try_claim(uint32_t len) {
+        uint64_t record = align(HEADER_SIZE + len);
+        if (record > capacity_) return nullptr;
+
+        uint64_t head = head_.load(std::memory_order_relaxed);
+        uint64_t to_end = capacity_ - (head & mask_);
+        uint64_t needed = record <= to_end ? record : to_end + record;
+
+        if (needed > capacity_ - (head - tail_cache_)) {
+            tail_cache_ = tail_.load(std::memory_order_acquire);
+            if (needed > capacity_ - (head - tail_cache_)) return nullptr;
+        }
+
+        if (record > to_end) {
+            write_header(head, static_cast<uint32_t>(to_end - HEADER_SIZE), PADDING);
+            head += to_end;
+        }
+
+        write_header(head, len, DATA);
+        pending_head_ = head + record;
+        return buffer_.data() + (head & mask_) + HEADER_SIZE;
+    }
+
+    void commit() {
+        head_.store(pending_head_, std::memory_order_release);
+    }
+
+    // ------------------------------------------------------------------------
+    // CONSUMER
+    // ------------------------------------------------------------------------
+
+    // Calls fn(const char* payload, uint32_t len) for every committed record and
+    // releases their space. Returns the number of records consumed.
+    template <typename Fn>
+    size_t drain(Fn&& fn) {
+        uint64_t tail = tail_.load(std::memory_order_relaxed);
+        uint64_t head = head_.load(std::memory_order_acquire);
+        size_t records = 0;
+
+        while (tail < head) {
+            uint32_t len, type;
+            const char* at = buffer_.data() + (tail & mask_);
+            std::memcpy(&len, at, sizeof(len));
+            std::memcpy(&type, at + 4, sizeof(type));
+
+            if (type == DATA) {
+                fn(at + HEADER_SIZE, len);
+                records++;
+            }
+            tail += align(HEADER_SIZE + len);
+        }
+
+        tail_.store(tail, std::memory_order_release);
+        return records;
+    }
+
+private:
+    static constexpr uint32_t DATA = 0;
+    static constexpr uint32_t PADDING = 1;
+
+    static uint64_t align(uint64_t n) { return (n + 7) & ~uint64_t(7); }
+
+    void write_header(uint64_t pos, uint32_t len, uint32_t type) {
+        char* at = buffer_.data() + (pos & mask_);
+        std::memcpy(at, &len, sizeof(len));
+        std::memcpy(at + 4, &type, sizeof(type));
+    }
+
+    MappedRegion buffer_;
+    size_t capacity_;
+    size_t mask_;
+
+    // Producer and consumer positions on separate cache lines
+    alignas(64) std::atomic<uint64_t> head_{0};
+    uint64_t pending_head_ = 0;
+    uint64_t tail_cache_ = 0;
+    alignas(64) std::atomic<uint64_t> tail_{0};
+};
@@ -0,0 +1,137 @@
+#pragma once
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include "core/SymbolRegistry.h"
+
+// Memory-mapped counters file for external readers (telemetry_spy, a Prometheus
+// textfile exporter), in the spirit of Aeron's CnC counters.
+//
+// The file is a fixed POD layout of lock-free atomics: a header, a table of process
+// counters and one SymbolCounters slot per SymbolRegistry ID. Writers only ever do
+// relaxed stores:
+//   - PerformanceMonitor samples the counters the hot threads already keep (feed,
+//     books, Aeron, scheduler) once per telemetry_interval_ms and copies them in;
+//   - each TradingEngine stores its own state, position and order round-trips into
+//     its symbol's slot (one engine per symbol, so one writer per field).
+// Readers map the file read-only and may read at any time; a value is always whole,
+// a row may mix two samples. Rates are for the reader to derive (deltas over time).
+//
+// Until open() succeeds every write lands in a private in-process copy, so callers
+// never need to check whether telemetry is enabled.
+namespace telemetry {
+
+inline constexpr uint64_t MAGIC = 0x544C4D5954425442ull;   // "BTBTYMLT"
+inline constexpr uint32_t VERSION = 3;          // 2: RISK_REJECTS, 3: inbox_full_waits
+inline constexpr uint32_t MAX_SYMBOLS = SymbolRegistry::MAX_SYMBOLS;
+
+enum class Counter : uint32_t {
+    MESSAGES,               // Public frames received (all lines)
+    BOOKS,                  // Order books allocated
+    BOOK_RESYNCS,
+    DUPLICATES,             // A/B copies dropped
+    PARSE_ERRORS,
+    HOT_PATH_ALLOCATIONS,
+    AERON_PUBLISHED,
+    AERON_BACKPRESSURE,     // Failed offers (back-pressured / not connected)
+    RECONNECTS_PUBLIC,
+    RECONNECTS_PRIVATE,
+    MAX_RECOVERY_MS,
+    ENGINE_CYCLES,
+    ENGINE_STEALS,
+    LOG_DROPPED,
+    RISK_REJECTS,           // Orders / cancels refused by the pre-trade gate
+    COUNT
+};
+
+inline constexpr size_t COUNTERS = static_cast<size_t>(Counter::COUNT);
+
+const char* counter_name(Counter counter);
+// Mirrors BotState (TradingEngine.h); -1 = no engine on this symbol
+const char* engine_state_name(int32_t state);
+
+struct alignas(64) SymbolCounters {
+    char symbol[32];                        // Written before `active` is set
+    std::atomic<uint32_t> active;
+    std::atomic<int32_t> engine_state;
+
+    // Sampled
+    std::atomic<uint64_t> messages;
+    std::atomic<uint64_t> book_updates;
+    std::atomic<uint64_t> parse_errors;
+    std::atomic<uint64_t> book_valid;       // 0 / 1
+
+    // Engine
+    std::atomic<int64_t> position_lots;     // Signed: negative = short
+    std::atomic<uint64_t> orders_sent;
+    std::atomic<uint64_t> order_rtt_count;  // Send -> first execution report
+    std::atomic<uint64_t> order_rtt_sum_ns;
+    std::atomic<uint64_t> order_rtt_last_ns;
+    std::atomic<uint64_t> order_rtt_max_ns;
+    std::atomic<uint64_t> inbox_full_waits; // Report producers that waited for a full inbox
+};
+
+struct Header {
+    uint64_t magic;
+    uint32_t version;
+    uint32_t max_symbols;
+    uint32_t counter_count;
+    int32_t pid;
+    int64_t start_unix_ns;
+    char instance[64];
+    std::atomic<int64_t> heartbeat_unix_ns;     // Last sample: stale = process gone or hung
+    std::atomic<uint32_t> symbol_limit;         // Slots [0, symbol_limit) may be active
+};
+
+struct Layout {
+    Header header;
+    alignas(64) std::array<std::atomic<uint64_t>, COUNTERS> counters;
+    std::array<SymbolCounters, MAX_SYMBOLS> symbols;
+};
+
+// Relaxed single-writer helpers: no read-modify-write on the hot path
+inline void store(std::atomic<uint64_t>& field, uint64_t value) { field.store(value, std::memory_order_relaxed); }
+inline void bump(std::atomic<uint64_t>& field) {
+    field.store(field.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+}
+
+class TelemetrySegment {
+public:
+    static TelemetrySegment& get_instance() {
+        static TelemetrySegment instance;
+        return instance;
+    }
+
+    // Creates (or replaces) the file, maps it and writes the header. Call before the
+    // engines are built: they keep a pointer to their slot.
+    bool open(const std::string& path, const std::string& instance);
+    bool is_open() const { return mapped_ != nullptr; }
+    const std::string& path() const { return path_; }
+
+    void set(Counter counter, uint64_t value) {
+        store(layout_->counters[static_cast<size_t>(counter)], value);
+    }
+    // Activates the symbol's slot on first use (cold path)
+    SymbolCounters& symbol(uint32_t symbol_id);
+    void heartbeat();
+
+    // Reader side: read-only mapping of another process's file (nullptr if it is not a
+    // telemetry file of this version). Unmap with unmap().
+    static const Layout* map_readonly(const std::string& path);
+    static void unmap(const Layout* layout);
+
+private:
+    TelemetrySegment();
+    ~TelemetrySegment();
+
+    std::unique_ptr<Layout> local_;         // Until open()
+    Layout* layout_;
+    void* mapped_ = nullptr;
+    std::string path_;
+    SymbolCounters overflow_{};             // For IDs past MAX_SYMBOLS
+};
+
+} // namespace telemetry
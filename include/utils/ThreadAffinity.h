@@ -0,0 +1,28 @@
+#pragma once
+#include <string>
+
+// Where one runtime thread runs (BotConfiguration thread topology)
+struct ThreadPlacement {
+    int core = -1;              // CPU core, -1 = unpinned
+    int fifo_priority = 0;      // SCHED_FIFO 1-99 (needs CAP_SYS_NICE / an rtprio limit), 0 = normal scheduling
+};
+
+// Thread placement helpers for the latency-critical threads.
+// On platforms without hard affinity (macOS) these are no-ops that return false.
+namespace thread_affinity {
+    // Pins the calling thread to one CPU core. core < 0 means "leave unpinned".
+    bool pin_current_thread(int core);
+
+    // Switches the calling thread to SCHED_FIFO at `priority`. priority <= 0 leaves it as is.
+    bool set_current_thread_fifo(int priority);
+
+    // Names the calling thread (shows up in top -H / perf). Truncated to 15 chars on Linux.
+    void set_current_thread_name(const std::string& name);
+
+    // Name, core and priority of the calling thread in one go. Returns what was applied
+    // for the start-up log (" (core 3, FIFO 80)"), empty if the thread stays as it was.
+    std::string apply_placement(const std::string& name, const ThreadPlacement& placement);
+
+    // NUMA node of a CPU core (sysfs), -1 if unknown or not a NUMA host
+    int numa_node_of_core(int core);
+}
@@ -0,0 +1,68 @@
+#pragma once
+#include <chrono>
+#include <cstdint>
+#include <thread>
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
+
+// Cycle-counter timestamps for hot-path latency stamps.
+// On x86 this is RDTSC (constant/invariant TSC assumed, as on every CPU we deploy on):
+// ~7ns and no vDSO call, cheap enough to stamp every frame. Elsewhere it falls back to
+// steady_clock nanoseconds (one tick = 1ns).
+//
+// Ticks are converted with a one-off calibration against steady_clock and, for wall
+// clock comparisons with exchange timestamps, anchored to system_clock.
+namespace tsc {
+
+inline uint64_t now() {
+#if defined(__x86_64__) || defined(__i386__)
+    return __rdtsc();
+#else
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count());
+#endif
+}
+
+struct Calibration {
+    double ns_per_tick = 1.0;
+    uint64_t anchor_tick = 0;
+    int64_t anchor_unix_ns = 0;     // system_clock at anchor_tick
+};
+
+// Measured once (about 20ms of spinning on the first call): call it at startup,
+// never first from a hot path.
+inline const Calibration& calibration() {
+    static const Calibration cal = [] {
+        using clock = std::chrono::steady_clock;
+        Calibration c;
+        auto t0 = clock::now();
+        uint64_t c0 = now();
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+        auto t1 = clock::now();
+        uint64_t c1 = now();
+
+        double ns = static_cast<double>(std::chrono::duration_cast<std::chrono::nanoseconds>(t1 - t0).count());
+        if (c1 > c0) c.ns_per_tick = ns / static_cast<double>(c1 - c0);
+        c.anchor_tick = now();
+        c.anchor_unix_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::system_clock::now().time_since_epoch()).count();
+        return c;
+    }();
+    return cal;
+}
+
+// Elapsed nanoseconds between two stamps (0 if they are out of order, e.g. across cores)
+inline uint64_t to_ns(uint64_t from, uint64_t to) {
+    if (to <= from) return 0;
+    return static_cast<uint64_t>(static_cast<double>(to - from) * calibration().ns_per_tick);
+}
+
+// Wall clock (Unix epoch ns) of a stamp
+inline int64_t to_unix_ns(uint64_t tick) {
+    const Calibration& c = calibration();
+    double delta = (static_cast<double>(tick) - static_cast<double>(c.anchor_tick)) * c.ns_per_tick;
+    return c.anchor_unix_ns + static_cast<int64_t>(delta);
+}
+
+} // namespace tsc
@@ -3,90 +3,258 @@
 #include <cstring>
 
 // ============================================================================
-// UPDATE METHODS (FIXED WITH PROPER ORDERING)
+// UPDATE METHODS (SNAPSHOT / DELTA)
 // ============================================================================
 
-// [FIX] Ensure atomic visibility of updates
-void OrderBook::update_bids(const std::vector<PriceLevel>& bids) {
-    int count = std::min(static_cast<int>(bids.size()), MAX_LEVELS);
-    
-    // Copy data first
-    for (int i = 0; i < count; i++) {
-        bids_[i] = bids[i];
+OrderBook::ApplyResult OrderBook::apply_snapshot(
+    std::span<const PriceLevel> bids,
+    std::span<const PriceLevel> asks,
+    uint64_t update_id,
+    uint64_t seq
+) {
+    // A snapshot wins unless the book already holds this update or a later one (the
+    // same image from a slower line). u=1 is Bybit's snapshot after a service restart.
+    lock_writer();
+    if (valid_.load(std::memory_order_relaxed) && update_id != 1 &&
+        update_id <= last_update_id_.load(std::memory_order_relaxed)) {
+        unlock_writer();
+        return ApplyResult::STALE;
     }
-    
-    // [FIX] Ensure data is written before count is updated
-    std::atomic_thread_fence(std::memory_order_release);
-    
-    // Update count (makes data visible to readers)
-    bid_count_.store(count, std::memory_order_release);
+
+    begin_write();
+    bid_count_.store(copy_levels(bids_.data(), bids), std::memory_order_relaxed);
+    ask_count_.store(copy_levels(asks_.data(), asks), std::memory_order_relaxed);
+    last_update_id_.store(update_id, std::memory_order_relaxed);
+    last_seq_.store(seq, std::memory_order_relaxed);
+    valid_.store(true, std::memory_order_relaxed);
+    if (SignalKernel* kernel = signals_.load(std::memory_order_relaxed)) {
+        kernel->update(bids_.data(), bid_count_.load(std::memory_order_relaxed), 0,
+                       asks_.data(), ask_count_.load(std::memory_order_relaxed), 0, update_id, true);
+    }
+    end_write();
+    unlock_writer();
+
+    resync_pending_.store(false, std::memory_order_relaxed);
+    return ApplyResult::APPLIED;
 }
 
-void OrderBook::update_asks(const std::vector<PriceLevel>& asks) {
-    int count = std::min(static_cast<int>(asks.size()), MAX_LEVELS);
-    
-    // Copy data first
-    for (int i = 0; i < count; i++) {
-        asks_[i] = asks[i];
+OrderBook::ApplyResult OrderBook::apply_delta(
+    std::span<const PriceLevel> bids,
+    std::span<const PriceLevel> asks,
+    uint64_t update_id,
+    uint64_t seq,
+    GapPolicy gap_policy
+) {
+    lock_writer();
+    if (!valid_.load(std::memory_order_relaxed)) {
+        unlock_writer();
+        return ApplyResult::NO_SNAPSHOT;
+    }
+
+    uint64_t last_id = last_update_id_.load(std::memory_order_relaxed);
+    if (update_id <= last_id) {
+        unlock_writer();
+        return ApplyResult::STALE;      // Duplicate, or the copy that lost the race
+    }
+    if (update_id != last_id + 1) {
+        // Missed at least one delta: everything we hold may be wrong now.
+        if (gap_policy == GapPolicy::INVALIDATE) {
+            begin_write();
+            valid_.store(false, std::memory_order_relaxed);
+            if (SignalKernel* kernel = signals_.load(std::memory_order_relaxed)) kernel->invalidate();
+            end_write();
+        }
+        unlock_writer();
+        return ApplyResult::GAP;
+    }
+
+    begin_write();
+
+    // First level each side changed at (the signal kernel re-reads from there)
+    int bid_count = bid_count_.load(std::memory_order_relaxed);
+    int bid_touched = MAX_LEVELS;
+    for (const auto& level : bids) {
+        bid_count = apply_level(bids_.data(), bid_count, level, true, bid_touched);
+    }
+
+    int ask_count = ask_count_.load(std::memory_order_relaxed);
+    int ask_touched = MAX_LEVELS;
+    for (const auto& level : asks) {
+        ask_count = apply_level(asks_.data(), ask_count, level, false, ask_touched);
+    }
+
+    bid_count_.store(bid_count, std::memory_order_relaxed);
+    ask_count_.store(ask_count, std::memory_order_relaxed);
+    last_update_id_.store(update_id, std::memory_order_relaxed);
+    last_seq_.store(seq, std::memory_order_relaxed);
+    if (SignalKernel* kernel = signals_.load(std::memory_order_relaxed)) {
+        kernel->update(bids_.data(), bid_count, std::min(bid_touched, bid_count),
+                       asks_.data(), ask_count, std::min(ask_touched, ask_count), update_id, false);
     }
-    
-    // [FIX] Ensure data is written before count is updated
+
+    end_write();
+    unlock_writer();
+    return ApplyResult::APPLIED;
+}
+
+void OrderBook::invalidate() {
+    lock_writer();
+    begin_write();
+    valid_.store(false, std::memory_order_relaxed);
+    if (SignalKernel* kernel = signals_.load(std::memory_order_relaxed)) kernel->invalidate();
+    end_write();
+    unlock_writer();
+}
+
+bool OrderBook::begin_resync() {
+    return !resync_pending_.exchange(true, std::memory_order_relaxed);
+}
+
+bool OrderBook::is_valid() const {
+    return valid_.load(std::memory_order_acquire);
+}
+
+// ============================================================================
+// SEQLOCK WRITE SECTION
+// ============================================================================
+
+// One exchange when uncontended; a second line only waits out one update.
+void OrderBook::lock_writer() {
+    while (writer_claim_.exchange(true, std::memory_order_acquire)) cpu_pause();
+}
+
+void OrderBook::unlock_writer() {
+    writer_claim_.store(false, std::memory_order_release);
+}
+
+// Version goes odd: readers that start now spin, readers already inside will retry.
+void OrderBook::begin_write() {
+    version_.store(version_.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
     std::atomic_thread_fence(std::memory_order_release);
-    
-    // Update count (makes data visible to readers)
-    ask_count_.store(count, std::memory_order_release);
+}
+
+// Version goes even again: publishes every store made since begin_write().
+void OrderBook::end_write() {
+    version_.store(version_.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+}
+
+uint64_t OrderBook::get_last_update_id() const {
+    return last_update_id_.load(std::memory_order_relaxed);
+}
+
+uint64_t OrderBook::get_last_seq() const {
+    return last_seq_.load(std::memory_order_relaxed);
 }
 
 // ============================================================================
-// GETTER METHODS (FIXED WITH ACQUIRE SEMANTICS)
+// LEVEL HELPERS
 // ============================================================================
 
-bool OrderBook::get_best_bid(double& price, double& qty) const {
-    // [FIX] Acquire count first to ensure we see updated data
-    int count = bid_count_.load(std::memory_order_acquire);
-    
-    if (count > 0) {
-        // [FIX] Ensure we read data after count
-        std::atomic_thread_fence(std::memory_order_acquire);
-        
-        price = bids_[0].price;
-        qty = bids_[0].quantity;
-        
-        // [FIX] Sanity check
-        if (price <= 0 || qty <= 0) {
-            return false;
+int OrderBook::copy_levels(PriceLevel* dst, std::span<const PriceLevel> src) {
+    int count = 0;
+    for (const auto& level : src) {
+        if (count == MAX_LEVELS) break;
+        if (level.price <= 0 || level.quantity <= 0) continue;
+        dst[count++] = level;
+    }
+    return count;
+}
+
+// Upserts (or deletes, when quantity is 0) one level in a sorted side.
+// Returns the new level count. Levels pushed beyond MAX_LEVELS are dropped,
+// Bybit re-sends them as inserts once they come back into the top N.
+// touched is lowered to the index of the level if the side changed.
+int OrderBook::apply_level(PriceLevel* levels, int count, const PriceLevel& level, bool descending,
+                           int& touched) {
+    // Binary search for the first level that is not "better" than the incoming price
+    auto better = [descending](int64_t a, int64_t b) { return descending ? a > b : a < b; };
+    int lo = 0, hi = count;
+    while (lo < hi) {
+        int mid = (lo + hi) / 2;
+        if (better(levels[mid].price, level.price)) lo = mid + 1;
+        else hi = mid;
+    }
+
+    bool exists = lo < count && levels[lo].price == level.price;
+
+    if (level.quantity <= 0) {
+        if (exists) {
+            std::memmove(&levels[lo], &levels[lo + 1], sizeof(PriceLevel) * (count - lo - 1));
+            count--;
+            touched = std::min(touched, lo);
         }
-        return true;
+        return count;
+    }
+
+    if (exists) {
+        levels[lo].quantity = level.quantity;
+        touched = std::min(touched, lo);
+        return count;
     }
-    return false;
+
+    if (lo >= MAX_LEVELS) return count;
+    touched = std::min(touched, lo);
+
+    int tail = std::min(count, MAX_LEVELS - 1) - lo;
+    if (tail > 0) {
+        std::memmove(&levels[lo + 1], &levels[lo], sizeof(PriceLevel) * tail);
+    }
+    levels[lo] = level;
+    return std::min(count + 1, MAX_LEVELS);
+}
+
+// ============================================================================
+// GETTER METHODS (CONSISTENT READS)
+// ============================================================================
+
+bool OrderBook::get_top_of_book(TopOfBook& top) const {
+    bool ok = false;
+    read_consistent([&](const View& v) {
+        ok = v.valid && v.bid_count > 0 && v.ask_count > 0;
+        if (!ok) return;
+        top.bid_price = v.bids[0].price;
+        top.bid_qty = v.bids[0].quantity;
+        top.ask_price = v.asks[0].price;
+        top.ask_qty = v.asks[0].quantity;
+        top.update_id = v.update_id;
+    });
+    return ok;
+}
+
+bool OrderBook::get_best_bid(double& price, double& qty) const {
+    bool ok = false;
+    read_consistent([&](const View& v) {
+        ok = v.bid_count > 0;
+        if (ok) {
+            price = instrument_.ticks_to_price(v.bids[0].price);
+            qty = instrument_.lots_to_qty(v.bids[0].quantity);
+        }
+    });
+
+    // [FIX] Sanity check
+    return ok && price > 0 && qty > 0;
 }
 
 bool OrderBook::get_best_ask(double& price, double& qty) const {
-    // [FIX] Acquire count first to ensure we see updated data
-    int count = ask_count_.load(std::memory_order_acquire);
-    
-    if (count > 0) {
-        // [FIX] Ensure we read data after count
-        std::atomic_thread_fence(std::memory_order_acquire);
-        
-        price = asks_[0].price;
-        qty = asks_[0].quantity;
-        
-        // [FIX] Sanity check
-        if (price <= 0 || qty <= 0) {
-            return false;
+    bool ok = false;
+    read_consistent([&](const View& v) {
+        ok = v.ask_count > 0;
+        if (ok) {
+            price = instrument_.ticks_to_price(v.asks[0].price);
+            qty = instrument_.lots_to_qty(v.asks[0].quantity);
         }
-        return true;
-    }
-    return false;
+    });
+
+    // [FIX] Sanity check
+    return ok && price > 0 && qty > 0;
 }
 
 double OrderBook::get_fair_price() const {
-    double bid_price, ask_price, bid_qty, ask_qty;
-    if (get_best_bid(bid_price, bid_qty) && get_best_ask(ask_price, ask_qty)) {
+    TopOfBook top;
+    if (get_top_of_book(top)) {
         // [FIX] Validate spread before returning
-        if (bid_price < ask_price) {
-            return (bid_price + ask_price) / 2.0;
+        if (top.bid_price < top.ask_price) {
+            return instrument_.ticks_to_price(top.bid_price + top.ask_price) / 2.0;
         }
     }
     return 0.0;
@@ -96,34 +264,94 @@ double OrderBook::get_fair_price() const {
 // SNAPSHOT METHODS
 // ============================================================================
 
-std::vector<std::pair<double, double>> OrderBook::get_bids(int max_levels) const {
-    std::vector<std::pair<double, double>> result;
-    int count = std::min(bid_count_.load(std::memory_order_acquire), max_levels);
-    
-    std::atomic_thread_fence(std::memory_order_acquire);
-    
+void OrderBook::copy_side(const PriceLevel* levels, int count, int max_levels,
+                          std::vector<std::pair<double, double>>& out) const {
+    out.clear();
+    count = std::min(count, max_levels);
     for (int i = 0; i < count; i++) {
         // [FIX] Skip invalid levels
-        if (bids_[i].price > 0 && bids_[i].quantity > 0) {
-            result.push_back({bids_[i].price, bids_[i].quantity});
+        if (levels[i].price > 0 && levels[i].quantity > 0) {
+            out.emplace_back(instrument_.ticks_to_price(levels[i].price),
+                             instrument_.lots_to_qty(levels[i].quantity));
         }
     }
+}
+
+std::vector<std::pair<double, double>> OrderBook::get_bids(int max_levels) const {
+    std::vector<std::pair<double, double>> result;
+    result.reserve(std::min(max_levels, MAX_LEVELS));
+    read_consistent([&](const View& v) { copy_side(v.bids, v.bid_count, max_levels, result); });
     return result;
 }
 
 std::vector<std::pair<double, double>> OrderBook::get_asks(int max_levels) const {
     std::vector<std::pair<double, double>> result;
-    int count = std::min(ask_count_.load(std::memory_order_acquire), max_levels);
-    
-    std::atomic_thread_fence(std::memory_order_acquire);
-    
-    for (int i = 0; i < count; i++) {
-        // [FIX] Skip invalid levels
-        if (asks_[i].price > 0 && asks_[i].quantity > 0) {
-            result.push_back({asks_[i].price, asks_[i].quantity});
+    result.reserve(std::min(max_levels, MAX_LEVELS));
+    read_consistent([&](const View& v) { copy_side(v.asks, v.ask_count, max_levels, result); });
+    return result;
+}
+
+void OrderBook::get_snapshot(std::vector<std::pair<double, double>>& bids,
+                             std::vector<std::pair<double, double>>& asks,
+                             int max_levels) const {
+    read_consistent([&](const View& v) {
+        copy_side(v.bids, v.bid_count, max_levels, bids);
+        copy_side(v.asks, v.ask_count, max_levels, asks);
+    });
+}
+
+OrderBook::View OrderBook::copy_top(PriceLevel* bids, PriceLevel* asks, int max_levels) const {
+    View top{};
+    read_consistent([&](const View& v) {
+        top = v;
+        top.bid_count = std::clamp(v.bid_count, 0, max_levels);
+        top.ask_count = std::clamp(v.ask_count, 0, max_levels);
+        std::copy_n(v.bids, top.bid_count, bids);
+        std::copy_n(v.asks, top.ask_count, asks);
+    });
+    top.bids = bids;
+    top.asks = asks;
+    return top;
+}
+
+int OrderBook::get_bid_depth() const {
+    return bid_count_.load(std::memory_order_relaxed);
+}
+
+int OrderBook::get_ask_depth() const {
+    return ask_count_.load(std::memory_order_relaxed);
+}
+
+// ============================================================================
+// SIGNALS
+// ============================================================================
+
+void OrderBook::enable_signals(const SignalParams& params) {
+    lock_writer();
+    if (!signals_.load(std::memory_order_relaxed)) {
+        signal_storage_ = std::make_unique<SignalKernel>(params);
+        SignalKernel* kernel = signal_storage_.get();
+        begin_write();
+        if (valid_.load(std::memory_order_relaxed)) {
+            kernel->update(bids_.data(), bid_count_.load(std::memory_order_relaxed), 0,
+                           asks_.data(), ask_count_.load(std::memory_order_relaxed), 0,
+                           last_update_id_.load(std::memory_order_relaxed), true);
         }
+        signals_.store(kernel, std::memory_order_release);
+        end_write();
     }
-    return result;
+    unlock_writer();
+}
+
+bool OrderBook::get_signals(BookSignals& out) const {
+    const SignalKernel* kernel = signals_.load(std::memory_order_acquire);
+    if (!kernel) return false;
+    bool ok = false;
+    read_consistent([&](const View& v) {
+        out = kernel->signals();
+        ok = v.valid && out.valid;
+    });
+    return ok;
 }
 
 // ============================================================================
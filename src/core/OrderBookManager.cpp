@@ -1,42 +1,84 @@
 #include "core/OrderBookManager.h"
 #include <iostream>
+#include <new>
+
+// Books are never removed while the manager lives: destroyed here, in their arena slots
+OrderBookManager::~OrderBookManager() {
+    for (auto& slot : books_) {
+        if (OrderBook* book = slot.load(std::memory_order_relaxed)) book->~OrderBook();
+    }
+}
 
 // THREAD-SAFE: Finds the OrderBook for a symbol (e.g., "BTCUSDT").
-// If it doesn't exist yet, it creates a new empty one, saves it, and returns it.
-// Uses a lock to ensure two threads don't try to create the same book at the exact same time.
-std::shared_ptr<OrderBook> OrderBookManager::get_or_create(const std::string& symbol) {
+// If it doesn't exist yet, it interns the symbol, creates a new empty book, publishes it
+// in the directory and returns it. Meant for subscribe time, not for the hot path.
+// Instrument metadata must be registered before: the book is built on its tick grid.
+OrderBook* OrderBookManager::get_or_create(const std::string& symbol) {
+    return get_or_create(SymbolRegistry::get_instance().intern(symbol));
+}
+
+// THREAD-SAFE: Same as above for an already interned symbol.
+// Uses a lock so two threads don't try to create the same book at the exact same time;
+// readers never take it - they see the book once the slot's pointer is stored.
+OrderBook* OrderBookManager::get_or_create(uint32_t symbol_id) {
+    if (symbol_id >= SymbolRegistry::MAX_SYMBOLS) return nullptr;
+
+    if (OrderBook* existing = get(symbol_id)) return existing;
+
     std::lock_guard<std::mutex> lock(mutex_);
-    if (orderbooks_.find(symbol) == orderbooks_.end()) {
-        orderbooks_[symbol] = std::make_shared<OrderBook>();
-        std::cout << "✓ Created orderbook for: " << symbol << "\n";
+    OrderBook* book = books_[symbol_id].load(std::memory_order_relaxed);
+    if (!book) {
+        if (!arena_.data()) arena_ = MappedRegion(BOOK_STRIDE * SymbolRegistry::MAX_SYMBOLS);
+
+        // The book keeps the instrument's tick/lot grid for its lifetime
+        book = new (arena_.data() + BOOK_STRIDE * symbol_id)
+            OrderBook(InstrumentRegistry::get_instance().get(symbol_id));
+        books_[symbol_id].store(book, std::memory_order_release);
+        book_count_.fetch_add(1, std::memory_order_relaxed);
+        std::cout << "✓ Created orderbook for: " << SymbolRegistry::get_instance().name(symbol_id) << "\n";
     }
-    return orderbooks_[symbol];
+    return book;
 }
 
-// THREAD-SAFE: strict lookup.
+// THREAD-SAFE: strict lookup by name.
 // Returns the pointer to the OrderBook if it exists.
 // Returns nullptr (null) if we haven't created an orderbook for this symbol yet.
-// Useful when trading logic needs to check data but shouldn't be creating new memory.
-std::shared_ptr<OrderBook> OrderBookManager::get(const std::string& symbol) const {
-    std::lock_guard<std::mutex> lock(mutex_);
-    auto it = orderbooks_.find(symbol);
-    if (it != orderbooks_.end()) {
-        return it->second;
-    }
-    return nullptr;
+// Hot paths should resolve the ID once and use get(uint32_t) instead.
+OrderBook* OrderBookManager::get(const std::string& symbol) const {
+    return get(SymbolRegistry::get_instance().find(symbol));
 }
 
-// THREAD-SAFE: Snapshots the entire collection.
-// Returns a copy of the map containing ALL symbols and their OrderBooks currently in memory.
-// Useful for loops that need to iterate through every active symbol (e.g., printing a dashboard).
-std::unordered_map<std::string, std::shared_ptr<OrderBook>> OrderBookManager::get_all() const {
-    std::lock_guard<std::mutex> lock(mutex_);
-    return orderbooks_;
+// LOCK-FREE: Snapshot view of every book currently in the directory.
+// Nothing is copied; the view walks the flat array up to the registry size at call time.
+BookDirectoryView OrderBookManager::get_all() const {
+    return BookDirectoryView(this, SymbolRegistry::get_instance().size());
 }
 
-// THREAD-SAFE: Returns the count of active OrderBooks.
-// Simply tells you how many symbols we are currently tracking/subscribed to.
+// LOCK-FREE: Returns the count of active OrderBooks.
 size_t OrderBookManager::size() const {
-    std::lock_guard<std::mutex> lock(mutex_);
-    return orderbooks_.size();
-}
\ No newline at end of file
+    return book_count_.load(std::memory_order_relaxed);
+}
+
+// ============================================================================
+// DIRECTORY VIEW
+// ============================================================================
+
+BookDirectoryView::iterator::iterator(const OrderBookManager* mgr, uint32_t id, uint32_t end)
+    : mgr_(mgr), id_(id), end_(end) {
+    skip_empty();
+}
+
+BookDirectoryView::Entry BookDirectoryView::iterator::operator*() const {
+    return Entry{id_, SymbolRegistry::get_instance().name(id_), mgr_->get(id_)};
+}
+
+BookDirectoryView::iterator& BookDirectoryView::iterator::operator++() {
+    id_++;
+    skip_empty();
+    return *this;
+}
+
+// Symbols can be interned without a book (e.g. only tracked for trading)
+void BookDirectoryView::iterator::skip_empty() {
+    while (id_ < end_ && !mgr_->get(id_)) id_++;
+}
@@ -0,0 +1,129 @@
+#include "core/SignalKernel.h"
+#include "core/OrderBook.h"
+#include <algorithm>
+#include <cmath>
+
+static_assert(SignalKernel::MAX_LEVELS == OrderBook::MAX_LEVELS, "the kernel mirrors whole book sides");
+
+// ============================================================================
+// UPDATE (book writer, inside the write section)
+// ============================================================================
+
+void SignalKernel::update(const PriceLevel* bids, int bid_count, int bid_from,
+                          const PriceLevel* asks, int ask_count, int ask_from,
+                          uint64_t update_id, bool snapshot) {
+    mirror(bid_side_, bids, bid_count, bid_from);
+    mirror(ask_side_, asks, ask_count, ask_from);
+    signals_.update_id = update_id;
+    if (bid_count == 0 || ask_count == 0 || bid_side_.price[0] >= ask_side_.price[0]) {
+        signals_.valid = false;
+        return;
+    }
+
+    const int64_t bid = bid_side_.price[0];
+    const int64_t ask = ask_side_.price[0];
+    const double mid = 0.5 * static_cast<double>(bid + ask);
+    const bool mid_moved = snapshot || mid != last_mid_;
+
+    // The depth band follows mid: a moved mid re-aggregates both sides
+    const double band = params_.depth_bps * 1e-4;
+    if (mid_moved || bid_from < bid_side_.reach) {
+        aggregate(bid_side_, static_cast<int64_t>(std::ceil(mid * (1.0 - band))), true, params_.vwap_target_lots);
+    }
+    if (mid_moved || ask_from < ask_side_.reach) {
+        aggregate(ask_side_, static_cast<int64_t>(std::floor(mid * (1.0 + band))), false, params_.vwap_target_lots);
+    }
+
+    const double bid_qty = static_cast<double>(bid_side_.qty[0]);
+    const double ask_qty = static_cast<double>(ask_side_.qty[0]);
+    signals_.microprice = (static_cast<double>(bid) * ask_qty + static_cast<double>(ask) * bid_qty) /
+                          (bid_qty + ask_qty);
+
+    const int64_t top_lots = bid_side_.top_lots + ask_side_.top_lots;
+    signals_.imbalance = top_lots > 0
+        ? static_cast<double>(bid_side_.top_lots - ask_side_.top_lots) / static_cast<double>(top_lots)
+        : 0.0;
+    signals_.bid_depth_lots = bid_side_.depth_lots;
+    signals_.ask_depth_lots = ask_side_.depth_lots;
+    signals_.bid_vwap = bid_side_.vwap;
+    signals_.ask_vwap = ask_side_.vwap;
+
+    // EWMAs in event time; the first update seeds the spread
+    const double spread = static_cast<double>(ask - bid);
+    if (signals_.updates == 0) signals_.ewma_spread = spread;
+    else signals_.ewma_spread += params_.spread_alpha * (spread - signals_.ewma_spread);
+
+    if (!snapshot && last_mid_ > 0.0 && mid != last_mid_) {
+        double ret_bps = (mid - last_mid_) / last_mid_ * 1e4;
+        variance_ += params_.volatility_alpha * (ret_bps * ret_bps - variance_);
+    }
+    last_mid_ = mid;
+    signals_.ewma_volatility_bps = std::sqrt(variance_);
+
+    signals_.updates++;
+    signals_.valid = true;
+}
+
+// ============================================================================
+// SIDES
+// ============================================================================
+
+// Levels before `from` are unchanged (the book's sides are shifted in place from there)
+void SignalKernel::mirror(Side& side, const PriceLevel* levels, int count, int from) {
+    for (int i = std::max(from, 0); i < count; i++) {
+        side.price[i] = levels[i].price;
+        side.qty[i] = levels[i].quantity;
+    }
+    side.count = count;
+}
+
+void SignalKernel::aggregate(Side& side, int64_t cutoff, bool is_bid, int64_t target_lots) const {
+    const int count = side.count;
+    const int64_t* price = side.price.data();
+    const int64_t* qty = side.qty.data();
+
+    // Top-N size
+    const int top = std::min(std::max(params_.imbalance_levels, 1), count);
+    int64_t top_lots = 0;
+    for (int i = 0; i < top; i++) top_lots += qty[i];
+
+    // Depth band: masked sums over the whole side, no data-dependent branch
+    int64_t depth_lots = 0;
+    int in_band = 0;
+    if (is_bid) {
+        for (int i = 0; i < count; i++) {
+            int64_t inside = price[i] >= cutoff;
+            depth_lots += qty[i] & -inside;
+            in_band += static_cast<int>(inside);
+        }
+    } else {
+        for (int i = 0; i < count; i++) {
+            int64_t inside = price[i] <= cutoff;
+            depth_lots += qty[i] & -inside;
+            in_band += static_cast<int>(inside);
+        }
+    }
+
+    // VWAP: walk the levels until the target size is filled
+    int used = 0;
+    double vwap = 0.0;
+    if (target_lots > 0) {
+        double notional = 0.0;
+        int64_t remaining = target_lots;
+        for (; used < count && remaining > 0; used++) {
+            int64_t take = std::min(remaining, qty[used]);
+            notional += static_cast<double>(take) * static_cast<double>(price[used]);
+            remaining -= take;
+        }
+        if (remaining == 0) vwap = notional / static_cast<double>(target_lots);
+    }
+
+    side.top_lots = top_lots;
+    side.depth_lots = depth_lots;
+    side.vwap = vwap;
+
+    // Levels the features read: the top N, the first level outside the band, the VWAP's
+    // last level. Reading to the end of the side means an appended level matters too.
+    int reach = std::max({top, in_band + 1, used});
+    side.reach = reach >= count ? ALWAYS : reach;
+}
@@ -10,6 +10,10 @@ bool SymbolManager::add_symbol(const std::string& symbol) {
     auto result = subscribed_symbols_.insert(symbol);
     
     if (result.second) {  // New symbol added
+        uint32_t id = SymbolRegistry::get_instance().intern(symbol);
+        if (id != SymbolRegistry::INVALID_ID) {
+            subscribed_flags_[id].store(true, std::memory_order_release);
+        }
         std::cout << "✓ Added new symbol: " << symbol 
                   << " (total: " << subscribed_symbols_.size() << ")\n";
         return true;
@@ -21,6 +25,7 @@ bool SymbolManager::add_symbol(const std::string& symbol) {
 // THREAD-SAFE: Checks if we are currently watching a specific symbol.
 // Returns true if the symbol exists in our set, false otherwise.
 // Used before trading to ensure we actually have data for this coin.
+// Cold path - the trading loop uses the lock-free is_subscribed(uint32_t) overload.
 bool SymbolManager::is_subscribed(const std::string& symbol) const {
     std::lock_guard<std::mutex> lock(mutex_);
     return subscribed_symbols_.find(symbol) != subscribed_symbols_.end();
@@ -0,0 +1,39 @@
+#include "core/SymbolRegistry.h"
+#include <iostream>
+
+SymbolRegistry& SymbolRegistry::get_instance() {
+    static SymbolRegistry instance;
+    return instance;
+}
+
+// THREAD-SAFE (cold path): Interns a symbol and returns its dense ID.
+// The name is stored before count_ is bumped, so lock-free readers of name(id)
+// for any id < size() always see a fully written string.
+uint32_t SymbolRegistry::intern(std::string_view symbol) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = ids_.find(symbol);
+    if (it != ids_.end()) return it->second;
+
+    uint32_t id = count_.load(std::memory_order_relaxed);
+    if (id >= MAX_SYMBOLS) {
+        std::cerr << "❌ SymbolRegistry full (" << MAX_SYMBOLS << "), cannot add " << symbol << "\n";
+        return INVALID_ID;
+    }
+
+    names_[id] = std::string(symbol);
+    ids_.emplace(names_[id], id);
+    count_.store(id + 1, std::memory_order_release);
+    return id;
+}
+
+// THREAD-SAFE (cold path): Name -> ID lookup without creating anything.
+uint32_t SymbolRegistry::find(std::string_view symbol) const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = ids_.find(symbol);
+    return it != ids_.end() ? it->second : INVALID_ID;
+}
+
+// LOCK-FREE: ID -> name. Only valid for IDs returned by intern().
+const std::string& SymbolRegistry::name(uint32_t id) const {
+    return names_[id];
+}
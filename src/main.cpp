@@ -6,12 +6,30 @@
 #include <chrono>
 
 #include "config/BotConfiguration.h"
+#include "core/Instrument.h"
 #include "core/OrderBookManager.h"
 #include "core/SymbolManager.h"
 #include "network/BybitWebSocketClient.h"
+#include "network/BybitRestClient.h"
+#include "network/RestBootstrap.h"
+#include "network/FeedHandlerPool.h"
 #include "trading/TradingEngine.h"
+#include "trading/EngineScheduler.h"
+#include "trading/OrderStateTable.h"
+#include "trading/RiskGate.h"
 #include "utils/DataLogger.h"
+#include "utils/LatencyRecorder.h"
+#include "utils/MemoryPlacement.h"
+#include "utils/PerformanceMonitor.h"
+#include "utils/TelemetrySegment.h"
+#include "utils/ThreadAffinity.h"
+#include "utils/Tsc.h"
 #include "messaging/AeronPublisher.h"
+#include "messaging/GlobalMediaDriver.h"
+#include <concurrent/BackOffIdleStrategy.h>
+#include <concurrent/BusySpinIdleStrategy.h>
+#include <concurrent/SleepingIdleStrategy.h>
+#include <concurrent/YieldingIdleStrategy.h>
 
 // Global shutdown flag
 std::atomic<bool> g_running{true};
@@ -21,6 +39,31 @@ void signal_handler(int signum) {
     g_running = false;
 }
 
+// NUMA node of the hot threads: the first pinned feed thread's, else the first pinned
+// engine worker's (-1 if neither is pinned)
+static int hot_numa_node(const BotConfiguration& config) {
+    for (const std::vector<int>* cores : {&config.feed_shard_cores, &config.engine_worker_cores}) {
+        for (int core : *cores) {
+            if (core >= 0) return thread_affinity::numa_node_of_core(core);
+        }
+    }
+    return -1;
+}
+
+// Aeron service loop: poll() until shutdown, idling between passes that found no work
+template <typename Poll>
+static void run_aeron_service(AeronIdle mode, Poll&& poll) {
+    auto loop = [&](auto&& idle) {
+        while (g_running.load(std::memory_order_relaxed)) idle.idle(poll());
+    };
+    switch (mode) {
+        case AeronIdle::SPIN: loop(aeron::concurrent::BusySpinIdleStrategy()); break;
+        case AeronIdle::YIELD: loop(aeron::concurrent::YieldingIdleStrategy()); break;
+        case AeronIdle::BACKOFF: loop(aeron::concurrent::BackoffIdleStrategy()); break;
+        case AeronIdle::SLEEP: loop(aeron::concurrent::SleepingIdleStrategy(std::chrono::milliseconds(1))); break;
+    }
+}
+
 int main() {
     // 1. Setup signal handlers
     std::signal(SIGINT, signal_handler);
@@ -32,20 +75,103 @@ int main() {
 
     // 2. Initialize core components
     BotConfiguration config;
-    DataLogger data_logger;
+
+    // Memory first: everything allocated from here on (books, rings, engines, Aeron
+    // buffers) comes from the hot threads' NUMA node, the big regions on huge pages
+    memory_placement::set_huge_pages(config.huge_pages);
+    if (config.numa_local_memory) {
+        int node = config.numa_node >= 0 ? config.numa_node : hot_numa_node(config);
+        if (memory_placement::prefer_node(node)) {
+            std::cout << "✓ Hot-path memory on NUMA node " << node << "\n";
+        }
+    }
+
+    DataLogger data_logger("trading_data.log", config.log_options);
     OrderBookManager orderbook_manager;
     SymbolManager symbol_manager;
 
-    // 3. Initialize Aeron Publisher
+    // Latency stamps are TSC ticks: calibrate once here, before any hot path runs
+    LatencyRecorder::get_instance().set_enabled(config.latency_tracking);
+    if (config.latency_tracking) {
+        std::cout << "✓ TSC calibrated: " << tsc::calibration().ns_per_tick << " ns/tick\n";
+    }
+
+    // Counters for external readers (telemetry_spy); engines bind their slots when built
+    if (config.telemetry_enabled) {
+        std::string instance = config.telemetry_instance.empty() ? std::to_string(getpid())
+                                                                 : config.telemetry_instance;
+        telemetry::TelemetrySegment::get_instance().open(
+            config.telemetry_dir + "/trading_bot." + instance + ".telemetry", instance);
+    }
+
+    // Tick/lot grids must be known before any book or engine is built on them;
+    // instruments, open orders and positions are fetched together
+    RestBootstrap::Result bootstrap = RestBootstrap(config).run();
+    std::cout << "✓ Instrument metadata for " << BybitRestClient::register_instruments(bootstrap.instruments)
+              << " symbols\n";
+
+    // Open orders of the previous run, re-keyed to this run's symbol IDs before any engine reads its slot
+    OrderStateTable& order_state = OrderStateTable::get_instance();
+    if (!order_state.open(config.order_state_path)) {
+        std::cerr << "⚠️  Order state is not persisted: a restart will not recover open orders\n";
+    }
+
+    // The exchange's view against the recovered records (the engines resume from the table)
+    if (bootstrap.snapshots_ok) {
+        for (const auto& symbol : config.symbols) {
+            OpenOrder record;
+            bool in_table = order_state.load(SymbolRegistry::get_instance().intern(symbol), record);
+            const ExchangePosition* position = bootstrap.find_position(symbol);
+            size_t orders = bootstrap.count_open_orders(symbol);
+            if (position || orders > 0) {
+                std::cout << "  ↳ Exchange " << symbol << ": " << orders << " open orders";
+                if (position) std::cout << ", " << position->side << " " << position->size << " @ " << position->avg_price;
+                std::cout << "\n";
+            }
+            bool table_holds = in_table && (record.state == OrderSlotState::POSITION ||
+                                            record.state == OrderSlotState::CLOSING);
+            if (table_holds != (position != nullptr)) {
+                std::cerr << "⚠️  " << symbol << ": order state says "
+                          << (in_table ? order_slot_state_name(record.state) : "EMPTY")
+                          << " but the exchange has " << (position ? "a position" : "no position") << "\n";
+            }
+        }
+    }
+
+    // 3. Initialize Aeron Publisher (order records; each feed shard publishes its books)
+    GlobalMediaDriver::get_instance().configure(config.media_driver);
+    bool aeron_invoker = config.enable_aeron && config.media_driver.threading == DriverThreading::INVOKER;
+    AeronPublishOptions order_publish = config.aeron_order_publish;
+    order_publish.conductor_invoker = aeron_invoker;
     auto aeron_publisher = std::make_shared<AeronPublisher>(
         config.aeron_channel, 
-        config.orderbook_stream_id
+        config.signal_stream_id,
+        order_publish
     );
+
+    // Aeron service thread (INVOKER): runs the driver's duty cycle and, once init() hands
+    // it over, the order publisher's client conductor. It starts before any publisher:
+    // a publisher cannot connect to a driver nobody runs.
+    std::atomic<bool> aeron_client_ready{false};
+    std::thread aeron_service_thread;
+    if (aeron_invoker) {
+        aeron_service_thread = std::thread([&]() {
+            std::cout << "  ✓ Aeron service thread started"
+                      << thread_affinity::apply_placement("aeron-service", config.aeron_service_thread) << "\n";
+            run_aeron_service(config.aeron_service_idle, [&]() {
+                int work = GlobalMediaDriver::get_instance().do_work();
+                if (aeron_client_ready.load(std::memory_order_acquire)) work += aeron_publisher->service_context();
+                return work;
+            });
+            std::cout << "  ✓ Aeron service thread stopped\n";
+        });
+    }
     
     bool aeron_enabled = false;
     if (config.enable_aeron) {
         if (aeron_publisher->init()) {
             aeron_enabled = true;
+            aeron_client_ready.store(true, std::memory_order_release);
             std::cout << "✅ Aeron IPC enabled\n";
         } else {
             std::cerr << "⚠️  Aeron init failed. Running in standalone mode.\n";
@@ -53,13 +179,12 @@ int main() {
     }
 
     // 4. Initialize WebSocket Clients
-    // Public Channel: Market Data (Orderbook)
-    BybitWebSocketClient public_client(
+    // Public Channel: Market Data (Orderbook), sharded over several connections
+    FeedHandlerPool feed_pool(
         orderbook_manager, 
         symbol_manager, 
         config, 
-        data_logger, 
-        BybitWebSocketClient::ChannelType::PUBLIC
+        data_logger
     );
     
     // Private Channel: Order Execution & Updates
@@ -79,24 +204,30 @@ int main() {
         BybitWebSocketClient::ChannelType::PRIVATE_STREAM 
     );
 
+    // Order prices/quantities are encoded on each trading symbol's grid
+    std::vector<std::string> trading_symbols = config.symbols;
+    if (trading_symbols.empty()) trading_symbols.push_back("BTCUSDT");
+    for (const auto& symbol : trading_symbols) {
+        trade_client.set_instrument(symbol, InstrumentRegistry::get_instance().get(symbol));
+    }
+
     // 5. Connect WebSocket clients
     std::cout << "\n🔌 Connecting to Bybit WebSocket...\n";
-    public_client.connect();
+    feed_pool.connect();
     trade_client.connect();  
     stream_client.connect(); 
 
-    // 6. Start WebSocket service threads
-    std::thread public_thread([&]() { 
-        std::cout << "  ✓ Public WS thread started\n";
-        public_client.run(); 
-    });
+    // 6. Start WebSocket service threads (one per public shard)
+    feed_pool.start();
     
     std::thread trade_thread([&]() { 
-        std::cout << "  ✓ Trade WS thread started\n";
+        std::cout << "  ✓ Trade WS thread started"
+                  << thread_affinity::apply_placement("trade-ws", config.trade_thread) << "\n";
         trade_client.run(); 
     });
     std::thread stream_thread([&]() { 
-        std::cout << "  ✓ Stream WS thread started\n";
+        std::cout << "  ✓ Stream WS thread started"
+                  << thread_affinity::apply_placement("stream-ws", config.stream_thread) << "\n";
         stream_client.run(); 
     });
 
@@ -105,7 +236,7 @@ int main() {
     // 7. Wait for WebSocket connections
     std::cout << "⏳ Waiting for WebSocket connections";
     int connection_timeout = 0;
-    while ((!public_client.is_connected() || !trade_client.is_connected() || !stream_client.is_connected()) && g_running) {
+    while ((!feed_pool.all_connected() || !trade_client.is_connected() || !stream_client.is_connected()) && g_running) {
         if (connection_timeout++ > 100) {  // 10 second timeout
             std::cerr << "\n❌ Connection timeout. Exiting.\n";
             g_running = false;
@@ -117,10 +248,12 @@ int main() {
     std::cout << " ✅ Connected!\n";
 
     if (!g_running) {
-        public_client.stop();
+        feed_pool.stop();
         trade_client.stop();
-        if (public_thread.joinable()) public_thread.join();
+        stream_client.stop();
         if (trade_thread.joinable()) trade_thread.join();
+        if (stream_thread.joinable()) stream_thread.join();
+        if (aeron_service_thread.joinable()) aeron_service_thread.join();
         return 1;
     }
 
@@ -128,90 +261,132 @@ int main() {
     std::cout << "\n🔐 Authenticating...\n";
     trade_client.authenticate();
     stream_client.authenticate();
-    std::this_thread::sleep_for(std::chrono::seconds(2));  // Wait for auth response
-
-    // 9. Subscribe to trading symbol
-    std::string trading_symbol = config.symbols.empty() ? "BTCUSDT" : config.symbols[0];
-    std::cout << "📡 Subscribing to " << trading_symbol << "...\n";
-    public_client.subscribe_to_symbol(trading_symbol);
-    std::cout << "📡 Subscribing to private execution stream...\n";
-    stream_client.subscribe_to_private_topics();
-    std::this_thread::sleep_for(std::chrono::milliseconds(1500));  // Wait for initial data
-
-    // 10. Initialize Trading Engine
-    std::cout << "\n🤖 Initializing Trading Engine...\n";
-    TradingEngine engine(
-        trading_symbol,
+
+    // 9. Subscribe the public books while the auth round-trip is in flight:
+    // one bulk request, packed into frames and spread over the shards
+    std::vector<std::string> feed_symbols = trading_symbols;
+    std::vector<std::string> all_symbols;
+    if (config.fetch_all_symbols) {
+        // Full-universe mode: every linear USDT contract
+        all_symbols = BybitRestClient::usdt_symbols(bootstrap.instruments);
+        feed_symbols.insert(feed_symbols.end(), all_symbols.begin(), all_symbols.end());
+    }
+    feed_pool.subscribe_to_symbols(feed_symbols);
+    if (!all_symbols.empty()) data_logger.log_symbol_subscription(all_symbols);
+
+    // Wait for the auth responses themselves (not a fixed sleep)
+    auto auth_deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+    while (g_running && (!trade_client.is_authenticated() || !stream_client.is_authenticated()) &&
+           std::chrono::steady_clock::now() < auth_deadline) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    if (!trade_client.is_authenticated() || !stream_client.is_authenticated()) {
+        std::cerr << "⚠️  Private channel authentication not confirmed\n";
+    }
+
+    // Every subscription acked and every book holding its first snapshot
+    feed_pool.wait_until_warm(std::chrono::seconds(10), g_running);
+
+    // Shared by every engine's send path, so the exchange never sees more than our limits
+    RiskLimits risk_limits = config.risk_limits;
+    risk_limits.global_orders_per_second = config.max_orders_per_second;
+    RiskGate::get_instance().configure(risk_limits);
+
+    // 10. Initialize Trading Engines (one per symbol, scheduled on a worker pool)
+    std::cout << "\n🤖 Initializing Trading Engines...\n";
+    EngineScheduler scheduler(
         orderbook_manager,
         symbol_manager,
         data_logger,
+        config,
         &trade_client,
         aeron_publisher
     );
-
-    stream_client.set_order_update_callback(
-        [&engine](const std::string& id, const std::string& status, const std::string& sym) {
-            engine.on_order_update(id, status);
-        }
-    );
-
-    // 11. [CRITICAL FIX] Start Aeron service thread
-    std::thread aeron_service_thread;
-    if (aeron_enabled) {
-        aeron_service_thread = std::thread([&]() {
-            std::cout << "  ✓ Aeron service thread started\n";
-            while (g_running) {
-                // Service Aeron context to prevent timeout
-                if (aeron_publisher) {
-                    aeron_publisher->service_context();
-                }
-                std::this_thread::sleep_for(std::chrono::milliseconds(50));
-            }
-            std::cout << "  ✓ Aeron service thread stopped\n";
-        });
+    for (const auto& symbol : trading_symbols) {
+        scheduler.add_engine(symbol);
     }
 
-    // 12. Main Trading Loop
+    // Execution reports from both private channels are routed by symbol
+    scheduler.attach(trade_client);
+    scheduler.attach(stream_client);
+    scheduler.wait_for_market_data(std::chrono::seconds(10));
+
+    // 11. Main Trading Loop
     std::cout << "\n✅ SYSTEM ACTIVE - Running HFT Loop\n";
     std::cout << "═══════════════════════════════════════\n\n";
 
-    uint64_t loop_count = 0;
+    scheduler.start();
     auto last_stats = std::chrono::steady_clock::now();
 
+    PerformanceMonitor perf_monitor(feed_pool, orderbook_manager, data_logger, config);
+    perf_monitor.attach_scheduler(scheduler);
+    perf_monitor.attach_private_client(trade_client);
+    perf_monitor.attach_private_client(stream_client);
+    if (aeron_enabled) perf_monitor.attach_aeron(*aeron_publisher);
+    std::thread perf_thread([&]() {
+        std::string placed = thread_affinity::apply_placement("perf-monitor", config.perf_thread);
+        if (!placed.empty()) std::cout << "  ✓ Performance monitor started" << placed << "\n";
+        perf_monitor.run();
+    });
+
+    // Every other thread is running: placing this one now cannot leak its affinity or
+    // scheduling policy into them
+    std::string main_placed = thread_affinity::apply_placement("", config.main_thread);
+    if (!main_placed.empty()) std::cout << "  ✓ Main loop" << main_placed << "\n";
+
     while (g_running) {
-        // Run trading cycle
-        engine.run_trading_cycle();
-        
+        std::this_thread::sleep_for(std::chrono::milliseconds(100));
+
         // Print periodic stats
-        loop_count++;
         auto now = std::chrono::steady_clock::now();
         if (std::chrono::duration_cast<std::chrono::seconds>(now - last_stats).count() >= 30) {
             std::cout << "\n📈 System Stats:\n";
-            std::cout << "  Loops: " << loop_count << "\n";
-            std::cout << "  WS Messages: " << public_client.get_message_count() << "\n";
+            std::cout << "  Engine cycles: " << scheduler.get_cycles()
+                      << " (timer " << scheduler.get_timer_ticks()
+                      << ", stolen " << scheduler.get_steals() << ")\n";
+            std::cout << "  WS Messages: " << feed_pool.get_message_count() << "\n";
+            std::cout << "  Hot-path allocations: " << feed_pool.get_hot_path_allocations() << "\n";
+            std::cout << "  Risk gate: " << RiskGate::get_instance().get_passed() << " passed, "
+                      << RiskGate::get_instance().get_rejected_total() << " refused\n";
+            std::cout << "  Book resyncs: " << feed_pool.get_resync_count() << "\n";
+            if (feed_pool.line_count() > 1) {
+                std::cout << "  A/B lines: " << feed_pool.line_count() << " per shard, "
+                          << feed_pool.get_duplicate_count() << " duplicate updates dropped\n";
+            }
+            std::cout << "  Reconnects: " << feed_pool.get_reconnect_count() << " public, "
+                      << trade_client.get_reconnect_count() + stream_client.get_reconnect_count()
+                      << " private (worst recovery " << feed_pool.get_max_recovery_ms() << "ms)\n";
+            if (config.capture_enabled) {
+                std::cout << "  Captured frames: " << feed_pool.get_captured_frames() << "\n";
+            }
             if (aeron_enabled) {
-                std::cout << "  Aeron Published: " << aeron_publisher->get_messages_sent() << "\n";
+                std::cout << "  Aeron Published: " << feed_pool.get_aeron_count() << " books ("
+                          << feed_pool.get_aeron_deltas() << " deltas, "
+                          << feed_pool.get_aeron_conflated() << " conflated, "
+                          << feed_pool.get_aeron_backpressure() << " dropped), "
+                          << aeron_publisher->get_messages_sent() << " orders\n";
                 std::cout << "  Aeron Connected: " << (aeron_publisher->is_connected() ? "YES" : "NO") << "\n";
             }
             std::cout << "\n";
             last_stats = now;
         }
-        
-        // Small sleep to prevent 100% CPU usage
-        std::this_thread::sleep_for(std::chrono::microseconds(500));
     }
 
-    // 13. Graceful Shutdown
+    // 12. Graceful Shutdown
     std::cout << "\n🔻 Shutting down gracefully...\n";
+
+    // Stop the engines before their connections go away
+    scheduler.stop();
+    perf_monitor.stop();
+    if (perf_thread.joinable()) perf_thread.join();
     
     // Stop WebSocket clients
-    public_client.stop();
     trade_client.stop();
     stream_client.stop();
     
     // Wait for threads to finish
     std::cout << "  ⏳ Waiting for WebSocket threads...\n";
-    if (public_thread.joinable()) public_thread.join();
+    feed_pool.stop();
     if (trade_thread.joinable()) trade_thread.join();
     if (stream_thread.joinable()) stream_thread.join();
     std::cout << "  ✓ WebSocket threads stopped\n";
@@ -224,11 +399,12 @@ int main() {
     
     // Final stats
     std::cout << "\n📊 Final Statistics:\n";
-    std::cout << "  Total Loops: " << loop_count << "\n";
-    std::cout << "  WS Messages: " << public_client.get_message_count() << "\n";
+    std::cout << "  Engine Cycles: " << scheduler.get_cycles() << "\n";
+    std::cout << "  WS Messages: " << feed_pool.get_message_count() << "\n";
     if (aeron_enabled) {
         std::cout << "  Aeron Published: " << aeron_publisher->get_messages_sent() << "\n";
     }
+    perf_monitor.report();
     
     std::cout << "\n✅ Clean shutdown complete. Goodbye!\n";
     return 0;
@@ -3,11 +3,13 @@
 #include <iostream>
 #include <thread>
 #include <chrono>
-#include <sstream>
-#include <iomanip>
+#include <algorithm>
+#include <cstring>
 
-AeronPublisher::AeronPublisher(const std::string& channel, int32_t stream_id)
-    : channel_(channel), stream_id_(stream_id) {}
+AeronPublisher::AeronPublisher(const std::string& channel, int32_t stream_id, const AeronPublishOptions& options)
+    : channel_(channel), stream_id_(stream_id), options_(options) {
+    options_.conflation_slot_bytes = std::min<size_t>(options_.conflation_slot_bytes, UINT16_MAX);
+}
 
 // ============================================================================
 // INITIALIZATION
@@ -23,6 +25,7 @@ bool AeronPublisher::init() {
         
         // [FIX] Set pre-touch mapped memory to prevent page faults
         context.preTouchMappedMemory(true);
+        context.useConductorAgentInvoker(options_.conductor_invoker);
         
         aeron_ = aeron::Aeron::connect(context);
 
@@ -39,6 +42,7 @@ bool AeronPublisher::init() {
 
     // Wait for publication to be ready
     for (int i = 0; i < 100; ++i) {
+        service_context();      // Nobody else runs an invoker conductor before init() returns
         publication_ = aeron_->findPublication(pub_id);
         if (publication_) {
             break;
@@ -54,6 +58,15 @@ bool AeronPublisher::init() {
 
     std::this_thread::sleep_for(std::chrono::milliseconds(50));
 
+    // Everything the hot path may touch is allocated here
+    max_claim_ = static_cast<size_t>(publication_->maxPayloadLength());
+    fragment_scratch_ = std::make_unique<char[]>(MAX_MESSAGE_BYTES);
+    if (options_.policy == BackPressurePolicy::CONFLATE && options_.conflation_slot_bytes > 0) {
+        parked_ = std::make_unique<char[]>(SymbolRegistry::MAX_SYMBOLS * options_.conflation_slot_bytes);
+        parked_length_ = std::make_unique<uint16_t[]>(SymbolRegistry::MAX_SYMBOLS);
+        parked_symbols_.reserve(SymbolRegistry::MAX_SYMBOLS);
+    }
+
     std::cout << "✓ Aeron publisher ready: "
               << channel_ << " stream " << stream_id_ 
               << " (connected: " << (publication_->isConnected() ? "YES" : "NO") << ")\n";
@@ -67,85 +80,42 @@ bool AeronPublisher::init() {
 
 // ============================================================================
 // [CRITICAL FIX] SERVICE CONTEXT
-// This prevents the "timeout between service calls" error
+// This prevents the "timeout between service calls" error: an invoker conductor
+// only sends keepalives and handles driver responses when it is invoked
 // ============================================================================
-void AeronPublisher::service_context() {
-    if (aeron_) {
-        // Poll the Aeron context to keep it alive
-        aeron_->conductorAgentInvoker().invoke();
+int AeronPublisher::service_context() {
+    if (aeron_ && options_.conductor_invoker) {
+        return aeron_->conductorAgentInvoker().invoke();
     }
+    return 0;
 }
 
 // ============================================================================
 // PUBLISH METHODS
 // ============================================================================
-bool AeronPublisher::publish_order(const AeronOrderRecord& order) {
-    // Serialize order to string
-    std::string serialized = serialize_order(order);
-    
-    // Try to publish to Aeron
-    bool published = publish(serialized.c_str(), serialized.length());
-    
-    // Always save to in-memory buffer
-    {
-        std::lock_guard<std::mutex> lock(buffer_mutex_);
-        order_buffer_[order.symbol] = order;
-    }
-    
-    return published;
-}
-
 bool AeronPublisher::publish_orderbook(const char* buffer, size_t length) {
     return publish(buffer, length);
 }
 
 // ============================================================================
-// BUFFER MANAGEMENT
+// CORE PUBLISH METHOD (BACK-PRESSURE POLICY)
 // ============================================================================
-bool AeronPublisher::has_order_in_buffer(const std::string& symbol) const {
-    std::lock_guard<std::mutex> lock(buffer_mutex_);
-    auto it = order_buffer_.find(symbol);
-    return (it != order_buffer_.end() && it->second.is_active);
-}
-
-AeronOrderRecord AeronPublisher::get_order_from_buffer(const std::string& symbol) const {
-    std::lock_guard<std::mutex> lock(buffer_mutex_);
-    auto it = order_buffer_.find(symbol);
-    if (it != order_buffer_.end()) {
-        return it->second;
-    }
-    return AeronOrderRecord{};
-}
+bool AeronPublisher::publish(const char* buffer, size_t length, uint32_t symbol_id) {
+    if (!publication_) return false;
 
-void AeronPublisher::remove_order_from_buffer(const std::string& symbol) {
-    std::lock_guard<std::mutex> lock(buffer_mutex_);
-    auto it = order_buffer_.find(symbol);
-    if (it != order_buffer_.end()) {
-        it->second.is_active = false;
+    if (is_parked(symbol_id)) {
+        flush();
+        if (is_parked(symbol_id)) {
+            return park(symbol_id, aeron::BACK_PRESSURED, length, [&](char* slot, size_t) {
+                std::memcpy(slot, buffer, length);
+                return length;
+            });
+        }
     }
-}
-
-void AeronPublisher::update_order_in_buffer(const std::string& symbol, const AeronOrderRecord& order) {
-    std::lock_guard<std::mutex> lock(buffer_mutex_);
-    order_buffer_[symbol] = order;
-}
 
-std::unordered_map<std::string, AeronOrderRecord> AeronPublisher::get_all_orders() const {
-    std::lock_guard<std::mutex> lock(buffer_mutex_);
-    return order_buffer_;
-}
-
-// ============================================================================
-// CORE PUBLISH METHOD (FIXED WITH BACK PRESSURE)
-// ============================================================================
-bool AeronPublisher::publish(const char* buffer, size_t length) {
-    if (!publication_) return false;
-    // [FIX] Handle back pressure with retry
-    int retry_count = 0;
-    const int max_retries = 3;
-    
-    while (retry_count < max_retries) {
-        const auto result = publication_->offer(
+    uint32_t attempts = 0;
+    for (;;) {
+        int64_t result = publication_->offer(
             aeron::concurrent::AtomicBuffer(
                 reinterpret_cast<std::uint8_t*>(const_cast<char*>(buffer)),
                 static_cast<std::int32_t>(length)));
@@ -154,20 +124,37 @@ bool AeronPublisher::publish(const char* buffer, size_t length) {
             messages_sent_.fetch_add(1, std::memory_order_relaxed);
             return true;
         }
-        
-        // Handle back pressure
-        if (result == aeron::BACK_PRESSURED || result == aeron::NOT_CONNECTED) {
-            retry_count++;
-            std::this_thread::sleep_for(std::chrono::microseconds(100));
+        if (should_retry(result, attempts)) {
+            cpu_pause();
             continue;
         }
-        
-        // Other error
-        break;
+        return park(symbol_id, result, length, [&](char* slot, size_t) {
+            std::memcpy(slot, buffer, length);
+            return length;
+        });
     }
+}
 
-    offer_failures_.fetch_add(1, std::memory_order_relaxed);
-    return false;
+// Parked messages leave in the order they were parked; a symbol that still does not
+// fit stays parked (and so do the ones behind it, to keep trying the oldest first)
+void AeronPublisher::flush() {
+    if (parked_symbols_.empty() || !publication_) return;
+
+    size_t sent = 0;
+    for (; sent < parked_symbols_.size(); sent++) {
+        uint32_t symbol_id = parked_symbols_[sent];
+        int64_t result = publication_->offer(
+            aeron::concurrent::AtomicBuffer(reinterpret_cast<std::uint8_t*>(parked_slot(symbol_id)),
+                                            static_cast<std::int32_t>(parked_length_[symbol_id])));
+        if (result <= 0) {
+            if (is_back_pressure(result)) break;
+            offer_failures_.fetch_add(1, std::memory_order_relaxed);    // Not connected: gone
+        } else {
+            messages_sent_.fetch_add(1, std::memory_order_relaxed);
+        }
+        parked_length_[symbol_id] = 0;
+    }
+    parked_symbols_.erase(parked_symbols_.begin(), parked_symbols_.begin() + static_cast<std::ptrdiff_t>(sent));
 }
 
 bool AeronPublisher::is_connected() const {
@@ -178,20 +165,10 @@ uint64_t AeronPublisher::get_messages_sent() const {
     return messages_sent_.load(std::memory_order_relaxed);
 }
 
-// ============================================================================
-// SERIALIZATION
-// ============================================================================
-std::string AeronPublisher::serialize_order(const AeronOrderRecord& order) {
-    std::stringstream ss;
-    ss << std::fixed << std::setprecision(8);
-    ss << "ORDER|"
-       << order.order_id << "|"
-       << order.symbol << "|"
-       << order.price << "|"
-       << order.quantity << "|"
-       << order.side << "|"
-       << order.timestamp << "|"
-       << (order.is_active ? "1" : "0");
-    
-    return ss.str();
-}
\ No newline at end of file
+uint64_t AeronPublisher::get_offer_failures() const {
+    return offer_failures_.load(std::memory_order_relaxed);
+}
+
+uint64_t AeronPublisher::get_conflated_count() const {
+    return conflated_.load(std::memory_order_relaxed);
+}
@@ -0,0 +1,154 @@
+#include "messaging/BookPublication.h"
+#include "messaging/SBEEncoder.h"
+#include "utils/Tsc.h"
+#include <algorithm>
+#include <chrono>
+
+BookPublication::BookPublication(AeronPublisher& publisher, const BookPublishOptions& options)
+    : publisher_(publisher), options_(options) {
+    double ticks_per_ns = 1.0 / tsc::calibration().ns_per_tick;
+    window_ticks_ = static_cast<uint64_t>(options_.conflation_us * 1000.0 * ticks_per_ns);
+    snapshot_ticks_ = static_cast<uint64_t>(options_.snapshot_interval_ms * 1e6 * ticks_per_ns);
+}
+
+void BookPublication::add_symbol(Symbol& symbol) {
+    symbol.snapshot_due = true;
+    dirty_.reserve(++symbols_);
+}
+
+// ============================================================================
+// HOT PATH (service thread)
+// ============================================================================
+
+void BookPublication::on_update(Symbol& symbol, bool exchange_snapshot) {
+    symbol.snapshot_due |= exchange_snapshot;
+
+    uint64_t now = tsc::now();
+    if (now - symbol.last_publish_tick >= window_ticks_ && publish(symbol, now)) {
+        symbol.dirty = false;           // Dropped from dirty_ by the next flush()
+        return;
+    }
+
+    conflated_updates_.fetch_add(1, std::memory_order_relaxed);
+    if (!symbol.dirty) {
+        symbol.dirty = true;
+        dirty_.push_back(&symbol);      // Capacity reserved by add_symbol()
+    }
+}
+
+void BookPublication::flush() {
+    if (dirty_.empty()) return;
+
+    uint64_t now = tsc::now();
+    size_t kept = 0;
+    for (Symbol* symbol : dirty_) {
+        if (!symbol->dirty) continue;
+        if (now - symbol->last_publish_tick >= window_ticks_ && publish(*symbol, now)) {
+            symbol->dirty = false;
+            continue;
+        }
+        dirty_[kept++] = symbol;
+    }
+    dirty_.resize(kept);
+}
+
+bool BookPublication::publish(Symbol& symbol, uint64_t now_tick) {
+    PriceLevel bids[DEPTH];
+    PriceLevel asks[DEPTH];
+    OrderBook::View top = symbol.book->copy_top(bids, asks, DEPTH);
+
+    // Nothing to mirror until the book is resynced; that resync brings a snapshot
+    if (!top.valid) {
+        symbol.snapshot_due = true;
+        return true;
+    }
+
+    bool snapshot = options_.mode == BookPublishMode::SNAPSHOT || !symbol.has_baseline ||
+                    symbol.snapshot_due || now_tick - symbol.last_snapshot_tick >= snapshot_ticks_;
+    return snapshot ? publish_snapshot(symbol, top, now_tick) : publish_delta(symbol, top, now_tick);
+}
+
+bool BookPublication::publish_snapshot(Symbol& symbol, const OrderBook::View& top, uint64_t now_tick) {
+    size_t length = SBEEncoder::book_snapshot_length(static_cast<size_t>(top.bid_count),
+                                                     static_cast<size_t>(top.ask_count), symbol.symbol.size());
+    uint64_t timestamp = timestamp_ns();
+
+    // Snapshot-only streams may be conflated by the publisher itself; a delta stream must
+    // not have a parked snapshot overtaken by the deltas behind it
+    uint32_t conflation_key = options_.mode == BookPublishMode::SNAPSHOT ? symbol.symbol_id
+                                                                         : SymbolRegistry::INVALID_ID;
+    bool sent = publisher_.publish_claim(conflation_key, length, [&](char* buffer, size_t capacity) {
+        return SBEEncoder::encode_book_snapshot(buffer, capacity, timestamp, symbol.symbol_id, symbol.symbol,
+                                                symbol.book->instrument(), top, DEPTH);
+    });
+    if (!sent) return false;
+
+    std::copy_n(top.bids, top.bid_count, symbol.bids);
+    std::copy_n(top.asks, top.ask_count, symbol.asks);
+    symbol.bid_count = top.bid_count;
+    symbol.ask_count = top.ask_count;
+    symbol.update_id = top.update_id;
+    symbol.has_baseline = true;
+    symbol.snapshot_due = false;
+    symbol.last_snapshot_tick = now_tick;
+    symbol.last_publish_tick = now_tick;
+    snapshots_sent_.fetch_add(1, std::memory_order_relaxed);
+    return true;
+}
+
+bool BookPublication::publish_delta(Symbol& symbol, const OrderBook::View& top, uint64_t now_tick) {
+    PriceLevel bid_changes[2 * DEPTH];
+    PriceLevel ask_changes[2 * DEPTH];
+    int bid_changed = diff_side(symbol.bids, symbol.bid_count, top.bids, top.bid_count, true, bid_changes);
+    int ask_changed = diff_side(symbol.asks, symbol.ask_count, top.asks, top.ask_count, false, ask_changes);
+
+    // The update was deeper than the published view: nothing to say
+    if (bid_changed == 0 && ask_changed == 0) return true;
+
+    std::span<const PriceLevel> bids(bid_changes, static_cast<size_t>(bid_changed));
+    std::span<const PriceLevel> asks(ask_changes, static_cast<size_t>(ask_changed));
+    size_t length = SBEEncoder::book_delta_length(bids.size(), asks.size(), symbol.symbol.size());
+    uint64_t timestamp = timestamp_ns();
+
+    bool sent = publisher_.publish_claim(SymbolRegistry::INVALID_ID, length, [&](char* buffer, size_t capacity) {
+        return SBEEncoder::encode_book_delta(buffer, capacity, timestamp, symbol.symbol_id, symbol.symbol,
+                                             symbol.book->instrument(), bids, asks,
+                                             top.update_id, symbol.update_id, top.seq);
+    });
+    if (!sent) return false;        // Still dirty: the next diff includes these changes
+
+    std::copy_n(top.bids, top.bid_count, symbol.bids);
+    std::copy_n(top.asks, top.ask_count, symbol.asks);
+    symbol.bid_count = top.bid_count;
+    symbol.ask_count = top.ask_count;
+    symbol.update_id = top.update_id;
+    symbol.last_publish_tick = now_tick;
+    deltas_sent_.fetch_add(1, std::memory_order_relaxed);
+    return true;
+}
+
+// Merge walk over two sorted sides (bids descending, asks ascending): levels that are new
+// or changed carry their quantity, levels that left the view carry 0
+int BookPublication::diff_side(const PriceLevel* before, int before_count, const PriceLevel* after,
+                               int after_count, bool descending, PriceLevel* out) {
+    auto ahead = [descending](int64_t a, int64_t b) { return descending ? a > b : a < b; };
+
+    int i = 0, j = 0, n = 0;
+    while (i < before_count || j < after_count) {
+        if (j == after_count || (i < before_count && ahead(before[i].price, after[j].price))) {
+            out[n++] = {before[i++].price, 0};
+        } else if (i == before_count || ahead(after[j].price, before[i].price)) {
+            out[n++] = after[j++];
+        } else {
+            if (before[i].quantity != after[j].quantity) out[n++] = after[j];
+            i++;
+            j++;
+        }
+    }
+    return n;
+}
+
+uint64_t BookPublication::timestamp_ns() {
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::system_clock::now().time_since_epoch()).count());
+}
@@ -1,11 +1,13 @@
 #include "messaging/GlobalMediaDriver.h"
 #include <iostream>
 #include <chrono>
+#include <cstring>
+#include <string>
 #include <thread>
 
 GlobalMediaDriver* GlobalMediaDriver::singleton_instance = nullptr;
 
-GlobalMediaDriver::GlobalMediaDriver() 
+GlobalMediaDriver::GlobalMediaDriver()
     : driver(nullptr), driver_context(nullptr), is_initialized(false) {}
 
 GlobalMediaDriver& GlobalMediaDriver::get_instance() {
@@ -15,6 +17,34 @@ GlobalMediaDriver& GlobalMediaDriver::get_instance() {
     return *singleton_instance;
 }
 
+void GlobalMediaDriver::configure(const MediaDriverOptions& options) {
+    if (is_initialized) {
+        std::cerr << "⚠️  Media driver already running: new options ignored\n";
+        return;
+    }
+    options_ = options;
+}
+
+static aeron_threading_mode_t to_aeron(DriverThreading threading) {
+    switch (threading) {
+        case DriverThreading::DEDICATED: return AERON_THREADING_MODE_DEDICATED;
+        case DriverThreading::SHARED_NETWORK: return AERON_THREADING_MODE_SHARED_NETWORK;
+        case DriverThreading::SHARED: return AERON_THREADING_MODE_SHARED;
+        case DriverThreading::INVOKER: return AERON_THREADING_MODE_INVOKER;
+    }
+    return AERON_THREADING_MODE_SHARED;
+}
+
+static const char* threading_name(DriverThreading threading) {
+    switch (threading) {
+        case DriverThreading::DEDICATED: return "dedicated";
+        case DriverThreading::SHARED_NETWORK: return "shared network";
+        case DriverThreading::SHARED: return "shared";
+        case DriverThreading::INVOKER: return "invoker";
+    }
+    return "?";
+}
+
 bool GlobalMediaDriver::initialize() {
     if (is_initialized) {
         return true;
@@ -26,34 +56,74 @@ bool GlobalMediaDriver::initialize() {
         return false;
     }
 
+    // Threading mode and idle strategies must be set before the driver is built
+    aeron_driver_context_set_threading_mode(driver_context, to_aeron(options_.threading));
+    aeron_driver_context_set_conductor_idle_strategy(driver_context, aeron_idle_name(options_.conductor_idle));
+    aeron_driver_context_set_shared_idle_strategy(driver_context, aeron_idle_name(options_.conductor_idle));
+    aeron_driver_context_set_sharednetwork_idle_strategy(driver_context, aeron_idle_name(options_.sender_idle));
+    aeron_driver_context_set_sender_idle_strategy(driver_context, aeron_idle_name(options_.sender_idle));
+    aeron_driver_context_set_receiver_idle_strategy(driver_context, aeron_idle_name(options_.receiver_idle));
+    aeron_driver_context_set_agent_on_start_function(driver_context, &GlobalMediaDriver::on_agent_start, this);
+
     // Initialize driver
     if (aeron_driver_init(&driver, driver_context) < 0) {
         std::cerr << "Failed to init driver: " << aeron_errmsg() << "\n";
         aeron_driver_context_close(driver_context);
+        driver_context = nullptr;
         return false;
     }
 
-    // Start driver thread
-    driver_thread = std::thread([this]() {
-        while (driver) {
-            aeron_driver_main_do_work(driver);
-        }
-    });
+    // Aeron starts the agent threads of the mode; INVOKER leaves the duty cycle to do_work()
+    if (aeron_driver_start(driver, is_invoker()) < 0) {
+        std::cerr << "Failed to start driver: " << aeron_errmsg() << "\n";
+        aeron_driver_close(driver);
+        aeron_driver_context_close(driver_context);
+        driver = nullptr;
+        driver_context = nullptr;
+        return false;
+    }
+    invoker_ready_.store(is_invoker(), std::memory_order_release);
 
-    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    // The first client connects right after this; an invoker has nobody driving it yet
+    if (!is_invoker()) std::this_thread::sleep_for(std::chrono::milliseconds(100));
     is_initialized = true;
-    std::cout << "✓ Global Aeron MediaDriver initialized\n";
+    std::cout << "✓ Global Aeron MediaDriver initialized (" << threading_name(options_.threading)
+              << ", conductor " << aeron_idle_name(options_.conductor_idle) << ")\n";
     return true;
 }
 
+int GlobalMediaDriver::do_work() {
+    if (!invoker_ready_.load(std::memory_order_acquire)) return 0;
+    return aeron_driver_main_do_work(driver);
+}
+
+// Role names: "conductor", "sender", "receiver", or the combined agent of a shared mode
+// (which contains "conductor" when it is SHARED and "sender" when SHARED_NETWORK)
+void GlobalMediaDriver::on_agent_start(void* state, const char* role_name) {
+    auto* self = static_cast<GlobalMediaDriver*>(state);
+    std::string role = role_name ? role_name : "";
+
+    const ThreadPlacement* placement = &self->options_.receiver;
+    std::string name = "aeron-receiver";
+    if (role.find("conductor") != std::string::npos) {
+        placement = &self->options_.conductor;
+        name = self->options_.threading == DriverThreading::SHARED ? "aeron-driver" : "aeron-conductor";
+    } else if (role.find("sender") != std::string::npos) {
+        placement = &self->options_.sender;
+        name = self->options_.threading == DriverThreading::SHARED_NETWORK ? "aeron-network" : "aeron-sender";
+    }
+
+    std::cout << "  ✓ Media driver " << role << " thread started"
+              << thread_affinity::apply_placement(name, *placement) << "\n";
+}
+
 GlobalMediaDriver::~GlobalMediaDriver() {
+    invoker_ready_.store(false, std::memory_order_release);
     if (driver) {
+        aeron_driver_close(driver);     // Stops and joins the agent threads
         driver = nullptr;
     }
     if (driver_context) {
         aeron_driver_context_close(driver_context);
     }
-    if (driver_thread.joinable()) {
-        driver_thread.join();
-    }
-}
\ No newline at end of file
+}
@@ -0,0 +1,314 @@
+#include "messaging/MarketDataConsumer.h"
+#include <concurrent/BackOffIdleStrategy.h>
+#include <concurrent/BusySpinIdleStrategy.h>
+#include <concurrent/SleepingIdleStrategy.h>
+#include <concurrent/YieldingIdleStrategy.h>
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include <thread>
+
+MarketDataConsumer::MarketDataConsumer(const ConsumerOptions& options) : options_(options) {
+    options_.fragment_limit = std::max(options_.fragment_limit, 1);
+    slots_.fill(SLOT_UNKNOWN);
+}
+
+// ============================================================================
+// CONNECTION (cold path)
+// ============================================================================
+
+bool MarketDataConsumer::connect() {
+    try {
+        aeron::Context context;
+        if (!options_.aeron_dir.empty()) context.aeronDir(options_.aeron_dir);
+        context.mediaDriverTimeout(5000);
+        aeron_ = aeron::Aeron::connect(context);
+    } catch (const std::exception& e) {
+        std::cerr << "❌ Aeron connect failed (is the gateway's media driver running?): " << e.what() << "\n";
+        return false;
+    }
+
+    int64_t id = aeron_->addSubscription(options_.channel, options_.stream_id);
+    for (int i = 0; i < 1000 && !subscription_; ++i) {
+        subscription_ = aeron_->findSubscription(id);
+        if (!subscription_) std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    }
+    if (!subscription_) {
+        std::cerr << "❌ Failed to create Aeron subscription: " << options_.channel
+                  << " stream " << options_.stream_id << "\n";
+        return false;
+    }
+
+    // Snapshots beyond one MTU arrive fragmented (AeronPublisher offers them whole)
+    assembler_ = std::make_unique<aeron::FragmentAssembler>(
+        [this](aeron::AtomicBuffer& buffer, aeron::util::index_t offset, aeron::util::index_t length,
+               aeron::Header& header) {
+            on_fragment(reinterpret_cast<char*>(buffer.buffer() + offset), static_cast<size_t>(length),
+                        header.sessionId());
+        });
+    handler_ = assembler_->handler();
+
+    std::cout << "✓ Market data consumer: " << options_.channel << " stream " << options_.stream_id
+              << ", " << (options_.symbols.empty() ? std::string("all symbols")
+                                                   : std::to_string(options_.symbols.size()) + " symbols")
+              << ", " << options_.fragment_limit << " fragments/poll\n";
+    return true;
+}
+
+bool MarketDataConsumer::is_connected() const {
+    return subscription_ && subscription_->isConnected();
+}
+
+const LocalBook* MarketDataConsumer::find(std::string_view symbol) const {
+    auto it = book_index_.find(std::string(symbol));
+    return it != book_index_.end() ? books_[it->second].get() : nullptr;
+}
+
+// ============================================================================
+// POLLING
+// ============================================================================
+
+int MarketDataConsumer::poll() {
+    return subscription_ ? subscription_->poll(handler_, options_.fragment_limit) : 0;
+}
+
+void MarketDataConsumer::run(const std::atomic<bool>& running) {
+    // One dispatch here, so the loop itself calls the strategy directly
+    switch (options_.idle) {
+        case ConsumerIdle::BUSY_SPIN: {
+            aeron::concurrent::BusySpinIdleStrategy idle;
+            run_with(idle, running);
+            break;
+        }
+        case ConsumerIdle::YIELD: {
+            aeron::concurrent::YieldingIdleStrategy idle;
+            run_with(idle, running);
+            break;
+        }
+        case ConsumerIdle::BACKOFF: {
+            aeron::concurrent::BackoffIdleStrategy idle(options_.backoff_max_spins, options_.backoff_max_yields,
+                                                        std::chrono::nanoseconds(options_.backoff_min_park_ns),
+                                                        std::chrono::nanoseconds(options_.backoff_max_park_ns));
+            run_with(idle, running);
+            break;
+        }
+        case ConsumerIdle::SLEEP: {
+            aeron::concurrent::SleepingIdleStrategy idle(std::chrono::nanoseconds(options_.sleep_ns));
+            run_with(idle, running);
+            break;
+        }
+    }
+}
+
+template <typename Idle>
+void MarketDataConsumer::run_with(Idle& idle, const std::atomic<bool>& running) {
+    while (running.load(std::memory_order_relaxed)) {
+        idle.idle(poll());      // Resets on work, backs off on empty polls
+    }
+}
+
+// ============================================================================
+// DECODE
+// ============================================================================
+
+void MarketDataConsumer::on_fragment(char* data, size_t length, int32_t session_id) {
+    sbe_codec::Frame frame;
+    if (!sbe_codec::read_frame(data, length, frame)) {
+        count(malformed_);
+        return;
+    }
+    count(messages_);
+    note_session(session_id);
+
+    // The flyweights are bounds-checked here (no SBE_NO_BOUNDS_CHECK): the bytes come
+    // from another process
+    try {
+        if (frame.template_id == trading::sbe::BookDelta::sbeTemplateId()) {
+            on_delta(frame, session_id);
+        } else if (frame.template_id == trading::sbe::OrderBookSnapshot::sbeTemplateId()) {
+            on_snapshot(frame, session_id);
+        } else {
+            count(other_);
+        }
+    } catch (const std::exception&) {
+        count(malformed_);
+    }
+}
+
+void MarketDataConsumer::on_snapshot(const sbe_codec::Frame& frame, int32_t session_id) {
+    trading::sbe::OrderBookSnapshot msg;
+    sbe_codec::wrap(msg, frame);
+    uint32_t symbol_id = msg.symbolId();
+    if (is_filtered(symbol_id)) {
+        count(filtered_);
+        return;
+    }
+
+    // Group and var data order: bids, asks, then the symbol. Deeper than we keep is cut.
+    bool overflow = false;
+    read_levels(msg.bids(), scratch_.bids.data(), LocalBook::MAX_LEVELS, scratch_.bid_count, overflow);
+    read_levels(msg.asks(), scratch_.asks.data(), LocalBook::MAX_LEVELS, scratch_.ask_count, overflow);
+    LocalBook* book = resolve(symbol_id, msg.getSymbolAsStringView());
+    if (!book) {
+        count(filtered_);
+        return;
+    }
+
+    // Its own chain is authoritative (an exchange restart starts again at u=1); another
+    // line's copy only if it is not behind
+    uint64_t update_id = msg.updateId();
+    if (book->valid && session_id != book->session_id && update_id < book->update_id) {
+        count(stale_);
+        return;
+    }
+
+    std::copy_n(scratch_.bids.data(), scratch_.bid_count, book->bids.data());
+    std::copy_n(scratch_.asks.data(), scratch_.ask_count, book->asks.data());
+    book->bid_count = scratch_.bid_count;
+    book->ask_count = scratch_.ask_count;
+    book->price_exponent = msg.priceExponent();
+    book->qty_exponent = msg.qtyExponent();
+    book->update_id = update_id;
+    book->seq = msg.seq();
+    book->timestamp_ns = msg.timestamp();
+    book->session_id = session_id;
+    book->valid = true;
+    book->updates++;
+    count(snapshots_);
+    if (book_callback_) book_callback_(*book, BookUpdate::SNAPSHOT);
+}
+
+void MarketDataConsumer::on_delta(const sbe_codec::Frame& frame, int32_t session_id) {
+    trading::sbe::BookDelta msg;
+    sbe_codec::wrap(msg, frame);
+    uint32_t symbol_id = msg.symbolId();
+    if (is_filtered(symbol_id)) {
+        count(filtered_);
+        return;
+    }
+
+    bool overflow = false;
+    read_levels(msg.bids(), scratch_.bids.data(), static_cast<int>(scratch_.bids.size()), scratch_.bid_count, overflow);
+    read_levels(msg.asks(), scratch_.asks.data(), static_cast<int>(scratch_.asks.size()), scratch_.ask_count, overflow);
+    LocalBook* book = resolve(symbol_id, msg.getSymbolAsStringView());
+    if (!book) {
+        count(filtered_);
+        return;
+    }
+
+    uint64_t update_id = msg.updateId();
+    if (!book->valid) {
+        count(stale_);           // Waiting for a snapshot
+        return;
+    }
+    if (msg.prevUpdateId() != book->update_id) {
+        // Another line's chain, or a copy we are already past: not ours to judge
+        if (session_id != book->session_id || update_id <= book->update_id) {
+            count(stale_);
+            return;
+        }
+        overflow = true;    // Our chain skipped a message
+    }
+
+    if (overflow ||
+        !apply_changes(book->bids, book->bid_count, scratch_.bids.data(), scratch_.bid_count, true) ||
+        !apply_changes(book->asks, book->ask_count, scratch_.asks.data(), scratch_.ask_count, false)) {
+        book->valid = false;
+        book->gaps++;
+        count(gaps_);
+        if (book_callback_) book_callback_(*book, BookUpdate::GAP);
+        return;
+    }
+
+    book->update_id = update_id;
+    book->seq = msg.seq();
+    book->timestamp_ns = msg.timestamp();
+    book->session_id = session_id;      // The chain we continued is the one to follow
+    book->updates++;
+    count(deltas_);
+    if (book_callback_) book_callback_(*book, BookUpdate::DELTA);
+}
+
+template <typename Group>
+void MarketDataConsumer::read_levels(Group& group, PriceLevel* out, int capacity, int& count, bool& overflow) {
+    count = 0;
+    while (group.hasNext()) {       // Walked to the end either way: the symbol follows
+        group.next();
+        if (count < capacity) {
+            out[count++] = {group.price(), group.quantity()};
+        } else {
+            overflow = true;
+        }
+    }
+}
+
+// Levels are few (the published view): a linear walk beats anything clever
+bool MarketDataConsumer::apply_changes(std::array<PriceLevel, LocalBook::MAX_LEVELS>& levels, int& count,
+                                       const PriceLevel* changes, int change_count, bool descending) {
+    for (int c = 0; c < change_count; c++) {
+        const PriceLevel& change = changes[c];
+        int i = 0;
+        while (i < count && (descending ? levels[i].price > change.price : levels[i].price < change.price)) i++;
+
+        bool exists = i < count && levels[i].price == change.price;
+        if (change.quantity == 0) {
+            if (exists) {
+                std::copy(levels.begin() + i + 1, levels.begin() + count, levels.begin() + i);
+                count--;
+            }
+        } else if (exists) {
+            levels[i].quantity = change.quantity;
+        } else {
+            if (count == LocalBook::MAX_LEVELS) return false;
+            std::copy_backward(levels.begin() + i, levels.begin() + count, levels.begin() + count + 1);
+            levels[i] = change;
+            count++;
+        }
+    }
+    return true;
+}
+
+// ============================================================================
+// SYMBOLS (cold path, once per gateway symbol ID)
+// ============================================================================
+
+void MarketDataConsumer::note_session(int32_t session_id) {
+    if (!sessions_.empty() && sessions_.back() == session_id) return;
+    if (std::find(sessions_.begin(), sessions_.end(), session_id) != sessions_.end()) return;
+
+    // A new publisher: possibly a restarted gateway with a new ID assignment
+    sessions_.push_back(session_id);
+    std::replace(slots_.begin(), slots_.end(), SLOT_FILTERED, SLOT_UNKNOWN);
+}
+
+LocalBook* MarketDataConsumer::resolve(uint32_t symbol_id, std::string_view symbol) {
+    bool has_slot = symbol_id < SymbolRegistry::MAX_SYMBOLS;
+    if (has_slot && slots_[symbol_id] >= 0) {
+        LocalBook* book = books_[static_cast<size_t>(slots_[symbol_id])].get();
+        if (book->symbol == symbol) return book;
+    }
+
+    bool wanted = options_.symbols.empty() ||
+                  std::find(options_.symbols.begin(), options_.symbols.end(), symbol) != options_.symbols.end();
+    if (!wanted) {
+        if (has_slot) slots_[symbol_id] = SLOT_FILTERED;
+        return nullptr;
+    }
+
+    std::string name(symbol);
+    auto it = book_index_.find(name);
+    size_t index;
+    if (it != book_index_.end()) {
+        index = it->second;
+    } else {
+        index = books_.size();
+        books_.push_back(std::make_unique<LocalBook>());
+        books_.back()->symbol = name;
+        book_index_.emplace(std::move(name), index);
+    }
+
+    LocalBook* book = books_[index].get();
+    book->symbol_id = symbol_id;
+    if (has_slot) slots_[symbol_id] = static_cast<int32_t>(index);
+    return book;
+}
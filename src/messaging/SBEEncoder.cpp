@@ -1,157 +1,118 @@
 #include "messaging/SBEEncoder.h"
-#include <cstring>
+#include <algorithm>
 
-// ============================================================================
-// CORE FUNCTIONS
-// ============================================================================
-void SBEEncoder::reset() {
-    offset_ = 0;
-}
+using trading::sbe::BookDelta;
+using trading::sbe::BooleanType;
+using trading::sbe::OrderBookSnapshot;
+using trading::sbe::OrderRecord;
+using trading::sbe::Side;
 
-char* SBEEncoder::data() {
-    return buffer_.data();
-}
+namespace {
+
+// Grid of the instrument as SBE decimals: ticks * mantissa at 10^-decimals
+struct Scale {
+    int64_t price_mul;
+    int64_t qty_mul;
+    int8_t price_exponent;
+    int8_t qty_exponent;
+};
 
-size_t SBEEncoder::size() const {
-    return offset_;
+Scale scale_of(const InstrumentSpec& instrument) {
+    return {static_cast<int64_t>(instrument.tick.mantissa), static_cast<int64_t>(instrument.lot.mantissa),
+            static_cast<int8_t>(-instrument.tick.decimals), static_cast<int8_t>(-instrument.lot.decimals)};
 }
 
-// ============================================================================
-// ENCODER: Orderbook Snapshot (Template ID 2)
-// ============================================================================
-void SBEEncoder::encode_orderbook_snapshot(
-    uint64_t timestamp,
-    const std::vector<std::pair<double, double>>& bids,
-    const std::vector<std::pair<double, double>>& asks,
-    const std::string& symbol
-) {
-    reset();
-    
-    // Header
-    write_uint16(48); // BlockLength
-    write_uint16(2);  // TemplateId
-    write_uint16(1);  // SchemaId
-    write_uint16(0);  // Version
-    
-    // Body
-    write_uint64(timestamp);
-    write_uint16(static_cast<uint16_t>(bids.size()));
-    write_uint16(static_cast<uint16_t>(asks.size()));
-    
-    // Bids Group
-    write_uint16(16); // BlockLength
-    write_uint16(static_cast<uint16_t>(bids.size()));
-    for (const auto& [price, qty] : bids) {
-        write_double(price);
-        write_double(qty);
-    }
-    
-    // Asks Group
-    write_uint16(16); // BlockLength
-    write_uint16(static_cast<uint16_t>(asks.size()));
-    for (const auto& [price, qty] : asks) {
-        write_double(price);
-        write_double(qty);
+template <typename Group>
+void put_levels(Group& group, const PriceLevel* levels, size_t count, const Scale& scale) {
+    for (size_t i = 0; i < count; i++) {
+        group.next()
+            .price(levels[i].price * scale.price_mul)
+            .quantity(levels[i].quantity * scale.qty_mul);
     }
-    
-    // Var Data
-    write_string(symbol);
 }
 
-// ============================================================================
-// ENCODER: Trade Signal (Template ID 3)
-// ============================================================================
-void SBEEncoder::encode_trade_signal(
-    uint64_t timestamp,
-    uint8_t action,
-    double price,
-    double quantity,
-    const std::string& symbol
-) {
-    reset();
-    
-    // Header
-    write_uint16(32); // BlockLength
-    write_uint16(3);  // TemplateId
-    write_uint16(1);  // SchemaId
-    write_uint16(0);  // Version
-    
-    // Body
-    write_uint64(timestamp);
-    write_uint8(action);
-    write_double(price);
-    write_double(quantity);
-    
-    // Var Data
-    write_string(symbol);
-}
+} // namespace
 
 // ============================================================================
-// [NEW] ENCODER: Active Order (Template ID 4)
-// This fixes the "no member named encode_order" error
+// ENCODER: Orderbook Snapshot (Template ID 2)
 // ============================================================================
-void SBEEncoder::encode_order(
-    uint64_t timestamp,
-    const std::string& order_id,
-    const std::string& symbol,
-    const std::string& side,
-    double price,
-    double quantity,
-    bool is_active
-) {
-    reset();
-
-    // Message Header
-    write_uint16(64); // BlockLength (Approximation of fixed fields)
-    write_uint16(4);  // TemplateId (4 = Order)
-    write_uint16(1);  // SchemaId
-    write_uint16(0);  // Version
-
-    // Fixed Body Fields
-    write_uint64(timestamp);
-    write_double(price);
-    write_double(quantity);
-    write_uint8(is_active ? 1 : 0);
-
-    // Variable Length Strings (Order must match decoder expectation)
-    write_string(order_id);
-    write_string(symbol);
-    write_string(side);
+size_t SBEEncoder::encode_book_snapshot(char* buffer, size_t capacity, uint64_t timestamp_ns,
+                                        uint32_t symbol_id, std::string_view symbol,
+                                        const InstrumentSpec& instrument, const OrderBook::View& book,
+                                        int max_levels) {
+    size_t bids = static_cast<size_t>(std::max(0, std::min(book.bid_count, max_levels)));
+    size_t asks = static_cast<size_t>(std::max(0, std::min(book.ask_count, max_levels)));
+    if (book_snapshot_length(bids, asks, symbol.size()) > capacity) return 0;
+
+    Scale scale = scale_of(instrument);
+    OrderBookSnapshot msg;
+    msg.wrapAndApplyHeader(buffer, 0, capacity)
+        .timestamp(timestamp_ns)
+        .updateId(book.update_id)
+        .seq(book.seq)
+        .symbolId(symbol_id)
+        .priceExponent(scale.price_exponent)
+        .qtyExponent(scale.qty_exponent);
+
+    put_levels(msg.bidsCount(static_cast<uint16_t>(bids)), book.bids, bids, scale);
+    put_levels(msg.asksCount(static_cast<uint16_t>(asks)), book.asks, asks, scale);
+    msg.putSymbol(symbol.data(), static_cast<uint16_t>(symbol.size()));
+
+    return HEADER_LENGTH + msg.encodedLength();
 }
 
 // ============================================================================
-// LOW-LEVEL WRITERS
+// ENCODER: Book Delta (Template ID 5)
 // ============================================================================
+size_t SBEEncoder::encode_book_delta(char* buffer, size_t capacity, uint64_t timestamp_ns,
+                                     uint32_t symbol_id, std::string_view symbol,
+                                     const InstrumentSpec& instrument,
+                                     std::span<const PriceLevel> bids, std::span<const PriceLevel> asks,
+                                     uint64_t update_id, uint64_t prev_update_id, uint64_t seq) {
+    if (bids.size() > UINT16_MAX || asks.size() > UINT16_MAX) return 0;
+    if (book_delta_length(bids.size(), asks.size(), symbol.size()) > capacity) return 0;
 
-void SBEEncoder::write_uint8(uint8_t value) {
-    if (offset_ + 1 > buffer_.size()) buffer_.resize(buffer_.size() * 2);
-    buffer_[offset_++] = static_cast<char>(value);
-}
+    Scale scale = scale_of(instrument);
+    BookDelta msg;
+    msg.wrapAndApplyHeader(buffer, 0, capacity)
+        .timestamp(timestamp_ns)
+        .updateId(update_id)
+        .prevUpdateId(prev_update_id)
+        .seq(seq)
+        .symbolId(symbol_id)
+        .priceExponent(scale.price_exponent)
+        .qtyExponent(scale.qty_exponent);
 
-void SBEEncoder::write_uint16(uint16_t value) {
-    if (offset_ + 2 > buffer_.size()) buffer_.resize(buffer_.size() * 2);
-    std::memcpy(buffer_.data() + offset_, &value, sizeof(value));
-    offset_ += sizeof(value);
-}
+    put_levels(msg.bidsCount(static_cast<uint16_t>(bids.size())), bids.data(), bids.size(), scale);
+    put_levels(msg.asksCount(static_cast<uint16_t>(asks.size())), asks.data(), asks.size(), scale);
+    msg.putSymbol(symbol.data(), static_cast<uint16_t>(symbol.size()));
 
-void SBEEncoder::write_uint64(uint64_t value) {
-    if (offset_ + 8 > buffer_.size()) buffer_.resize(buffer_.size() * 2);
-    std::memcpy(buffer_.data() + offset_, &value, sizeof(value));
-    offset_ += sizeof(value);
+    return HEADER_LENGTH + msg.encodedLength();
 }
 
-void SBEEncoder::write_double(double value) {
-    if (offset_ + 8 > buffer_.size()) buffer_.resize(buffer_.size() * 2);
-    std::memcpy(buffer_.data() + offset_, &value, sizeof(value));
-    offset_ += sizeof(value);
-}
+// ============================================================================
+// ENCODER: Order Record (Template ID 4)
+// ============================================================================
+size_t SBEEncoder::encode_order(char* buffer, size_t capacity, uint64_t timestamp_ns,
+                                uint32_t symbol_id, std::string_view symbol,
+                                const InstrumentSpec& instrument, std::string_view order_link_id,
+                                bool is_buy, int64_t price_ticks, int64_t qty_lots, bool is_active) {
+    if (order_link_id.size() > OrderRecord::orderLinkIdLength()) return 0;
+    if (order_record_length(symbol.size()) > capacity) return 0;
 
-// Helper to write length + string data
-void SBEEncoder::write_string(const std::string& str) {
-    uint16_t len = static_cast<uint16_t>(str.length());
-    write_uint16(len);
-    
-    if (offset_ + len > buffer_.size()) buffer_.resize(buffer_.size() * 2);
-    std::memcpy(buffer_.data() + offset_, str.data(), len);
-    offset_ += len;
-}
\ No newline at end of file
+    Scale scale = scale_of(instrument);
+    OrderRecord msg;
+    msg.wrapAndApplyHeader(buffer, 0, capacity)
+        .timestamp(timestamp_ns)
+        .price(price_ticks * scale.price_mul)
+        .quantity(qty_lots * scale.qty_mul)
+        .symbolId(symbol_id)
+        .priceExponent(scale.price_exponent)
+        .qtyExponent(scale.qty_exponent)
+        .side(is_buy ? Side::Buy : Side::Sell)
+        .active(is_active ? BooleanType::T : BooleanType::F)
+        .putOrderLinkId(order_link_id);
+    msg.putSymbol(symbol.data(), static_cast<uint16_t>(symbol.size()));
+
+    return HEADER_LENGTH + msg.encodedLength();
+}
@@ -1,4 +1,5 @@
 #include "network/BybitWebSocketClient.h"
+#include <algorithm>
 #include <iostream>
 #include <cstring>
 #include <chrono>
@@ -7,6 +8,11 @@
 #include <sstream>
 #include <iomanip>
 #include <thread>
+#include <stdexcept>
+#include "utils/AllocationCounter.h"
+#include "utils/DecimalParser.h"
+#include "utils/LatencyRecorder.h"
+#include "utils/TelemetrySegment.h"
 
 // ============================================================================
 // INTERNAL STRUCTURES
@@ -15,13 +21,32 @@
 
 In networking (TCP and WebSockets), a large JSON message from Bybit might be split into 3 or 4 packets while traveling over the internet.
 
-SessionData acts as a Temporary Bucket to hold these pieces until the full message is ready to be read.*/
+SessionData acts as a Temporary Bucket to hold these pieces until the full message is ready to be read.
+
+lws hands us zero-filled raw memory for per-session data, so the slot only holds a
+pointer: the SessionData itself is properly constructed on ESTABLISHED and destroyed on CLOSED.*/
 struct SessionData {
     std::string rx_buffer;
+    uint64_t rx_tick = 0;       // tsc::now() at the frame's first fragment
 };
 
-struct lws_protocols BybitWebSocketClient::protocols_[] = {
-    { "bybit-protocol", BybitWebSocketClient::callback_function, sizeof(SessionData), 65536 },
+// Initial reservation for a frame; grows only if Bybit ever sends a bigger one.
+// simdjson needs SIMDJSON_PADDING readable bytes past the end to parse in place.
+static constexpr size_t RX_BUFFER_RESERVE = 65536;
+
+// The channel a policy allows for the constructor's ChannelType
+template <typename Policy>
+static BybitChannelType channel_of(BybitChannelType type) {
+    if constexpr (Policy::CHANNEL == FeedChannel::PUBLIC) {
+        return BybitChannelType::PUBLIC;
+    } else {
+        return type;
+    }
+}
+
+template <typename Policy>
+struct lws_protocols BasicBybitWebSocketClient<Policy>::protocols_[] = {
+    { "bybit-protocol", BasicBybitWebSocketClient<Policy>::callback_function, sizeof(SessionData*), 65536 },
     { NULL, NULL, 0, 0 }
 };
 
@@ -29,7 +54,8 @@ struct lws_protocols BybitWebSocketClient::protocols_[] = {
 // CONSTRUCTOR & DESTRUCTOR
 // ============================================================================
 
-BybitWebSocketClient::BybitWebSocketClient(
+template <typename Policy>
+BasicBybitWebSocketClient<Policy>::BasicBybitWebSocketClient(
     OrderBookManager& obm,
     SymbolManager& sm,
     BotConfiguration& config,
@@ -39,9 +65,10 @@ BybitWebSocketClient::BybitWebSocketClient(
     symbol_manager_(sm), 
     config_(config), 
     data_logger_(logger),
-    channel_type_(type) 
+    channel_type_(channel_of<Policy>(type)),
+    endpoint_(config.ws_host)
 {
-    if (channel_type_ == ChannelType::PRIVATE_TRADE || channel_type_ == ChannelType::PRIVATE_STREAM) {
+    if (!is_public()) {
         api_key_ = config_.api_key;
         api_secret_ = config_.api_secret;
 
@@ -65,17 +92,25 @@ BybitWebSocketClient::BybitWebSocketClient(
         throw std::runtime_error("Failed to create WebSocket context");
     }
     
-    if (config_.enable_aeron && channel_type_ == ChannelType::PUBLIC) {
-        aeron_pub_ = std::make_unique<AeronPublisher>(
-            config_.aeron_channel, config_.orderbook_stream_id);
-        
-        if (!aeron_pub_->init()) {
-            std::cerr << "⚠ Aeron disabled - continuing without IPC\n";
+    if (is_public()) {
+        symbol_stats_ = std::make_unique<SymbolStats[]>(SymbolRegistry::MAX_SYMBOLS);
+    }
+
+    if constexpr (PUBLISHES_BOOKS) {
+        if (config_.enable_aeron && is_public()) {
+            aeron_pub_ = std::make_unique<AeronPublisher>(
+                config_.aeron_channel, config_.orderbook_stream_id, config_.aeron_book_publish);
+
+            if (!aeron_pub_->init()) {
+                std::cerr << "⚠ Aeron disabled - continuing without IPC\n";
+            }
+            book_publication_ = std::make_unique<BookPublication>(*aeron_pub_, config_.aeron_book_stream);
         }
     }
 }
 
-BybitWebSocketClient::~BybitWebSocketClient() {
+template <typename Policy>
+BasicBybitWebSocketClient<Policy>::~BasicBybitWebSocketClient() {
     stop();
     if (context_) {
         lws_context_destroy(context_);
@@ -86,23 +121,30 @@ BybitWebSocketClient::~BybitWebSocketClient() {
 // CONNECTION MANAGEMENT
 // ============================================================================
 
-void BybitWebSocketClient::connect() {
+template <typename Policy>
+void BasicBybitWebSocketClient<Policy>::connect() {
+    wsi_ = open_connection();
+    if (!wsi_) {
+        throw std::runtime_error("Failed to connect to WebSocket");
+    }
+}
+
+// Starts a connection attempt; ESTABLISHED / CONNECTION_ERROR arrive in the callback.
+template <typename Policy>
+struct lws* BasicBybitWebSocketClient<Policy>::open_connection() {
     struct lws_client_connect_info ccinfo;
     memset(&ccinfo, 0, sizeof(ccinfo));
     
     ccinfo.context = context_;
-    ccinfo.address = "stream-testnet.bybit.com"; 
-    // ccinfo.address = "stream.bybit.com"; // Uncomment for MAINNET
+    ccinfo.address = endpoint_.c_str();     // BotConfiguration::ws_host unless set_endpoint()
 
     ccinfo.port = 443;
     ccinfo.host = ccinfo.address;
     ccinfo.origin = ccinfo.address;
     ccinfo.protocol = protocols_[0].name;
     ccinfo.ssl_connection = LCCSCF_USE_SSL;
-    // In BybitWebSocketClient::connect()
 
-
-    if (channel_type_ == ChannelType::PUBLIC) {
+    if (is_public()) {
         ccinfo.path = "/v5/public/linear";
     } else if (channel_type_ == ChannelType::PRIVATE_TRADE) {
         ccinfo.path = "/v5/trade";
@@ -110,28 +152,214 @@ void BybitWebSocketClient::connect() {
         ccinfo.path = "/v5/private";
     }
     
-    wsi_ = lws_client_connect_via_info(&ccinfo);
-    if (!wsi_) {
-        throw std::runtime_error("Failed to connect to WebSocket");
-    }
+    return lws_client_connect_via_info(&ccinfo);
 }
 
-void BybitWebSocketClient::run() {
+template <typename Policy>
+void BasicBybitWebSocketClient<Policy>::run() {
+    service_thread_.store(std::this_thread::get_id(), std::memory_order_relaxed);
     while (running_) {
         lws_service(context_, 50);
+        supervise_connection();
+        if constexpr (PUBLISHES_BOOKS) {
+            if (book_publication_) book_publication_->flush();  // Conflation windows that ran out
+            if (aeron_pub_) aeron_pub_->flush();                // Books parked under back-pressure
+        }
     }
 }
 
-void BybitWebSocketClient::stop() {
+// ============================================================================
+// RECONNECT SUPERVISOR (service thread)
+// ============================================================================
+
+template <typename Policy>
+int64_t BasicBybitWebSocketClient<Policy>::monotonic_ns() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+// Runs after every lws_service() pass: keep-alive pings, stall detection, and
+// (re)opening connections once the backoff allows it.
+template <typename Policy>
+void BasicBybitWebSocketClient<Policy>::supervise_connection() {
+    int64_t now = monotonic_ns();
+
+    if (connected_ && wsi_) {
+        if (now - last_ping_ns_ >= static_cast<int64_t>(config_.ws_ping_interval_ms) * 1000000) {
+            send_ping();
+            last_ping_ns_ = now;
+        }
+        if (!stalled_ && now - last_rx_ns_ >= static_cast<int64_t>(config_.ws_stall_timeout_ms) * 1000000) {
+            std::cerr << "⚠️  WebSocket silent for " << config_.ws_stall_timeout_ms
+                      << "ms, opening standby connection...\n";
+            stalled_ = true;
+            set_line_live(false);
+            begin_recovery(now);        // The books are stale either way
+        }
+    }
+
+    // Warm standby: the replacement is dialled while the old socket still exists
+    bool need_connection = !wsi_ || stalled_;
+    if (need_connection && !standby_wsi_ && now >= next_reconnect_ns_) {
+        standby_wsi_ = open_connection();
+        if (!standby_wsi_) schedule_reconnect(now);
+    }
+}
+
+// Exponential backoff with jitter: a uniformly random delay in [backoff / 2, backoff],
+// so a fleet of shards dropped by one event does not reconnect in lockstep.
+template <typename Policy>
+void BasicBybitWebSocketClient<Policy>::schedule_reconnect(int64_t now_ns) {
+    int64_t max_ms = std::max(config_.ws_reconnect_max_ms, 1);
+    backoff_ms_ = backoff_ms_ == 0 ? std::max(config_.ws_reconnect_initial_ms, 1)
+                                   : std::min(backoff_ms_ * 2, max_ms);
+    std::uniform_int_distribution<int64_t> jitter(backoff_ms_ / 2, backoff_ms_);
+    int64_t delay_ms = jitter(jitter_rng_);
+    next_reconnect_ns_ = now_ns + delay_ms * 1000000;
+    std::cerr << "🔁 Reconnecting in " << delay_ms << "ms\n";
+}
+
+// Feed lost or stalled: every book of this connection is invalidated (the engines pause
+// in validate_market_data) until the resubscribe delivers its snapshot. A redundant line
+// leaves the books alone while another line of its shard is live: they keep updating
+// from that line, and this one only waits for its own snapshots again.
+template <typename Policy>
+void BasicBybitWebSocketClient<Policy>::begin_recovery(int64_t now_ns) {
+    if (recovery_start_ns_ == 0) recovery_start_ns_ = now_ns;
+    bool covered = line_group_ && line_group_->live.load(std::memory_order_acquire) > 0;
+    recovery_pending_books_ = 0;
+    for (auto& slot : slots_) {
+        if (!covered) slot.book->invalidate();
+        slot.awaiting_snapshot = true;
+        recovery_pending_books_++;
+    }
+}
+
+template <typename Policy>
+void BasicBybitWebSocketClient<Policy>::on_connection_restored(int64_t now_ns) {
+    reconnects_.fetch_add(1, std::memory_order_relaxed);
+    backoff_ms_ = 0;
+    std::cout << "🔁 WebSocket reconnected, restoring session...\n";
+
+    // Frames sent on the dead connection will never be answered
+    subscribe_requests_.store(subscribe_acks_.load() + subscribe_failures_.load());
+
+    if (!is_public()) {
+        authenticate();     // The stream channel resubscribes its topics on auth success
+    } else {
+        std::vector<std::string> symbols;
+        {
+            std::lock_guard<std::mutex> lock(subscription_mutex_);
+            symbols = subscribed_symbols_;
+        }
+        size_t frames = send_subscribe_frames(symbols);
+        std::cout << "📡 Resubscribed " << symbols.size() << " topics in " << frames << " frame(s)\n";
+    }
+
+    if (recovery_pending_books_ == 0) finish_recovery(now_ns);
+}
+
+template <typename Policy>
+void BasicBybitWebSocketClient<Policy>::finish_recovery(int64_t now_ns) {
+    if (recovery_start_ns_ == 0) return;
+    uint64_t ms = static_cast<uint64_t>((now_ns - recovery_start_ns_) / 1000000);
+    recovery_start_ns_ = 0;
+
+    last_recovery_ms_.store(ms, std::memory_order_relaxed);
+    if (ms > max_recovery_ms_.load(std::memory_order_relaxed)) {
+        max_recovery_ms_.store(ms, std::memory_order_relaxed);
+    }
+    std::cout << "✅ Feed recovered in " << ms << "ms\n";
+}
+
+template <typename Policy>
+void BasicBybitWebSocketClient<Policy>::set_line_live(bool live) {
+    if (!line_group_ || line_live_ == live) return;
+    line_live_ = live;
+    line_group_->live.fetch_add(live ? 1 : -1, std::memory_order_acq_rel);
+}
+
+template <typename Policy>
+void BasicBybitWebSocketClient<Policy>::send_ping() {
+    queue_frame(R"({"op":"ping"})");
+}
+
+template <typename Policy>
+void BasicBybitWebSocketClient<Policy>::stop() {
     running_ = false;
     connected_ = false;
+    if (context_) lws_cancel_service(context_);
+}
+
+// ============================================================================
+// OUTBOUND QUEUE (any thread -> service thread)
+// ============================================================================
+
+template <typename Policy>
+bool BasicBybitWebSocketClient<Policy>::make_frame(OutboundFrame& frame, std::string_view payload, bool timed) {
+    if (payload.size() > OUTBOUND_FRAME_CAP) {
+        std::cerr << "❌ Outbound frame too large (" << payload.size() << " bytes)\n";
+        return false;
+    }
+    memcpy(frame.bytes.data() + LWS_PRE, payload.data(), payload.size());
+    frame.length = static_cast<uint32_t>(payload.size());
+    frame.timed = timed;
+    return true;
+}
+
+template <typename Policy>
+uint64_t BasicBybitWebSocketClient<Policy>::push_frame(OutboundFrame& frame) {
+    frame.queued_tick = tsc::now();
+    if (!outbound_.try_push(frame)) return 0;
+    lws_cancel_service(context_);       // EVENT_WAIT_CANCELLED asks for CLIENT_WRITEABLE
+    return frame.queued_tick;
+}
+
+template <typename Policy>
+bool BasicBybitWebSocketClient<Policy>::queue_frame_blocking(std::string_view payload) {
+    OutboundFrame frame;
+    if (!make_frame(frame, payload, false)) return false;
+    bool service_thread = service_thread_.load(std::memory_order_relaxed) == std::this_thread::get_id();
+    while (!push_frame(frame)) {
+        if (service_thread || !running_) return false;
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    return true;
+}
+
+// One frame per CLIENT_WRITEABLE, as lws requires; asks for the next one while any is left
+template <typename Policy>
+void BasicBybitWebSocketClient<Policy>::write_outbound(struct lws* wsi) {
+    OutboundFrame frame;
+    if (!outbound_.try_pop(frame)) return;
+
+    int n = lws_write(wsi, frame.bytes.data() + LWS_PRE, frame.length, LWS_WRITE_TEXT);
+    if (n < 0) {
+        std::cerr << "❌ WebSocket write failed (" << frame.length << " bytes)\n";
+        return;     // The connection is going away: CLIENT_CLOSED drops the rest
+    }
+    if (frame.timed) {
+        LatencyRecorder::get_instance().record_ticks(LatencyStage::SEND_QUEUE, SymbolRegistry::MAX_SYMBOLS,
+                                                     frame.queued_tick, tsc::now());
+    }
+    if (!outbound_.empty()) lws_callback_on_writable(wsi);
+}
+
+// Frames meant for a connection that is gone (a new session re-authenticates first)
+template <typename Policy>
+void BasicBybitWebSocketClient<Policy>::drop_outbound() {
+    OutboundFrame frame;
+    size_t dropped = 0;
+    while (outbound_.try_pop(frame)) dropped++;
+    if (dropped) std::cerr << "⚠️  Dropped " << dropped << " unsent frame(s) of the lost connection\n";
 }
 
 // ============================================================================
 // AUTHENTICATION & TRADING
 // ============================================================================
 
-std::string BybitWebSocketClient::generate_signature(long long expires) {
+template <typename Policy>
+std::string BasicBybitWebSocketClient<Policy>::generate_signature(long long expires) {
     std::string data = "GET/realtime" + std::to_string(expires);
     unsigned char* digest;
     
@@ -145,8 +373,9 @@ std::string BybitWebSocketClient::generate_signature(long long expires) {
     return ss.str();
 }
 
-void BybitWebSocketClient::authenticate() {
-    if (channel_type_ == ChannelType::PUBLIC) return;
+template <typename Policy>
+void BasicBybitWebSocketClient<Policy>::authenticate() {
+    if (is_public()) return;
     
     long long expires = std::chrono::duration_cast<std::chrono::milliseconds>(
         std::chrono::system_clock::now().time_since_epoch()).count() + 10000;
@@ -158,154 +387,259 @@ void BybitWebSocketClient::authenticate() {
        << api_key_ << "\"," << expires << ",\"" << signature << "\"]}";
        
     std::string msg = ss.str();
-    
-    unsigned char buf[LWS_PRE + 1024];
-    memcpy(&buf[LWS_PRE], msg.c_str(), msg.length());
-    lws_write(wsi_, &buf[LWS_PRE], msg.length(), LWS_WRITE_TEXT);
-    
+    if (!queue_frame_blocking(msg)) {
+        std::cerr << "❌ [Auth] Could not queue the authentication request\n";
+        return;
+    }
     std::cout << "🔑 [Auth] Sending authentication request...\n";
 }
 
-void BybitWebSocketClient::place_order(const std::string& symbol, const std::string& side, 
-                                      double qty, double price, const std::string& order_link_id,bool is_maker) {
+// Order entry (engine workers): the request is serialized into the encoder's buffer
+// (preformatted per-symbol prefix + patched timestamp), no iostreams, and copied into the
+// outbound queue; the service thread writes it. The request itself is the log line:
+// journaled as ORDER_REQ / CANCEL_REQ, nothing printed.
+template <typename Policy>
+uint64_t BasicBybitWebSocketClient<Policy>::place_order(const std::string& symbol, const std::string& side, 
+                                      int64_t qty_lots, int64_t price_ticks, std::string_view order_link_id,bool is_maker) {
     
     if (!connected_ || channel_type_ != ChannelType::PRIVATE_TRADE) {
         std::cerr << "❌ Place Order Failed: Not connected or wrong channel.\n";
-        return;
+        return 0;
     }
 
     long long now = std::chrono::duration_cast<std::chrono::milliseconds>(
         std::chrono::system_clock::now().time_since_epoch()).count();
 
-    std::string tif = is_maker ? "PostOnly" : "GTC";
-
-    std::stringstream ss;
-    ss << std::fixed << std::setprecision(5);
-    ss << "{"
-       << "\"reqId\":\"" << order_link_id << "\","
-       << "\"header\":{"
-       <<    "\"X-BAPI-TIMESTAMP\":\"" << now << "\","
-       <<    "\"X-BAPI-RECV-WINDOW\":\"5000\""
-       << "},"
-       << "\"op\":\"order.create\","
-       << "\"args\":[{"
-       <<    "\"symbol\":\"" << symbol << "\","
-       <<    "\"side\":\"" << side << "\","
-       <<    "\"orderType\":\"Limit\","
-       <<    "\"qty\":\"" << qty << "\","
-       <<    "\"price\":\"" << price << "\","
-       <<    "\"category\":\"linear\","
-       <<    "\"timeInForce\":\"" << tif << "\","
-       <<    "\"orderLinkId\":\"" << order_link_id << "\""
-       << "}]}";
-
-    std::string msg = ss.str();
-
-    data_logger_.log("ORDER_REQ", msg);
-
-    unsigned char buf[LWS_PRE + 2048];
-    memcpy(&buf[LWS_PRE], msg.c_str(), msg.length());
+    OutboundFrame frame;
+    bool encoded;
+    {
+        // Several engine workers share the encoder's buffer
+        std::lock_guard<std::mutex> lock(send_mutex_);
+        auto req = order_encoder_.encode_create(symbol, side == "Buy", qty_lots, price_ticks,
+                                                order_link_id, is_maker, now);
+        std::string_view request(reinterpret_cast<const char*>(req.data), req.length);
+        data_logger_.log("ORDER_REQ", request);
+        encoded = make_frame(frame, request, true);
+    }
 
-    int n = lws_write(wsi_, &buf[LWS_PRE], msg.length(), LWS_WRITE_TEXT);
-    if (n < 0) std::cerr << "❌ Failed to send Place Order\n";
-    else std::cout << "📤 Order Sent: " << order_link_id << " (" << side << " " << qty << " @ " << price << ")\n";
+    uint64_t queued_tick = encoded ? push_frame(frame) : 0;
+    if (!queued_tick) std::cerr << "❌ Place Order dropped: send queue full\n";
+    return queued_tick;
 }
 
-void BybitWebSocketClient::cancel_order(const std::string& symbol, const std::string& order_link_id) {
-    if (!connected_ || channel_type_ != ChannelType::PRIVATE_TRADE) return;
+template <typename Policy>
+bool BasicBybitWebSocketClient<Policy>::cancel_order(const std::string& symbol, std::string_view order_link_id) {
+    if (!connected_ || channel_type_ != ChannelType::PRIVATE_TRADE) return false;
 
     long long now = std::chrono::duration_cast<std::chrono::milliseconds>(
         std::chrono::system_clock::now().time_since_epoch()).count();
 
-    std::stringstream ss;
-    ss << "{"
-       << "\"header\":{"
-       <<    "\"X-BAPI-TIMESTAMP\":\"" << now << "\","
-       <<    "\"X-BAPI-RECV-WINDOW\":\"5000\""
-       << "},"
-       << "\"op\":\"order.cancel\","
-       << "\"args\":[{"
-       <<    "\"symbol\":\"" << symbol << "\","
-       <<    "\"category\":\"linear\","
-       <<    "\"orderLinkId\":\"" << order_link_id << "\""
-       << "}]}";
+    OutboundFrame frame;
+    bool encoded;
+    {
+        std::lock_guard<std::mutex> lock(send_mutex_);
+        auto req = order_encoder_.encode_cancel(symbol, order_link_id, now);
+        std::string_view request(reinterpret_cast<const char*>(req.data), req.length);
+        data_logger_.log("CANCEL_REQ", request);
+        encoded = make_frame(frame, request, true);
+    }
 
-    std::string msg = ss.str();
+    if (!encoded || !push_frame(frame)) {
+        std::cerr << "❌ Cancel dropped: send queue full\n";
+        return false;
+    }
+    return true;
+}
 
-    data_logger_.log("CANCEL_REQ", msg);
-    
-    unsigned char buf[LWS_PRE + 1024];
-    memcpy(&buf[LWS_PRE], msg.c_str(), msg.length());
-    lws_write(wsi_, &buf[LWS_PRE], msg.length(), LWS_WRITE_TEXT);
-    
-    std::cout << "📤 Cancel Sent: " << order_link_id << "\n";
+// Tick/lot grid the symbol's order prices and quantities are expressed in
+template <typename Policy>
+void BasicBybitWebSocketClient<Policy>::set_instrument(const std::string& symbol, const InstrumentSpec& instrument) {
+    std::lock_guard<std::mutex> lock(send_mutex_);
+    order_encoder_.set_instrument(symbol, instrument);
 }
 
 // ============================================================================
 // MARKET DATA (PUBLIC CHANNEL)
 // ============================================================================
 
-void BybitWebSocketClient::subscribe_to_symbol(const std::string& symbol) {
-    if (!wsi_ || !connected_) {
+template <typename Policy>
+void BasicBybitWebSocketClient<Policy>::subscribe_to_symbol(const std::string& symbol) {
+    if (subscribe_to_symbols({symbol}) > 0) {
+        std::cout << "✅ Subscribed to " << symbol << "\n";
+    }
+}
+
+template <typename Policy>
+size_t BasicBybitWebSocketClient<Policy>::subscribe_to_symbols(const std::vector<std::string>& symbols) {
+    if (!connected_) {
         std::cerr << "❌ Cannot subscribe: WebSocket not connected yet\n";
+        return 0;
+    }
+
+    // Books must exist before their first snapshot arrives on the service thread
+    for (const auto& symbol : symbols) orderbook_manager_.get_or_create(symbol);
+    {
+        std::lock_guard<std::mutex> lock(subscription_mutex_);
+        subscribed_symbols_.insert(subscribed_symbols_.end(), symbols.begin(), symbols.end());
+    }
+    return send_subscribe_frames(symbols);
+}
+
+// One frame per MAX_SUBSCRIBE_ARGS topics, all sent back to back: a cold start costs
+// about one round-trip per frame in flight instead of one per symbol.
+template <typename Policy>
+size_t BasicBybitWebSocketClient<Policy>::send_subscribe_frames(const std::vector<std::string>& symbols) {
+    size_t frames = 0;
+    std::string msg;
+
+    for (size_t begin = 0; begin < symbols.size(); begin += MAX_SUBSCRIBE_ARGS) {
+        size_t end = std::min(begin + MAX_SUBSCRIBE_ARGS, symbols.size());
+
+        // Topic depth of the policy (the book holds up to OrderBook::MAX_LEVELS)
+        msg = "{\"req_id\":\"sub" + std::to_string(subscribe_requests_.load(std::memory_order_relaxed)) +
+              "\",\"op\":\"subscribe\",\"args\":[";
+        for (size_t i = begin; i < end; i++) {
+            if (i != begin) msg += ',';
+            msg += "\"orderbook." + std::to_string(Policy::DEPTH) + "." + symbols[i] + "\"";
+        }
+        msg += "]}";
+
+        if (!queue_frame_blocking(msg)) {
+            std::cerr << "❌ Subscribe frame failed (" << (end - begin) << " topics)\n";
+            continue;
+        }
+
+        subscribe_requests_.fetch_add(1, std::memory_order_relaxed);
+        for (size_t i = begin; i < end; i++) symbol_manager_.add_symbol(symbols[i]);
+        frames++;
+    }
+    return frames;
+}
+
+// {"success":true,"ret_msg":"","conn_id":"...","req_id":"sub3","op":"subscribe"}
+template <typename Policy>
+void BasicBybitWebSocketClient<Policy>::handle_subscribe_ack(simdjson::ondemand::document& doc) {
+    auto op_result = doc["op"];
+    if (op_result.error() || op_result.get_string().value() != "subscribe") return;
+
+    auto success_result = doc["success"];
+    if (!success_result.error() && success_result.get_bool().value()) {
+        subscribe_acks_.fetch_add(1, std::memory_order_relaxed);
         return;
     }
-    
-    orderbook_manager_.get_or_create(symbol);
-    
-    std::stringstream sub_msg;
-    // In BybitWebSocketClient::subscribe_to_symbol
-    sub_msg << "{\"op\":\"subscribe\",\"args\":[\"orderbook.50." << symbol << "\"]}";
-// Some testnet environments prefer "orderbook.1" for faster updates
-    
-    std::string msg = sub_msg.str();
-    unsigned char buf[LWS_PRE + 1024];
-    memcpy(&buf[LWS_PRE], msg.c_str(), msg.length());
-    
-    int written = lws_write(wsi_, &buf[LWS_PRE], msg.length(), LWS_WRITE_TEXT);
-    if (written > 0) {
-        symbol_manager_.add_symbol(symbol);
-        std::cout << "✅ Subscribed to " << symbol << "\n";
+
+    subscribe_failures_.fetch_add(1, std::memory_order_relaxed);
+    auto msg_result = doc["ret_msg"];
+    std::cerr << "❌ Subscription rejected: "
+              << (msg_result.error() ? std::string_view("unknown") : msg_result.get_string().value()) << "\n";
+}
+
+// Throws away a broken book and asks Bybit for a fresh snapshot.
+// Bybit only sends a snapshot on subscribe, so we unsubscribe and re-subscribe the topic.
+// Called from handle_message, i.e. on the service thread that owns this connection.
+template <typename Policy>
+void BasicBybitWebSocketClient<Policy>::request_resync(const std::string& symbol, uint64_t got_id, uint64_t book_id) {
+    resyncs_requested_.fetch_add(1, std::memory_order_relaxed);
+    std::cerr << "⚠️  Orderbook gap on " << symbol << " (book u=" << book_id
+              << ", received u=" << got_id << "). Resyncing...\n";
+
+    if (!wsi_ || !connected_) return;
+
+    std::string topic = "orderbook." + std::to_string(Policy::DEPTH) + "." + symbol;
+    std::string unsub = "{\"op\":\"unsubscribe\",\"args\":[\"" + topic + "\"]}";
+    std::string sub = "{\"op\":\"subscribe\",\"args\":[\"" + topic + "\"]}";
+
+    if (!queue_frame(unsub) || !queue_frame(sub)) {
+        std::cerr << "❌ Resync of " << symbol << " not queued: send queue full\n";
+        return;
     }
+    subscribe_requests_.fetch_add(1, std::memory_order_relaxed);   // Its ack is counted too
 }
 
 // ============================================================================
 // WEBSOCKET CALLBACKS
 // ============================================================================
 
-int BybitWebSocketClient::callback_function(
+template <typename Policy>
+int BasicBybitWebSocketClient<Policy>::callback_function(
     struct lws* wsi,
     enum lws_callback_reasons reason,
     void* user,
     void* in,
     size_t len
 ) {
-    BybitWebSocketClient* client = static_cast<BybitWebSocketClient*>(
+    BasicBybitWebSocketClient* client = static_cast<BasicBybitWebSocketClient*>(
         lws_context_user(lws_get_context(wsi)));
-    auto* session = static_cast<SessionData*>(user);
+    auto** slot = static_cast<SessionData**>(user);
+    SessionData* session = slot ? *slot : nullptr;
     
     switch (reason) {
-        case LWS_CALLBACK_CLIENT_ESTABLISHED:
+        case LWS_CALLBACK_CLIENT_ESTABLISHED: {
             std::cout << "✓ WebSocket connected (" 
-                      << (client->channel_type_ == ChannelType::PUBLIC ? "Public" : "Private") 
+                      << (client->is_public() ? "Public" : "Private") 
                       << ")\n";
+            if (slot && !session) {
+                session = *slot = new SessionData();
+                session->rx_buffer.reserve(RX_BUFFER_RESERVE + SIMDJSON_PADDING);
+            }
             if (session) session->rx_buffer.clear();
+
+            int64_t now = monotonic_ns();
+            client->last_rx_ns_ = now;
+            client->last_ping_ns_ = now;
+
+            // A standby connection takes over; the one it replaces is dropped
+            bool restored = wsi == client->standby_wsi_;
+            if (restored) {
+                struct lws* old = client->wsi_;
+                client->wsi_ = wsi;
+                client->standby_wsi_ = nullptr;
+                client->stalled_ = false;
+                if (old) lws_set_timeout(old, PENDING_TIMEOUT_USER_OK, LWS_TO_KILL_ASYNC);
+                client->drop_outbound();
+            }
             client->connected_ = true; 
+            client->set_line_live(true);
+            if (restored) client->on_connection_restored(now);
+            if (!client->outbound_.empty()) lws_callback_on_writable(wsi);
+            break;
+        }
+
+        // Another thread queued a frame and woke us with lws_cancel_service()
+        case LWS_CALLBACK_EVENT_WAIT_CANCELLED:
+            if (client && client->wsi_ && client->connected_ && !client->outbound_.empty()) {
+                lws_callback_on_writable(client->wsi_);
+            }
+            break;
+
+        case LWS_CALLBACK_CLIENT_WRITEABLE:
+            if (client && wsi == client->wsi_) client->write_outbound(wsi);
             break;
             
         case LWS_CALLBACK_CLIENT_RECEIVE: {
             if (!session || !client) break;
+            if (wsi != client->wsi_) break;     // Connection being replaced
+            client->last_rx_ns_ = monotonic_ns();
+            if (session->rx_buffer.empty()) session->rx_tick = tsc::now();
             session->rx_buffer.append(static_cast<char*>(in), len);
             
             if (lws_is_final_fragment(wsi)) {
-                if (client->channel_type_ == ChannelType::PUBLIC) {
-                    client->handle_message(const_cast<char*>(session->rx_buffer.data()), 
-                                         session->rx_buffer.length());
+                std::string& frame = session->rx_buffer;
+                // Keep padding behind the frame so simdjson can parse the buffer in place
+                if (frame.capacity() < frame.size() + SIMDJSON_PADDING) {
+                    frame.reserve(frame.size() + SIMDJSON_PADDING);
+                }
+
+                if (client->is_public()) {
+                    if (client->capture_) {
+                        client->capture_->append(FrameCapture::now_ns(), frame.data(), frame.size());
+                    }
+                    client->frame_rx_tick_ = session->rx_tick;
+                    client->handle_message(frame.data(), frame.size(), frame.capacity());
                 } else {
-                    client->handle_order_update(const_cast<char*>(session->rx_buffer.data()), 
-                                              session->rx_buffer.length());
+                    client->handle_order_update(frame.data(), frame.size(), frame.capacity());
                 }
-                session->rx_buffer.clear();
+                frame.clear();
             }
             break;
         }
@@ -313,10 +647,28 @@ int BybitWebSocketClient::callback_function(
         case LWS_CALLBACK_CLIENT_CLOSED:
         case LWS_CALLBACK_CLIENT_CONNECTION_ERROR:
             std::cout << "✗ WebSocket disconnected (" 
-                      << (client ? (client->channel_type_ == ChannelType::PUBLIC ? "Public" : "Private") : "Unknown")
+                      << (client ? (client->is_public() ? "Public" : "Private") : "Unknown")
                       << ")\n";
-            if (client) client->connected_ = false;
-            if (session) session->rx_buffer.clear();
+            if (client && wsi == client->standby_wsi_) {
+                // Standby attempt failed: the supervisor retries after the backoff
+                client->standby_wsi_ = nullptr;
+                client->schedule_reconnect(monotonic_ns());
+            } else if (client && wsi == client->wsi_) {
+                client->connected_ = false;
+                client->authenticated_ = false;
+                client->wsi_ = nullptr;
+                client->drop_outbound();
+                client->set_line_live(false);
+                if (client->running_) {
+                    int64_t now = monotonic_ns();
+                    client->begin_recovery(now);
+                    client->schedule_reconnect(now);
+                }
+            }
+            if (session) {
+                delete session;
+                *slot = nullptr;
+            }
             break;
             
         default:
@@ -329,89 +681,155 @@ int BybitWebSocketClient::callback_function(
 // MESSAGE HANDLERS
 // ============================================================================
 
-void BybitWebSocketClient::handle_message(char* data, size_t len) {
-    try {
-        // 1. Create a string from the raw data for logging
-        std::string raw_message(data, len);
+// Hot path: one call per public frame. Steady state makes zero heap allocations:
+// the frame is parsed in place, numbers are decoded from string_views, levels go into
+// preallocated scratch arrays and the symbol is resolved through the topic cache.
+// hot_path_allocations_ counts anything that slips through.
+template <typename Policy>
+void BasicBybitWebSocketClient<Policy>::handle_message(char* data, size_t len, size_t capacity) {
+    uint64_t allocs_before = alloc_counter::thread_allocations();
+    uint32_t symbol_id = SymbolRegistry::INVALID_ID;
 
+    try {
         // ====================================================================
         // [LOGGING] Write directly to File (No Terminal Output)
         // ====================================================================
         // This saves the exact JSON received from Bybit to your log file.
         // Format: [TIMESTAMP] [MARKET_DATA] {"topic":"orderbook...","data":...}
-        data_logger_.log("MARKET_DATA", raw_message);
+        Policy::Journal::log(data_logger_, "MARKET_DATA", std::string_view(data, len));
 
 
         // ====================================================================
 
-        simdjson::padded_string padded(data, len);
-        simdjson::ondemand::document doc = parser_.iterate(padded);
+        // Parse in place: the receive buffer carries SIMDJSON_PADDING spare capacity
+        simdjson::ondemand::document doc = parser_.iterate(data, len, capacity);
         
-        // 0. Check for operational success messages
-        auto success_result = doc["success"];
-        if (!success_result.error() && success_result.get_bool().value()) {
-            // Keep this one single print so you know subscription worked
-            std::cout << "✅ Subscription confirmed\n"; 
+        // 1. Extract Topic (absent on operational messages)
+        auto topic_result = doc["topic"];
+        if (topic_result.error()) {
+            // 0. Operational messages: count subscription acks (startup waits on them)
+            handle_subscribe_ack(doc);
             return;
         }
         
-        // 1. Extract Symbol
-        auto topic_result = doc["topic"];
-        if (topic_result.error()) return;
-        
         std::string_view topic_str = topic_result.get_string().value();
-        if (topic_str.find("orderbook") == std::string::npos) return;
-        
-        size_t last_dot = topic_str.rfind('.');
-        if (last_dot == std::string::npos) return;
-        std::string symbol(topic_str.substr(last_dot + 1));
+        TopicSlot* slot = resolve_topic(topic_str);
+        if (!slot) return;
+        OrderBook* orderbook = slot->book;
+        symbol_id = slot->symbol_id;
+        telemetry::bump(symbol_stats_[symbol_id].messages);
+
+        // 2. Identify Data Type (snapshot vs delta)
+        auto type_result = doc["type"];
+        bool is_snapshot = !type_result.error() && type_result.get_string().value() == "snapshot";
+
+        // Exchange push time ("ts", ms); in field order, so no rewind
+        uint64_t push_ms = 0;
+        auto ts_result = doc["ts"];
+        if (!ts_result.error()) push_ms = ts_result.get_uint64().value();
 
-        // 2. Identify Data Type (snapshot vs delta) 
         auto data_obj = doc["data"].get_object();
-        auto orderbook = orderbook_manager_.get_or_create(symbol);
 
-        // 3. Heartbeat Signal
-        orderbook->increment_update(); 
+        // 3. Parse Bids/Asks into the connection's scratch arrays
+        size_t bid_count = 0, ask_count = 0;
+        bool overflow = false;
 
-        // 4. Parse Bids/Asks (Logic remains the same)
-        std::vector<PriceLevel> bids, asks;
-        
         auto bids_arr = data_obj["b"];
         if (!bids_arr.error()) {
-            for (auto bid : bids_arr) {
-                auto arr = bid.get_array();
-                auto it = arr.begin();
-                std::string price = std::string((*it).get_string().value());
-                std::string qty = std::string((*(++it)).get_string().value());
-                bids.push_back({std::stod(price), std::stod(qty)});
-            }
+            overflow |= !decode_levels(bids_arr.get_array().value(), orderbook->instrument(),
+                                       bid_scratch_, bid_count);
         }
         
         auto asks_arr = data_obj["a"];
         if (!asks_arr.error()) {
-            for (auto ask : asks_arr) {
-                auto arr = ask.get_array();
-                auto it = arr.begin();
-                std::string price = std::string((*it).get_string().value());
-                std::string qty = std::string((*(++it)).get_string().value());
-                asks.push_back({std::stod(price), std::stod(qty)});
+            overflow |= !decode_levels(asks_arr.get_array().value(), orderbook->instrument(),
+                                       ask_scratch_, ask_count);
+        }
+
+        // 4. Sequencing ("u" = update ID, "seq" = cross sequence)
+        uint64_t update_id = data_obj["u"].get_uint64().value();
+        uint64_t seq = 0;
+        auto seq_result = data_obj["seq"];
+        if (!seq_result.error()) seq = seq_result.get_uint64().value();
+
+        std::span<const PriceLevel> bids(bid_scratch_.data(), bid_count);
+        std::span<const PriceLevel> asks(ask_scratch_.data(), ask_count);
+
+        LatencyRecorder& latency = LatencyRecorder::get_instance();
+        uint64_t parsed_tick = tsc::now();
+        latency.record_ticks(LatencyStage::WIRE_TO_PARSE, slot->symbol_id, frame_rx_tick_, parsed_tick);
+        if (push_ms != 0 && frame_rx_tick_ != 0) {
+            int64_t feed_ns = tsc::to_unix_ns(frame_rx_tick_) - static_cast<int64_t>(push_ms) * 1000000;
+            latency.record(LatencyStage::PUSH_TO_WIRE, slot->symbol_id, feed_ns > 0 ? static_cast<uint64_t>(feed_ns) : 0);
+            auto cts_result = doc["cts"];       // Matching engine time, after "data"
+            if (!cts_result.error()) {
+                uint64_t match_ms = cts_result.get_uint64().value();
+                if (match_ms != 0 && match_ms <= push_ms) {
+                    latency.record(LatencyStage::MATCH_TO_PUSH, slot->symbol_id, (push_ms - match_ms) * 1000000);
+                }
             }
         }
+
+        // 5. Apply to the book (u=1 is a snapshot pushed after a Bybit service restart).
+        // With redundant lines the first copy of an update wins; a gap on one line is
+        // covered by the others, so it only resyncs that line and leaves the book valid.
+        bool redundant = is_redundant_line();
+        bool snapshot_path = is_snapshot || update_id == 1;
+        OrderBook::ApplyResult result;
+        if (snapshot_path) {
+            // Levels past the scratch capacity are deeper than the book keeps anyway
+            result = orderbook->apply_snapshot(bids, asks, update_id, seq);
+            slot->resync_pending = false;
+        } else if (overflow) {
+            // A delta we could not decode completely would silently corrupt the book
+            if (!redundant) orderbook->invalidate();
+            result = OrderBook::ApplyResult::GAP;
+        } else {
+            result = orderbook->apply_delta(bids, asks, update_id, seq,
+                                            redundant ? OrderBook::GapPolicy::KEEP
+                                                      : OrderBook::GapPolicy::INVALIDATE);
+        }
+
+        // Reconnect recovery: done once every book of this line has its fresh snapshot
+        // (a STALE one counts: another line already brought the book past it)
+        if (slot->awaiting_snapshot && snapshot_path) {
+            slot->awaiting_snapshot = false;
+            if (recovery_pending_books_ > 0 && --recovery_pending_books_ == 0 && connected_ && !stalled_) {
+                finish_recovery(monotonic_ns());
+            }
+        }
+
+        if (result == OrderBook::ApplyResult::GAP && redundant) {
+            if (!slot->resync_pending) {
+                slot->resync_pending = true;
+                request_resync(slot->symbol, update_id, orderbook->get_last_update_id());
+            }
+            return;
+        }
+        if (result == OrderBook::ApplyResult::GAP || result == OrderBook::ApplyResult::NO_SNAPSHOT) {
+            if (orderbook->begin_resync()) {
+                request_resync(slot->symbol, update_id, orderbook->get_last_update_id());
+            }
+            return;
+        }
+        if (result == OrderBook::ApplyResult::STALE) {
+            duplicates_dropped_.fetch_add(1, std::memory_order_relaxed);
+            return;
+        }
+
+        uint64_t applied_tick = tsc::now();
+        latency.record_ticks(LatencyStage::PARSE_TO_BOOK, slot->symbol_id, parsed_tick, applied_tick);
+        orderbook->stamp_update(frame_rx_tick_, applied_tick);
+
+        // 6. Heartbeat Signal (only for updates that actually changed the book)
+        orderbook->increment_update();
+        orderbook_manager_.change_notifier().notify(slot->symbol_id);
         
-        // 5. Apply updates
-        if (!bids.empty()) orderbook->update_bids(bids);
-        if (!asks.empty()) orderbook->update_asks(asks);
-        
-        // 6. Aeron Persistence (Logic remains the same)
-        if (config_.enable_aeron && aeron_pub_) {
-            auto timestamp = std::chrono::duration_cast<std::chrono::nanoseconds>(
-                std::chrono::system_clock::now().time_since_epoch()).count();
-            
-            sbe_encoder_.encode_orderbook_snapshot(
-                timestamp, orderbook->get_bids(10), orderbook->get_asks(10), symbol);
-            
-            if (aeron_pub_->publish(sbe_encoder_.data(), sbe_encoder_.size())) {
-                aeron_published_.fetch_add(1, std::memory_order_relaxed);
+        // 7. Aeron: delta / snapshot of the published view, conflated per symbol
+        if constexpr (PUBLISHES_BOOKS) {
+            if (book_publication_) {
+                book_publication_->on_update(slot->publication, snapshot_path);
+                book_publication_->flush();
             }
         }
         
@@ -420,150 +838,111 @@ void BybitWebSocketClient::handle_message(char* data, size_t len) {
     } catch (const std::exception& e) {
         // Only log errors to terminal so you know if something breaks
         std::cerr << "⚠️  Orderbook Parse Error: " << e.what() << "\n";
+        telemetry::bump(parse_errors_);
+        if (symbol_id < SymbolRegistry::MAX_SYMBOLS && symbol_stats_) {
+            telemetry::bump(symbol_stats_[symbol_id].parse_errors);
+        }
     }
+
+    uint64_t allocs = alloc_counter::thread_allocations() - allocs_before;
+    if (allocs) hot_path_allocations_.fetch_add(allocs, std::memory_order_relaxed);
 }
 
-// [CRITICAL FIX AREA]
-void BybitWebSocketClient::handle_order_update(char* data, size_t len) {
-    try {
-        std::string raw_message(data, len);
-        data_logger_.log("ORDER_RES", raw_message);
-        
-        // Console logging for debugging
-        if (raw_message.find("\"topic\"") != std::string::npos || raw_message.find("\"op\"") != std::string::npos) {
-            std::cout << "🧪 Private Raw: " << raw_message.substr(0, 500) << (raw_message.length() > 500 ? "..." : "") << std::endl;
+// Decodes [["price","qty"], ...] into a fixed scratch array of ticks/lots without
+// building strings (decimal digits -> integer steps, no double in between).
+// Returns false if the array holds more levels than the scratch can take.
+template <typename Policy>
+bool BasicBybitWebSocketClient<Policy>::decode_levels(simdjson::ondemand::array levels, const InstrumentSpec& instrument,
+                                         LevelScratch& out, size_t& count) {
+    count = 0;
+    for (auto entry : levels) {
+        if (count == out.size()) return false;
+
+        auto pair = entry.get_array();
+        auto it = pair.begin();
+        std::string_view price = (*it).get_string().value();
+        std::string_view qty = (*(++it)).get_string().value();
+
+        PriceLevel& level = out[count];
+        Decimal price_d, qty_d;
+        if (!parse_decimal(price, price_d) || !parse_decimal(qty, qty_d) ||
+            !instrument.price_to_ticks(price_d, level.price) || !instrument.qty_to_lots(qty_d, level.quantity)) {
+            throw std::invalid_argument("bad price level");
         }
+        count++;
+    }
+    return true;
+}
 
-        simdjson::padded_string padded(data, len);
-        simdjson::ondemand::document doc = parser_.iterate(padded);
-        
-        // ====================================================================
-        // 1. Handle Operation Responses (Auth, Subscribe, Order Ack)
-        // ====================================================================
-        auto op_result = doc["op"];
-        if (!op_result.error()) {
-            std::string_view op = op_result.get_string().value();
-            
-            // --- Authentication ---
-            if (op == "auth") {
-                bool is_authenticated = false;
-                std::string error_msg = "Unknown Auth Error";
-
-                // FIX: Check for "retCode" (Format A)
-                auto retCodeRes = doc["retCode"];
-                if (!retCodeRes.error()) {
-                    if (retCodeRes.get_int64().value() == 0) {
-                        is_authenticated = true;
-                    } else {
-                        // Safely try to get retMsg
-                        auto msgRes = doc["retMsg"];
-                        if (!msgRes.error()) error_msg = msgRes.get_string().value();
-                    }
-                } 
-                // FIX: If "retCode" missing, check for "success" (Format B)
-                else {
-                    auto successRes = doc["success"];
-                    if (!successRes.error()) {
-                        if (successRes.get_bool().value()) {
-                            is_authenticated = true;
-                        } else {
-                            auto msgRes = doc["ret_msg"]; // Note underscore in this format
-                            if (!msgRes.error()) error_msg = msgRes.get_string().value();
-                        }
-                    }
-                }
+// Topic -> book lookup for this connection. The first message of a topic interns the
+// symbol in the SymbolRegistry and caches its ID and book (allocates once); every
+// later lookup is a heterogeneous string_view find, no lock and no directory access.
+template <typename Policy>
+auto BasicBybitWebSocketClient<Policy>::resolve_topic(std::string_view topic) -> TopicSlot* {
+    auto it = topic_slots_.find(topic);
+    if (it != topic_slots_.end()) return &slots_[it->second];
 
-                if (is_authenticated) {
-                    std::cout << "🔐 Authentication SUCCESS\n";
-                    
-                    // FIX: Only subscribe if this is the STREAM channel.
-                    // The TRADE channel (used for placing orders) rejects subscriptions with 10404.
-                    if (channel_type_ != ChannelType::PRIVATE_TRADE) {
-                        std::string sub_msg = R"({"op":"subscribe","args":["order.linear","execution.linear"]})";
-                        
-                        unsigned char buf[LWS_PRE + 1024];
-                        memcpy(&buf[LWS_PRE], sub_msg.c_str(), sub_msg.length());
-                        lws_write(wsi_, &buf[LWS_PRE], sub_msg.length(), LWS_WRITE_TEXT);
-                        std::cout << "📡 Subscribed to private topics: order, execution\n";
-                    }
-                } else {
-                    std::cerr << "❌ Authentication FAILED: " << error_msg << "\n";
-                }
-                return;
-            }
+    if (topic.find("orderbook") == std::string_view::npos) return nullptr;
+    size_t last_dot = topic.rfind('.');
+    if (last_dot == std::string_view::npos) return nullptr;
 
-            // --- Order Creation Acknowledgment ---
-            if (op == "order.create") {
-                // Check for retCode safely
-                auto retCodeRes = doc["retCode"];
-                int64_t ret_code = -1;
-                if (!retCodeRes.error()) ret_code = retCodeRes.get_int64().value();
+    TopicSlot slot;
+    slot.symbol = std::string(topic.substr(last_dot + 1));
+    slot.symbol_id = SymbolRegistry::get_instance().intern(slot.symbol);
+    slot.book = orderbook_manager_.get_or_create(slot.symbol_id);
+    if (!slot.book) return nullptr;
+    LatencyRecorder::get_instance().prepare_symbol(slot.symbol_id);
 
-                if (ret_code == 0) {
-                     auto orderLinkId = doc["data"]["orderLinkId"].get_string().value();
-                     std::cout << "✅ Order Accepted (Link ID: " << orderLinkId << ")\n";
-                } else {
-                     auto msgRes = doc["retMsg"];
-                     std::string msg = (!msgRes.error()) ? std::string(msgRes.get_string().value()) : "Unknown Error";
-                     std::cerr << "❌ Order REJECTED: " << msg << "\n";
-                     
-                     // Notify Strategy of Rejection
-                     auto reqIdRes = doc["reqId"]; // Some responses use reqId for linkId
-                     if (!reqIdRes.error() && on_order_update_) {
-                         on_order_update_(std::string(reqIdRes.get_string().value()), "Rejected", msg);
-                     }
-                }
-                return;
-            }
-            
-            // --- Order Cancellation Acknowledgment ---
-            if (op == "order.cancel") {
-                auto retCodeRes = doc["retCode"];
-                if (!retCodeRes.error() && retCodeRes.get_int64().value() == 0) {
-                     std::cout << "✅ Cancellation Accepted\n";
-                } else {
-                     auto msgRes = doc["retMsg"];
-                     std::string msg = (!msgRes.error()) ? std::string(msgRes.get_string().value()) : "Unknown Error";
-                     std::cerr << "❌ Cancel REJECTED: " << msg << "\n";
-                }
-                return;
-            }
-        }
-        
-        // ====================================================================
-        // 2. Handle Real-Time Data Pushes (Topics)
-        // ====================================================================
-        auto topic_res = doc["topic"];
-        if (!topic_res.error()) {
-            std::string_view topic = topic_res.get_string().value();
-
-            if (topic.find("execution") != std::string_view::npos) {
-                auto data_arr = doc["data"].get_array();
-                for (auto item : data_arr) {
-                    auto oid = item["orderLinkId"].get_string().value();
-                    if (on_order_update_) {
-                        on_order_update_(std::string(oid), "Filled", "");
-                    }
-                }
-            }
-            else if (topic.find("order") != std::string_view::npos) {
-                auto data_arr = doc["data"].get_array();
-                for (auto item : data_arr) {
-                    std::string_view order_link_id = item["orderLinkId"].get_string().value();
-                    std::string_view status = item["orderStatus"].get_string().value(); 
-                    
-                    std::cout << "📊 Order Status Update: " << order_link_id << " → " << status << "\n";
-                    
-                    if (on_order_update_) {
-                        on_order_update_(std::string(order_link_id), std::string(status), "");
-                    }
-                }
+    uint32_t id = static_cast<uint32_t>(slots_.size());
+    slots_.push_back(std::move(slot));
+    topic_slots_.emplace(std::string(topic), id);
+
+    TopicSlot& stored = slots_[id];     // Deque: the address is stable from here on
+    stored.publication.symbol_id = stored.symbol_id;
+    stored.publication.symbol = stored.symbol;
+    stored.publication.book = stored.book;
+    if constexpr (PUBLISHES_BOOKS) {
+        if (book_publication_) book_publication_->add_symbol(stored.publication);
+    }
+    return &stored;
+}
+
+// Private channels: the decoder emits the order updates (batched to the engines); what
+// is left here is the connection's own business (auth, subscribe, request errors).
+template <typename Policy>
+void BasicBybitWebSocketClient<Policy>::handle_order_update(char* data, size_t len, size_t capacity) {
+    Policy::Journal::log(data_logger_, "ORDER_RES", std::string_view(data, len));
+    PrivateStreamDecoder::Frame frame = private_decoder_.decode(data, len, capacity);
+
+    switch (frame.kind) {
+        case PrivateStreamDecoder::FrameKind::AUTH:
+            if (!frame.success) {
+                std::cerr << "❌ Authentication FAILED: "
+                          << (frame.message.empty() ? std::string_view("Unknown Auth Error") : frame.message) << "\n";
+                break;
             }
-        } 
+            std::cout << "🔐 Authentication SUCCESS\n";
+            authenticated_ = true;
 
-    } catch (const std::exception& e) {
-        // This catches malformed JSON or unexpected formats
-        std::cerr << "⚠️  Private Stream Error: " << e.what() << "\n";
+            // Also after every reconnect: the topics die with the connection
+            subscribe_to_private_topics();
+            break;
+
+        case PrivateStreamDecoder::FrameKind::ORDER_CREATE:
+            // Rejects also reach the engine as a REJECT update
+            if (!frame.success) std::cerr << "❌ Order REJECTED: " << frame.message << "\n";
+            break;
+
+        case PrivateStreamDecoder::FrameKind::ORDER_CANCEL:
+            if (!frame.success) std::cerr << "❌ Cancel REJECTED: " << frame.message << "\n";
+            break;
+
+        case PrivateStreamDecoder::FrameKind::MALFORMED:
+            std::cerr << "⚠️  Private Stream Error: malformed frame (" << len << " bytes)\n";
+            break;
+
+        default:
+            break;
     }
 }
 
@@ -571,21 +950,122 @@ void BybitWebSocketClient::handle_order_update(char* data, size_t len) {
 // METRICS
 // ============================================================================
 
-uint64_t BybitWebSocketClient::get_message_count() const {
+template <typename Policy>
+uint64_t BasicBybitWebSocketClient<Policy>::get_message_count() const {
     return messages_received_.load();
 }
 
-uint64_t BybitWebSocketClient::get_aeron_count() const {
-    return aeron_published_.load();
+template <typename Policy>
+uint64_t BasicBybitWebSocketClient<Policy>::get_aeron_count() const {
+    if (!book_publication_) return 0;
+    return book_publication_->get_snapshots_sent() + book_publication_->get_deltas_sent();
+}
+
+template <typename Policy>
+uint64_t BasicBybitWebSocketClient<Policy>::get_aeron_deltas() const {
+    return book_publication_ ? book_publication_->get_deltas_sent() : 0;
+}
+
+template <typename Policy>
+uint64_t BasicBybitWebSocketClient<Policy>::get_resync_count() const {
+    return resyncs_requested_.load();
+}
+
+template <typename Policy>
+uint64_t BasicBybitWebSocketClient<Policy>::get_duplicate_count() const {
+    return duplicates_dropped_.load();
+}
+
+template <typename Policy>
+uint64_t BasicBybitWebSocketClient<Policy>::get_parse_error_count() const {
+    return parse_errors_.load(std::memory_order_relaxed);
+}
+
+template <typename Policy>
+uint64_t BasicBybitWebSocketClient<Policy>::get_aeron_backpressure() const {
+    return aeron_pub_ ? aeron_pub_->get_offer_failures() : 0;
+}
+
+template <typename Policy>
+uint64_t BasicBybitWebSocketClient<Policy>::get_aeron_conflated() const {
+    uint64_t parked = aeron_pub_ ? aeron_pub_->get_conflated_count() : 0;
+    return parked + (book_publication_ ? book_publication_->get_conflated_updates() : 0);
+}
+
+template <typename Policy>
+uint64_t BasicBybitWebSocketClient<Policy>::get_symbol_messages(uint32_t symbol_id) const {
+    if (!symbol_stats_ || symbol_id >= SymbolRegistry::MAX_SYMBOLS) return 0;
+    return symbol_stats_[symbol_id].messages.load(std::memory_order_relaxed);
+}
+
+template <typename Policy>
+uint64_t BasicBybitWebSocketClient<Policy>::get_symbol_parse_errors(uint32_t symbol_id) const {
+    if (!symbol_stats_ || symbol_id >= SymbolRegistry::MAX_SYMBOLS) return 0;
+    return symbol_stats_[symbol_id].parse_errors.load(std::memory_order_relaxed);
+}
+
+template <typename Policy>
+uint64_t BasicBybitWebSocketClient<Policy>::get_hot_path_allocations() const {
+    return hot_path_allocations_.load();
+}
+
+// Subscribe frames sent but not answered yet (either way)
+template <typename Policy>
+uint64_t BasicBybitWebSocketClient<Policy>::get_pending_subscribe_acks() const {
+    uint64_t answered = subscribe_acks_.load() + subscribe_failures_.load();
+    uint64_t sent = subscribe_requests_.load();
+    return sent > answered ? sent - answered : 0;
+}
+
+template <typename Policy>
+uint64_t BasicBybitWebSocketClient<Policy>::get_subscribe_failures() const {
+    return subscribe_failures_.load();
+}
+
+template <typename Policy>
+uint64_t BasicBybitWebSocketClient<Policy>::get_reconnect_count() const {
+    return reconnects_.load();
+}
+
+template <typename Policy>
+uint64_t BasicBybitWebSocketClient<Policy>::get_last_recovery_ms() const {
+    return last_recovery_ms_.load();
 }
 
-void BybitWebSocketClient::subscribe_to_private_topics() {
+template <typename Policy>
+uint64_t BasicBybitWebSocketClient<Policy>::get_max_recovery_ms() const {
+    return max_recovery_ms_.load();
+}
+
+template <typename Policy>
+void BasicBybitWebSocketClient<Policy>::enable_capture(const std::string& path_prefix) {
+    if (!is_public()) return;
+    capture_ = std::make_unique<FrameCapture>(path_prefix, config_.capture_segment_bytes);
+    if (!capture_->is_open()) capture_.reset();
+}
+
+template <typename Policy>
+uint64_t BasicBybitWebSocketClient<Policy>::get_captured_frames() const {
+    return capture_ ? capture_->frames_written() : 0;
+}
+
+template <typename Policy>
+void BasicBybitWebSocketClient<Policy>::subscribe_to_private_topics() {
+    // The TRADE channel (used for placing orders) rejects subscriptions with 10404
     if (channel_type_ != ChannelType::PRIVATE_STREAM) return;
-    
-    // Subscribe to "execution" (fills) and "order" (status changes)
-    std::string msg = R"({"op":"subscribe","args":["execution","order"]})";
-    
-    unsigned char buf[LWS_PRE + 1024];
-    memcpy(&buf[LWS_PRE], msg.c_str(), msg.length());
-    lws_write(wsi_, &buf[LWS_PRE], msg.length(), LWS_WRITE_TEXT);
-}
\ No newline at end of file
+
+    // Linear only, and exactly one set: the all-category "execution" / "order" topics
+    // would deliver every report a second time
+    if (!queue_frame(R"({"op":"subscribe","args":["order.linear","execution.linear"]})")) {
+        std::cerr << "❌ Private topics not subscribed: send queue full\n";
+        return;
+    }
+    std::cout << "📡 Subscribed to private topics: order, execution\n";
+}
+
+// ============================================================================
+// INSTANTIATIONS
+// ============================================================================
+
+template class BasicBybitWebSocketClient<RuntimeFeedPolicy>;
+template class BasicBybitWebSocketClient<PublicFeedPolicy<>>;
@@ -0,0 +1,322 @@
+#include "network/FeedHandlerPool.h"
+#include "utils/ThreadAffinity.h"
+#include <algorithm>
+#include <iostream>
+#include <sstream>
+#include <iomanip>
+#include <chrono>
+#include <ctime>
+#include <sys/stat.h>
+
+// ============================================================================
+// CONSTRUCTION
+// ============================================================================
+
+FeedHandlerPool::FeedHandlerPool(
+    OrderBookManager& obm,
+    SymbolManager& sm,
+    BotConfiguration& config,
+    DataLogger& logger
+) : orderbook_manager_(obm),
+    config_(config),
+    owner_(SymbolRegistry::MAX_SYMBOLS, UNASSIGNED),
+    is_subscribed_(SymbolRegistry::MAX_SYMBOLS, false)
+{
+    int count = std::clamp(config_.feed_shards, 1, static_cast<int>(UNASSIGNED));
+    size_t lines = static_cast<size_t>(std::clamp(config_.feed_lines, 1, 8));
+
+    for (int i = 0; i < count; i++) {
+        auto shard = std::make_unique<Shard>();
+        shard->group.lines = lines;
+        for (size_t k = 0; k < lines; k++) {
+            auto client = std::make_unique<PublicFeedClient>(
+                obm, sm, config_, logger, PublicFeedClient::ChannelType::PUBLIC);
+            if (!config_.feed_line_hosts.empty()) {
+                client->set_endpoint(config_.feed_line_hosts[k % config_.feed_line_hosts.size()]);
+            }
+            client->join_line_group(&shard->group);
+            shard->lines.push_back(std::move(client));
+        }
+        shards_.push_back(std::move(shard));
+    }
+    shard_load_.assign(shards_.size(), 0);
+
+    if (config_.capture_enabled) {
+        // Same start-time naming as the data log
+        auto time = std::chrono::system_clock::to_time_t(std::chrono::system_clock::now());
+        std::stringstream ss;
+        ss << std::put_time(std::localtime(&time), "%Y%m%d_%H%M%S");
+        mkdir(config_.capture_dir.c_str(), 0777);
+        for (size_t i = 0; i < shards_.size(); i++) {
+            auto& lines = shards_[i]->lines;
+            for (size_t k = 0; k < lines.size(); k++) {
+                std::string name = config_.capture_dir + "/" + ss.str() + "_feed" + std::to_string(i);
+                if (lines.size() > 1) name += line_suffix(k);
+                lines[k]->enable_capture(name);
+            }
+        }
+    }
+
+    // Pin the isolated symbols first so each lands on its own shard.
+    // At least one shard is always left for everything else.
+    for (const auto& symbol : config_.feed_isolated_symbols) {
+        if (isolated_shards_ + 1 >= shards_.size()) break;
+        uint32_t id = SymbolRegistry::get_instance().intern(symbol);
+        if (id == SymbolRegistry::INVALID_ID || owner_[id] != UNASSIGNED) continue;
+        owner_[id] = static_cast<uint8_t>(isolated_shards_);
+        shard_load_[isolated_shards_]++;
+        isolated_shards_++;
+    }
+
+    std::cout << "✓ Feed handler pool: " << shards_.size() << " public shard(s), "
+              << isolated_shards_ << " dedicated";
+    if (lines > 1) std::cout << ", " << lines << " redundant lines each";
+    std::cout << "\n";
+}
+
+FeedHandlerPool::~FeedHandlerPool() {
+    stop();
+}
+
+// ============================================================================
+// LIFECYCLE
+// ============================================================================
+
+// Line k of a shard is "a", "b", ... in thread and capture names
+std::string FeedHandlerPool::line_suffix(size_t line) {
+    return std::string(1, static_cast<char>('a' + line));
+}
+
+void FeedHandlerPool::connect() {
+    for (auto& shard : shards_) {
+        for (auto& line : shard->lines) line->connect();
+    }
+}
+
+// feed_shard_cores is indexed by service thread: shard-major, one entry per line
+void FeedHandlerPool::start() {
+    size_t thread_index = 0;
+    for (size_t i = 0; i < shards_.size(); i++) {
+        auto& lines = shards_[i]->lines;
+        for (size_t k = 0; k < lines.size(); k++, thread_index++) {
+            ThreadPlacement placement;
+            placement.core = thread_index < config_.feed_shard_cores.size() ? config_.feed_shard_cores[thread_index] : -1;
+            placement.fifo_priority = config_.feed_fifo_priority;
+            PublicFeedClient* client = lines[k].get();
+            std::string name = "feed-" + std::to_string(i) + (lines.size() > 1 ? line_suffix(k) : "");
+
+            threads_.emplace_back([client, placement, name]() {
+                std::cout << "  ✓ Public WS " << name << " started"
+                          << thread_affinity::apply_placement(name, placement) << "\n";
+                client->run();
+            });
+        }
+    }
+}
+
+void FeedHandlerPool::stop() {
+    for (auto& shard : shards_) {
+        for (auto& line : shard->lines) line->stop();
+    }
+    for (auto& t : threads_) {
+        if (t.joinable()) t.join();
+    }
+    threads_.clear();
+}
+
+bool FeedHandlerPool::all_connected() const {
+    for (const auto& shard : shards_) {
+        for (const auto& line : shard->lines) {
+            if (!line->is_connected()) return false;
+        }
+    }
+    return true;
+}
+
+// ============================================================================
+// SYMBOL OWNERSHIP
+// ============================================================================
+
+// Least-loaded shard among the non-dedicated ones. The assignment never changes
+// afterwards, so a book is only ever written by its shard's line thread(s).
+size_t FeedHandlerPool::assign_shard(uint32_t symbol_id) {
+    if (owner_[symbol_id] != UNASSIGNED) return owner_[symbol_id];
+
+    size_t best = isolated_shards_;
+    for (size_t i = isolated_shards_; i < shards_.size(); i++) {
+        if (shard_load_[i] < shard_load_[best]) best = i;
+    }
+    owner_[symbol_id] = static_cast<uint8_t>(best);
+    shard_load_[best]++;
+    return best;
+}
+
+size_t FeedHandlerPool::shard_for(uint32_t symbol_id) const {
+    if (symbol_id >= owner_.size() || owner_[symbol_id] == UNASSIGNED) return shards_.size();
+    return owner_[symbol_id];
+}
+
+void FeedHandlerPool::subscribe_to_symbol(const std::string& symbol) {
+    uint32_t id = SymbolRegistry::get_instance().intern(symbol);
+    if (id == SymbolRegistry::INVALID_ID || is_subscribed_[id]) return;
+    for (auto& line : shards_[assign_shard(id)]->lines) line->subscribe_to_symbol(symbol);
+    is_subscribed_[id] = true;
+    subscribed_.push_back(id);
+}
+
+size_t FeedHandlerPool::subscribe_to_symbols(const std::vector<std::string>& symbols) {
+    std::vector<std::vector<std::string>> per_shard(shards_.size());
+    for (const auto& symbol : symbols) {
+        uint32_t id = SymbolRegistry::get_instance().intern(symbol);
+        if (id == SymbolRegistry::INVALID_ID || is_subscribed_[id]) continue;
+        per_shard[assign_shard(id)].push_back(symbol);
+        is_subscribed_[id] = true;
+        subscribed_.push_back(id);
+    }
+
+    // Every shard's frames go out before any ack is awaited
+    size_t frames = 0, topics = 0;
+    for (size_t i = 0; i < shards_.size(); i++) {
+        if (per_shard[i].empty()) continue;
+        for (auto& line : shards_[i]->lines) frames += line->subscribe_to_symbols(per_shard[i]);
+        topics += per_shard[i].size();
+    }
+    std::cout << "📡 Subscribing " << topics << " orderbook topics in " << frames
+              << " frame(s) over " << shards_.size() << " shard(s)\n";
+    return frames;
+}
+
+// ============================================================================
+// WARM-UP
+// ============================================================================
+
+bool FeedHandlerPool::wait_until_warm(std::chrono::milliseconds timeout, const std::atomic<bool>& running) {
+    auto start = std::chrono::steady_clock::now();
+    auto deadline = start + timeout;
+    size_t warm = 0;        // subscribed_[0, warm) have their first snapshot
+
+    while (running.load(std::memory_order_relaxed)) {
+        uint64_t pending = 0;
+        for_each_line([&](const PublicFeedClient& line) { pending += line.get_pending_subscribe_acks(); });
+
+        // Books fill in roughly subscribe order: resume from the first cold one
+        while (warm < subscribed_.size()) {
+            OrderBook* book = orderbook_manager_.get(subscribed_[warm]);
+            if (!book || book->get_update_count() == 0) break;
+            warm++;
+        }
+
+        if (pending == 0 && warm == subscribed_.size()) {
+            auto ms = std::chrono::duration_cast<std::chrono::milliseconds>(
+                std::chrono::steady_clock::now() - start).count();
+            std::cout << "✓ All " << subscribed_.size() << " books warm in " << ms << "ms\n";
+            return true;
+        }
+        if (std::chrono::steady_clock::now() >= deadline) break;
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+
+    size_t cold = 0;
+    for (uint32_t id : subscribed_) {
+        OrderBook* book = orderbook_manager_.get(id);
+        if (book && book->get_update_count() > 0) continue;
+        if (cold++ < 10) std::cerr << "  ⚠️ No snapshot yet: " << SymbolRegistry::get_instance().name(id) << "\n";
+    }
+    uint64_t failures = 0;
+    for_each_line([&](const PublicFeedClient& line) { failures += line.get_subscribe_failures(); });
+    std::cerr << "⚠️  Warm-up incomplete: " << cold << "/" << subscribed_.size()
+              << " books cold, " << failures << " subscription(s) rejected\n";
+    return false;
+}
+
+// ============================================================================
+// METRICS
+// ============================================================================
+
+uint64_t FeedHandlerPool::get_message_count() const {
+    uint64_t total = 0;
+    for_each_line([&](const PublicFeedClient& line) { total += line.get_message_count(); });
+    return total;
+}
+
+uint64_t FeedHandlerPool::get_aeron_count() const {
+    uint64_t total = 0;
+    for_each_line([&](const PublicFeedClient& line) { total += line.get_aeron_count(); });
+    return total;
+}
+
+uint64_t FeedHandlerPool::get_resync_count() const {
+    uint64_t total = 0;
+    for_each_line([&](const PublicFeedClient& line) { total += line.get_resync_count(); });
+    return total;
+}
+
+uint64_t FeedHandlerPool::get_duplicate_count() const {
+    uint64_t total = 0;
+    for_each_line([&](const PublicFeedClient& line) { total += line.get_duplicate_count(); });
+    return total;
+}
+
+uint64_t FeedHandlerPool::get_hot_path_allocations() const {
+    uint64_t total = 0;
+    for_each_line([&](const PublicFeedClient& line) { total += line.get_hot_path_allocations(); });
+    return total;
+}
+
+uint64_t FeedHandlerPool::get_captured_frames() const {
+    uint64_t total = 0;
+    for_each_line([&](const PublicFeedClient& line) { total += line.get_captured_frames(); });
+    return total;
+}
+
+uint64_t FeedHandlerPool::get_reconnect_count() const {
+    uint64_t total = 0;
+    for_each_line([&](const PublicFeedClient& line) { total += line.get_reconnect_count(); });
+    return total;
+}
+
+uint64_t FeedHandlerPool::get_parse_error_count() const {
+    uint64_t total = 0;
+    for_each_line([&](const PublicFeedClient& line) { total += line.get_parse_error_count(); });
+    return total;
+}
+
+uint64_t FeedHandlerPool::get_aeron_backpressure() const {
+    uint64_t total = 0;
+    for_each_line([&](const PublicFeedClient& line) { total += line.get_aeron_backpressure(); });
+    return total;
+}
+
+uint64_t FeedHandlerPool::get_aeron_deltas() const {
+    uint64_t total = 0;
+    for_each_line([&](const PublicFeedClient& line) { total += line.get_aeron_deltas(); });
+    return total;
+}
+
+uint64_t FeedHandlerPool::get_aeron_conflated() const {
+    uint64_t total = 0;
+    for_each_line([&](const PublicFeedClient& line) { total += line.get_aeron_conflated(); });
+    return total;
+}
+
+uint64_t FeedHandlerPool::get_symbol_messages(uint32_t symbol_id) const {
+    size_t owner = shard_for(symbol_id);
+    if (owner >= shards_.size()) return 0;
+    uint64_t total = 0;
+    for (const auto& line : shards_[owner]->lines) total += line->get_symbol_messages(symbol_id);
+    return total;
+}
+
+uint64_t FeedHandlerPool::get_symbol_parse_errors(uint32_t symbol_id) const {
+    size_t owner = shard_for(symbol_id);
+    if (owner >= shards_.size()) return 0;
+    uint64_t total = 0;
+    for (const auto& line : shards_[owner]->lines) total += line->get_symbol_parse_errors(symbol_id);
+    return total;
+}
+
+uint64_t FeedHandlerPool::get_max_recovery_ms() const {
+    uint64_t worst = 0;
+    for_each_line([&](const PublicFeedClient& line) { worst = std::max(worst, line.get_max_recovery_ms()); });
+    return worst;
+}
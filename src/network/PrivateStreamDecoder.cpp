@@ -0,0 +1,162 @@
+#include "network/PrivateStreamDecoder.h"
+#include "utils/Tsc.h"
+
+// ============================================================================
+// FRAME
+// ============================================================================
+
+PrivateStreamDecoder::Frame PrivateStreamDecoder::decode(char* data, size_t length, size_t capacity) {
+    Frame frame;
+    rx_tick_ = tsc::now();
+
+    try {
+        simdjson::ondemand::document doc = parser_.iterate(data, length, capacity);
+        std::string_view op, topic, req_id;
+        bool has_ret_code = false, success = false;
+
+        // Field order differs between responses ("op" comes after "success" in auth
+        // responses); pushes always name their topic before "data"
+        for (auto field : doc.get_object()) {
+            std::string_view key = field.unescaped_key().value();
+            if (key == "op") {
+                op = field.value().get_string().value();
+            } else if (key == "topic") {
+                topic = field.value().get_string().value();
+            } else if (key == "retCode") {
+                has_ret_code = true;
+                success = field.value().get_int64().value() == 0;
+            } else if (key == "success") {
+                if (!has_ret_code) success = field.value().get_bool().value();
+            } else if (key == "retMsg" || key == "ret_msg") {
+                frame.message = field.value().get_string().value();
+            } else if (key == "reqId") {
+                req_id = field.value().get_string().value();
+            } else if (key == "data" && !topic.empty()) {
+                if (topic.starts_with("execution")) {
+                    decode_executions(field.value().get_array().value(), frame);
+                } else if (topic.starts_with("order")) {
+                    decode_orders(field.value().get_array().value(), frame);
+                }
+            }
+        }
+
+        frame.success = success;
+        if (!topic.empty()) {
+            frame.kind = topic.starts_with("execution") || topic.starts_with("order") ? FrameKind::TOPIC
+                                                                                      : FrameKind::OTHER;
+        } else if (op == "auth") {
+            frame.kind = FrameKind::AUTH;
+        } else if (op == "order.create") {
+            frame.kind = FrameKind::ORDER_CREATE;
+            // The trade channel echoes the orderLinkId we sent as reqId
+            OrderUpdate update;
+            if (!success && !req_id.empty() && start_update(req_id, update)) {
+                update.type = OrderEventType::REJECT;
+                update.status = OrderStatus::REJECTED;
+                emit(update, frame);
+            }
+        } else if (op == "order.cancel") {
+            frame.kind = FrameKind::ORDER_CANCEL;
+        } else if (op == "subscribe") {
+            frame.kind = FrameKind::SUBSCRIBE;
+        }
+    } catch (const simdjson::simdjson_error&) {
+        frame.kind = FrameKind::MALFORMED;
+    }
+
+    flush();
+    return frame;
+}
+
+// ============================================================================
+// RECORDS
+// ============================================================================
+
+void PrivateStreamDecoder::decode_executions(simdjson::ondemand::array records, Frame& frame) {
+    for (auto item : records) {
+        std::string_view order_link_id, symbol, exec_id, exec_type, exec_qty, exec_price, leaves_qty;
+        for (auto field : item.get_object()) {
+            std::string_view key = field.unescaped_key().value();
+            if (key == "orderLinkId") order_link_id = field.value().get_string().value();
+            else if (key == "symbol") symbol = field.value().get_string().value();
+            else if (key == "execId") exec_id = field.value().get_string().value();
+            else if (key == "execType") exec_type = field.value().get_string().value();
+            else if (key == "execQty") exec_qty = field.value().get_string().value();
+            else if (key == "execPrice") exec_price = field.value().get_string().value();
+            else if (key == "leavesQty") leaves_qty = field.value().get_string().value();
+        }
+        if (exec_type == "Funding") continue;       // Not an execution of an order
+
+        OrderUpdate update;
+        if (!start_update(order_link_id, update)) continue;
+        if (!parse_decimal(exec_qty, update.exec_qty) || !parse_decimal(exec_price, update.exec_price)) continue;
+
+        // Without leavesQty the execution is taken as the last one
+        Decimal leaves;
+        bool done = leaves_qty.empty() || (parse_decimal(leaves_qty, leaves) && leaves.mantissa == 0);
+        update.type = done ? OrderEventType::FILL : OrderEventType::PARTIAL_FILL;
+        if (!exec_id.empty()) update.exec_id = std::hash<std::string_view>{}(exec_id) | 1;  // Never 0
+        update.symbol = symbol;
+        emit(update, frame);
+    }
+}
+
+void PrivateStreamDecoder::decode_orders(simdjson::ondemand::array records, Frame& frame) {
+    for (auto item : records) {
+        std::string_view order_link_id, symbol, status_text;
+        for (auto field : item.get_object()) {
+            std::string_view key = field.unescaped_key().value();
+            if (key == "orderLinkId") order_link_id = field.value().get_string().value();
+            else if (key == "symbol") symbol = field.value().get_string().value();
+            else if (key == "orderStatus") status_text = field.value().get_string().value();
+        }
+
+        OrderUpdate update;
+        update.status = parse_order_status(status_text);
+        switch (update.status) {
+            case OrderStatus::NEW:
+                update.type = OrderEventType::ACK;
+                break;
+            case OrderStatus::CANCELLED:
+            case OrderStatus::PARTIALLY_FILLED_CANCELLED:
+            case OrderStatus::DEACTIVATED:
+                update.type = OrderEventType::CANCEL;
+                break;
+            case OrderStatus::REJECTED:
+                update.type = OrderEventType::REJECT;
+                break;
+            default:
+                continue;       // Fills come with their quantities on the execution topic
+        }
+        if (!start_update(order_link_id, update)) continue;
+        update.symbol = symbol;
+        emit(update, frame);
+    }
+}
+
+bool PrivateStreamDecoder::start_update(std::string_view order_link_id, OrderUpdate& update) {
+    if (!ClientOrderId::decode(order_link_id, update.id)) {
+        foreign_.fetch_add(1, std::memory_order_relaxed);     // Manual / other bots' orders
+        return false;
+    }
+    update.rx_tick = rx_tick_;
+    return true;
+}
+
+// ============================================================================
+// BATCH
+// ============================================================================
+
+void PrivateStreamDecoder::emit(const OrderUpdate& update, Frame& frame) {
+    batch_[batch_size_++] = update;
+    frame.updates++;
+    if (batch_size_ == MAX_BATCH) flush();
+}
+
+void PrivateStreamDecoder::flush() {
+    if (batch_size_ == 0) return;
+    if (sink_.call) sink_.call(sink_.target, std::span<const OrderUpdate>(batch_.data(), batch_size_));
+    updates_.fetch_add(batch_size_, std::memory_order_relaxed);
+    batches_.fetch_add(1, std::memory_order_relaxed);
+    batch_size_ = 0;
+}
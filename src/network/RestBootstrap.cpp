@@ -0,0 +1,408 @@
+#include "network/RestBootstrap.h"
+#include <openssl/hmac.h>
+#include <sys/stat.h>
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <ctime>
+#include <iostream>
+
+namespace {
+std::string to_hex(const unsigned char* bytes, unsigned int length) {
+    static constexpr char DIGITS[] = "0123456789abcdef";
+    std::string hex(length * 2, '0');
+    for (unsigned int i = 0; i < length; i++) {
+        hex[2 * i] = DIGITS[bytes[i] >> 4];
+        hex[2 * i + 1] = DIGITS[bytes[i] & 0xF];
+    }
+    return hex;
+}
+}
+
+const ExchangePosition* RestBootstrap::Result::find_position(std::string_view symbol) const {
+    for (const auto& position : positions) {
+        if (position.symbol == symbol) return &position;
+    }
+    return nullptr;
+}
+
+size_t RestBootstrap::Result::count_open_orders(std::string_view symbol) const {
+    return static_cast<size_t>(std::count_if(open_orders.begin(), open_orders.end(),
+                                             [&](const ExchangeOrder& order) { return order.symbol == symbol; }));
+}
+
+RestBootstrap::RestBootstrap(const BotConfiguration& config)
+    : config_(config),
+      multi_(curl_multi_init()) {
+    if (multi_) {
+        // Concurrent requests to one host share its HTTP/2 connection
+        curl_multi_setopt(multi_, CURLMOPT_PIPELINING, CURLPIPE_MULTIPLEX);
+    }
+}
+
+RestBootstrap::~RestBootstrap() {
+    for (auto& chain : chains_) {
+        if (chain.easy) {
+            if (multi_) curl_multi_remove_handle(multi_, chain.easy);   // Still in flight after a timeout
+            curl_easy_cleanup(chain.easy);
+        }
+        if (chain.headers) curl_slist_free_all(chain.headers);
+    }
+    if (multi_) curl_multi_cleanup(multi_);
+}
+
+// ============================================================================
+// EVENT LOOP
+// ============================================================================
+
+RestBootstrap::Result RestBootstrap::run() {
+    auto start = std::chrono::steady_clock::now();
+    if (!chains_.empty()) return result_;      // One run per instance
+
+    // Warm restart: a fresh instrument cache replaces the instruments-info chain
+    const std::string& cache_path = config_.instrument_cache_path;
+    struct stat st{};
+    bool cache_exists = !cache_path.empty() && ::stat(cache_path.c_str(), &st) == 0;
+    bool cache_fresh = cache_exists && std::time(nullptr) - st.st_mtime < config_.instrument_cache_max_age_s;
+    if (cache_fresh && BybitRestClient::load_instrument_cache(cache_path, result_.instruments) &&
+        !result_.instruments.empty()) {
+        result_.instruments_from_cache = true;
+    } else {
+        result_.instruments.clear();
+    }
+
+    // Fixed before the first request: the write callbacks hold pointers into chains_
+    chains_.reserve(3);
+    if (!result_.instruments_from_cache) {
+        add_chain(Endpoint::INSTRUMENTS, "instruments-info", config_.rest_public_host,
+                  "/v5/market/instruments-info", "category=linear&limit=1000", false);
+    }
+    bool have_keys = !config_.api_key.empty() && !config_.api_secret.empty();
+    if (have_keys) {
+        add_chain(Endpoint::OPEN_ORDERS, "open orders", config_.rest_private_host,
+                  "/v5/order/realtime", "category=linear&settleCoin=USDT&limit=50", true);
+        add_chain(Endpoint::POSITIONS, "positions", config_.rest_private_host,
+                  "/v5/position/list", "category=linear&settleCoin=USDT&limit=200", true);
+    } else {
+        std::cerr << "⚠️  REST bootstrap: no API keys, skipping the order/position snapshots\n";
+    }
+
+    if (!multi_) {
+        std::cerr << "❌ REST bootstrap: curl_multi_init failed\n";
+        for (auto& chain : chains_) chain.done = chain.failed = true;
+    }
+
+    for (auto& chain : chains_) {
+        if (chain.done) continue;
+        chain.easy = curl_easy_init();
+        if (!chain.easy) {
+            chain.done = chain.failed = true;
+            continue;
+        }
+        CURL* easy = chain.easy;
+        curl_easy_setopt(easy, CURLOPT_WRITEFUNCTION, write_callback);
+        curl_easy_setopt(easy, CURLOPT_WRITEDATA, &chain);
+        curl_easy_setopt(easy, CURLOPT_PRIVATE, &chain);
+        curl_easy_setopt(easy, CURLOPT_ERRORBUFFER, chain.error.data());
+        curl_easy_setopt(easy, CURLOPT_HTTP_VERSION, CURL_HTTP_VERSION_2TLS);
+        curl_easy_setopt(easy, CURLOPT_PIPEWAIT, 1L);
+        curl_easy_setopt(easy, CURLOPT_TCP_KEEPALIVE, 1L);
+        curl_easy_setopt(easy, CURLOPT_TCP_NODELAY, 1L);
+        curl_easy_setopt(easy, CURLOPT_ACCEPT_ENCODING, "");        // gzip: instruments-info is ~1 MB
+        curl_easy_setopt(easy, CURLOPT_TIMEOUT_MS, static_cast<long>(config_.rest_timeout_ms));
+        curl_easy_setopt(easy, CURLOPT_SSL_VERIFYPEER, 1L);
+        curl_easy_setopt(easy, CURLOPT_SSL_VERIFYHOST, 2L);
+        curl_easy_setopt(easy, CURLOPT_USERAGENT, "BybitBot/1.0");
+        if (!chain.signed_request) {
+            chain.headers = curl_slist_append(nullptr, "Accept: application/json");
+            curl_easy_setopt(easy, CURLOPT_HTTPHEADER, chain.headers);
+        }
+        if (!start_page(chain)) chain.done = chain.failed = true;
+    }
+
+    std::cout << "🔄 REST bootstrap: " << chains_.size() << " request chains in flight...\n";
+    auto deadline = start + std::chrono::milliseconds(config_.rest_timeout_ms);
+    while (std::any_of(chains_.begin(), chains_.end(), [](const Chain& chain) { return !chain.done; })) {
+        int running = 0;
+        curl_multi_perform(multi_, &running);
+
+        int queued = 0;
+        while (CURLMsg* msg = curl_multi_info_read(multi_, &queued)) {
+            if (msg->msg != CURLMSG_DONE) continue;
+            char* owner = nullptr;
+            curl_easy_getinfo(msg->easy_handle, CURLINFO_PRIVATE, &owner);
+            CURLcode code = msg->data.result;       // msg is invalid once the handle is removed
+            on_page_done(*reinterpret_cast<Chain*>(owner), code);
+        }
+
+        if (std::chrono::steady_clock::now() > deadline) {
+            for (auto& chain : chains_) {
+                if (chain.done) continue;
+                std::cerr << "❌ REST " << chain.name << ": timed out after " << chain.pages << " pages\n";
+                chain.done = chain.failed = true;
+            }
+            break;
+        }
+        curl_multi_poll(multi_, nullptr, 0, 50, nullptr);
+    }
+
+    // Instruments: the fetch rewrites the cache; without it a stale cache beats nothing
+    for (const auto& chain : chains_) {
+        if (chain.endpoint != Endpoint::INSTRUMENTS) continue;
+        if (!chain.failed && !result_.instruments.empty()) {
+            if (!cache_path.empty() && !BybitRestClient::save_instrument_cache(cache_path, result_.instruments)) {
+                std::cerr << "⚠️  Could not write instrument cache " << cache_path << "\n";
+            }
+        } else {
+            result_.instruments.clear();
+            if (cache_exists && BybitRestClient::load_instrument_cache(cache_path, result_.instruments) &&
+                !result_.instruments.empty()) {
+                result_.instruments_from_cache = true;
+                std::cerr << "⚠️  instruments-info fetch failed, using stale cache (" << cache_path << ")\n";
+            } else {
+                result_.instruments.clear();
+                std::cerr << "❌ No instrument metadata: prices fall back to a 1e-8 grid\n";
+            }
+        }
+    }
+
+    // Snapshots are all or nothing: half a position list would read as flat symbols
+    result_.snapshots_ok = have_keys && std::none_of(chains_.begin(), chains_.end(), [](const Chain& chain) {
+        return chain.signed_request && chain.failed;
+    });
+    if (!result_.snapshots_ok) {
+        result_.open_orders.clear();
+        result_.positions.clear();
+    }
+
+    result_.elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start);
+    std::cout << "✓ REST bootstrap: " << result_.instruments.size() << " instruments"
+              << (result_.instruments_from_cache ? " (cache)" : "");
+    if (result_.snapshots_ok) {
+        std::cout << ", " << result_.open_orders.size() << " open orders, " << result_.positions.size() << " positions";
+    }
+    std::cout << " in " << result_.elapsed.count() << "ms (" << result_.requests << " requests)\n";
+    return result_;
+}
+
+// ============================================================================
+// REQUESTS
+// ============================================================================
+
+void RestBootstrap::add_chain(Endpoint endpoint, const char* name, const std::string& host,
+                              const char* path, const char* query, bool signed_request) {
+    Chain& chain = chains_.emplace_back();
+    chain.endpoint = endpoint;
+    chain.name = name;
+    chain.host = host;
+    chain.path = path;
+    chain.query = query;
+    chain.signed_request = signed_request;
+}
+
+bool RestBootstrap::start_page(Chain& chain) {
+    std::string query = chain.query;
+    if (!chain.cursor.empty()) {
+        char* escaped = curl_easy_escape(chain.easy, chain.cursor.c_str(), static_cast<int>(chain.cursor.size()));
+        if (!escaped) return false;
+        query += "&cursor=";
+        query += escaped;
+        curl_free(escaped);
+    }
+
+    // Signed requests carry a timestamp: new headers for every page
+    if (chain.signed_request) {
+        if (chain.headers) curl_slist_free_all(chain.headers);
+        chain.headers = sign(query);
+        curl_easy_setopt(chain.easy, CURLOPT_HTTPHEADER, chain.headers);
+    }
+
+    std::string url = "https://" + chain.host + chain.path + "?" + query;
+    curl_easy_setopt(chain.easy, CURLOPT_URL, url.c_str());    // Copied by curl
+    chain.received = 0;
+    chain.error[0] = '\0';
+    chain.pages++;
+    result_.requests++;
+    return curl_multi_add_handle(multi_, chain.easy) == CURLM_OK;
+}
+
+void RestBootstrap::on_page_done(Chain& chain, CURLcode code) {
+    // Removed and re-added for the next page: the connection stays in the multi cache
+    curl_multi_remove_handle(multi_, chain.easy);
+
+    long http_code = 0;
+    curl_easy_getinfo(chain.easy, CURLINFO_RESPONSE_CODE, &http_code);
+
+    if (code != CURLE_OK) {
+        std::cerr << "❌ REST " << chain.name << ": "
+                  << (chain.error[0] ? chain.error.data() : curl_easy_strerror(code)) << "\n";
+        chain.failed = true;
+    } else if (http_code != 200) {
+        std::cerr << "❌ REST " << chain.name << ": HTTP " << http_code << "\n";
+        chain.failed = true;
+    } else if (!parse_page(chain)) {
+        chain.failed = true;
+    } else if (!chain.cursor.empty()) {
+        if (chain.pages >= MAX_PAGES) {
+            // A truncated list is no snapshot: all or nothing
+            std::cerr << "❌ REST " << chain.name << ": more than " << MAX_PAGES
+                      << " pages, dropped cursor " << chain.cursor << "\n";
+            chain.failed = true;
+        } else if (start_page(chain)) {
+            return;
+        } else {
+            chain.failed = true;
+        }
+    }
+    chain.done = true;
+}
+
+curl_slist* RestBootstrap::sign(const std::string& query) const {
+    std::string timestamp = std::to_string(std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::system_clock::now().time_since_epoch()).count());
+    std::string recv_window = std::to_string(config_.rest_recv_window_ms);
+
+    // v5: HMAC_SHA256(secret, timestamp + apiKey + recvWindow + queryString)
+    std::string payload = timestamp + config_.api_key + recv_window + query;
+    unsigned char digest[EVP_MAX_MD_SIZE];
+    unsigned int digest_length = 0;
+    HMAC(EVP_sha256(), config_.api_secret.data(), static_cast<int>(config_.api_secret.size()),
+         reinterpret_cast<const unsigned char*>(payload.data()), payload.size(), digest, &digest_length);
+
+    curl_slist* headers = curl_slist_append(nullptr, "Accept: application/json");
+    headers = curl_slist_append(headers, ("X-BAPI-API-KEY: " + config_.api_key).c_str());
+    headers = curl_slist_append(headers, ("X-BAPI-TIMESTAMP: " + timestamp).c_str());
+    headers = curl_slist_append(headers, ("X-BAPI-RECV-WINDOW: " + recv_window).c_str());
+    headers = curl_slist_append(headers, ("X-BAPI-SIGN: " + to_hex(digest, digest_length)).c_str());
+    return headers;
+}
+
+// Straight into the chain's buffer, which only ever grows (pages reuse it)
+size_t RestBootstrap::write_callback(char* data, size_t size, size_t nmemb, void* user) {
+    Chain& chain = *static_cast<Chain*>(user);
+    size_t length = size * nmemb;
+    size_t needed = chain.received + length + SIMDJSON_PADDING;
+    if (needed > chain.body.size()) chain.body.resize(std::max(needed, chain.body.size() * 2));
+    std::memcpy(chain.body.data() + chain.received, data, length);
+    chain.received += length;
+    return length;
+}
+
+// ============================================================================
+// DECODING
+// ============================================================================
+
+bool RestBootstrap::parse_page(Chain& chain) {
+    chain.cursor.clear();
+    if (chain.received == 0) {
+        std::cerr << "❌ REST " << chain.name << ": empty response\n";
+        return false;
+    }
+    if (chain.body.size() < chain.received + SIMDJSON_PADDING) {
+        chain.body.resize(chain.received + SIMDJSON_PADDING);
+    }
+
+    try {
+        simdjson::ondemand::document doc = parser_.iterate(chain.body.data(), chain.received, chain.body.size());
+        int64_t code = -1;
+        std::string_view message;
+
+        // retCode / retMsg precede result in every v5 response
+        for (auto field : doc.get_object()) {
+            std::string_view key = field.unescaped_key().value();
+            if (key == "retCode") {
+                code = field.value().get_int64().value();
+            } else if (key == "retMsg") {
+                message = field.value().get_string().value();
+            } else if (key == "result" && code == 0) {
+                for (auto part : field.value().get_object()) {
+                    std::string_view name = part.unescaped_key().value();
+                    if (name == "list") {
+                        simdjson::ondemand::array list = part.value().get_array().value();
+                        switch (chain.endpoint) {
+                            case Endpoint::INSTRUMENTS: parse_instruments(list); break;
+                            case Endpoint::OPEN_ORDERS: parse_open_orders(list); break;
+                            case Endpoint::POSITIONS:   parse_positions(list); break;
+                        }
+                    } else if (name == "nextPageCursor") {
+                        chain.cursor = std::string(part.value().get_string().value());
+                    }
+                }
+            }
+        }
+
+        if (code != 0) {
+            std::cerr << "❌ REST " << chain.name << ": retCode " << code << " (" << message << ")\n";
+            return false;
+        }
+    } catch (const simdjson::simdjson_error& e) {
+        std::cerr << "❌ REST " << chain.name << " parse error: " << e.what() << "\n";
+        return false;
+    }
+    return true;
+}
+
+void RestBootstrap::parse_instruments(simdjson::ondemand::array list) {
+    for (auto item : list) {
+        InstrumentInfo info;
+        bool trading = true;
+        for (auto field : item.get_object()) {
+            std::string_view key = field.unescaped_key().value();
+            if (key == "symbol") {
+                info.symbol = std::string(field.value().get_string().value());
+            } else if (key == "status") {
+                trading = field.value().get_string().value() == "Trading";
+            } else if (key == "priceFilter") {
+                for (auto filter : field.value().get_object()) {
+                    if (filter.unescaped_key().value() == "tickSize") {
+                        info.tick_size = std::string(filter.value().get_string().value());
+                    }
+                }
+            } else if (key == "lotSizeFilter") {
+                for (auto filter : field.value().get_object()) {
+                    std::string_view name = filter.unescaped_key().value();
+                    if (name == "qtyStep") info.qty_step = std::string(filter.value().get_string().value());
+                    else if (name == "minOrderQty") info.min_order_qty = std::string(filter.value().get_string().value());
+                }
+            }
+        }
+        if (!trading || info.symbol.empty() || info.tick_size.empty() || info.qty_step.empty()) continue;
+        result_.instruments.push_back(std::move(info));
+    }
+}
+
+void RestBootstrap::parse_open_orders(simdjson::ondemand::array list) {
+    for (auto item : list) {
+        ExchangeOrder order;
+        for (auto field : item.get_object()) {
+            std::string_view key = field.unescaped_key().value();
+            if (key == "symbol") order.symbol = std::string(field.value().get_string().value());
+            else if (key == "orderLinkId") order.order_link_id = std::string(field.value().get_string().value());
+            else if (key == "side") order.side = std::string(field.value().get_string().value());
+            else if (key == "price") order.price = std::string(field.value().get_string().value());
+            else if (key == "qty") order.qty = std::string(field.value().get_string().value());
+            else if (key == "leavesQty") order.leaves_qty = std::string(field.value().get_string().value());
+            else if (key == "orderStatus") order.order_status = std::string(field.value().get_string().value());
+        }
+        result_.open_orders.push_back(std::move(order));
+    }
+}
+
+void RestBootstrap::parse_positions(simdjson::ondemand::array list) {
+    for (auto item : list) {
+        ExchangePosition position;
+        for (auto field : item.get_object()) {
+            std::string_view key = field.unescaped_key().value();
+            if (key == "symbol") position.symbol = std::string(field.value().get_string().value());
+            else if (key == "side") position.side = std::string(field.value().get_string().value());
+            else if (key == "size") position.size = std::string(field.value().get_string().value());
+            else if (key == "avgPrice") position.avg_price = std::string(field.value().get_string().value());
+        }
+        // Flat symbols are listed too (side "", size "0")
+        if (position.side.empty() || position.size.empty() ||
+            position.size.find_first_not_of("0.") == std::string::npos) {
+            continue;
+        }
+        result_.positions.push_back(std::move(position));
+    }
+}
@@ -0,0 +1,95 @@
+#include "replay/CaptureReader.h"
+#include <iostream>
+#include <algorithm>
+#include <cstring>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+CaptureReader::CaptureReader(const std::string& path_prefix)
+    : prefix_(prefix_from_path(path_prefix))
+{
+    if (!open_segment(0)) {
+        std::cerr << "❌ Capture not found: " << FrameCapture::segment_path(prefix_, 0) << "\n";
+    }
+}
+
+CaptureReader::~CaptureReader() {
+    close_segment();
+}
+
+std::string CaptureReader::prefix_from_path(const std::string& path) {
+    // "<prefix>.0000.cap" -> "<prefix>"
+    const std::string suffix = ".cap";
+    if (path.size() > 9 && path.compare(path.size() - suffix.size(), suffix.size(), suffix) == 0 &&
+        path[path.size() - 9] == '.') {
+        return path.substr(0, path.size() - 9);
+    }
+    return path;
+}
+
+bool CaptureReader::open_segment(uint64_t index) {
+    std::string path = FrameCapture::segment_path(prefix_, index);
+    fd_ = open(path.c_str(), O_RDONLY);
+    if (fd_ < 0) return false;
+
+    struct stat st;
+    if (fstat(fd_, &st) != 0 || static_cast<size_t>(st.st_size) < sizeof(CaptureSegmentHeader)) {
+        ::close(fd_);
+        fd_ = -1;
+        return false;
+    }
+
+    mapped_bytes_ = static_cast<size_t>(st.st_size);
+    void* mem = mmap(nullptr, mapped_bytes_, PROT_READ, MAP_SHARED, fd_, 0);
+    if (mem == MAP_FAILED) {
+        ::close(fd_);
+        fd_ = -1;
+        return false;
+    }
+
+    base_ = static_cast<const char*>(mem);
+    auto* header = reinterpret_cast<const CaptureSegmentHeader*>(base_);
+    if (std::memcmp(header->magic, CAPTURE_MAGIC, sizeof(CAPTURE_MAGIC)) != 0 ||
+        header->version != CAPTURE_VERSION) {
+        std::cerr << "❌ Not a capture segment (or unsupported version): " << path << "\n";
+        close_segment();
+        return false;
+    }
+
+    offset_ = header->header_bytes;
+    end_offset_ = std::min<uint64_t>(header->end_offset.load(std::memory_order_acquire), mapped_bytes_);
+    segment_index_ = index;
+    return true;
+}
+
+void CaptureReader::close_segment() {
+    if (base_) munmap(const_cast<char*>(base_), mapped_bytes_);
+    if (fd_ >= 0) ::close(fd_);
+    base_ = nullptr;
+    fd_ = -1;
+}
+
+bool CaptureReader::next(CapturedFrame& frame) {
+    while (base_) {
+        if (offset_ + sizeof(CaptureFrameHeader) <= end_offset_) {
+            CaptureFrameHeader header;
+            std::memcpy(&header, base_ + offset_, sizeof(header));
+            uint64_t record = (sizeof(header) + header.length + 7) & ~uint64_t(7);
+            if (offset_ + sizeof(header) + header.length > end_offset_) break;   // Torn tail
+
+            frame.recv_ns = header.recv_ns;
+            frame.data = base_ + offset_ + sizeof(header);
+            frame.length = header.length;
+            offset_ += record;
+            return true;
+        }
+
+        // Segment exhausted: move on to the next one (if the capture rolled over)
+        uint64_t next_index = segment_index_ + 1;
+        close_segment();
+        if (!open_segment(next_index)) return false;
+    }
+    return false;
+}
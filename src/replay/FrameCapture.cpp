@@ -0,0 +1,121 @@
+#include "replay/FrameCapture.h"
+#include <iostream>
+#include <cstdio>
+#include <cstring>
+#include <ctime>
+#include <new>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+
+FrameCapture::FrameCapture(const std::string& path_prefix, size_t segment_bytes)
+    : prefix_(path_prefix),
+      segment_bytes_(segment_bytes < 1024 * 1024 ? 1024 * 1024 : segment_bytes)
+{
+    if (open_segment(0)) {
+        std::cout << "✓ Frame capture: " << segment_path(prefix_, 0) << "\n";
+    }
+}
+
+FrameCapture::~FrameCapture() {
+    close();
+}
+
+int64_t FrameCapture::now_ns() {
+    struct timespec ts;
+    clock_gettime(CLOCK_REALTIME, &ts);
+    return static_cast<int64_t>(ts.tv_sec) * 1000000000LL + ts.tv_nsec;
+}
+
+std::string FrameCapture::segment_path(const std::string& path_prefix, uint64_t index) {
+    char suffix[32];
+    std::snprintf(suffix, sizeof(suffix), ".%04llu.cap", static_cast<unsigned long long>(index));
+    return path_prefix + suffix;
+}
+
+// ============================================================================
+// SEGMENTS
+// ============================================================================
+
+bool FrameCapture::open_segment(uint64_t index) {
+    std::string path = segment_path(prefix_, index);
+    fd_ = open(path.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644);
+    if (fd_ < 0) {
+        std::cerr << "❌ Frame capture: cannot create " << path << "\n";
+        return false;
+    }
+
+    // Sparse file: blocks are only allocated as frames are written
+    if (ftruncate(fd_, static_cast<off_t>(segment_bytes_)) != 0) {
+        std::cerr << "❌ Frame capture: cannot size " << path << "\n";
+        ::close(fd_);
+        fd_ = -1;
+        return false;
+    }
+
+    void* mem = mmap(nullptr, segment_bytes_, PROT_READ | PROT_WRITE, MAP_SHARED, fd_, 0);
+    if (mem == MAP_FAILED) {
+        std::cerr << "❌ Frame capture: mmap failed for " << path << "\n";
+        ::close(fd_);
+        fd_ = -1;
+        return false;
+    }
+
+    base_ = static_cast<char*>(mem);
+    header_ = new (base_) CaptureSegmentHeader{};
+    std::memcpy(header_->magic, CAPTURE_MAGIC, sizeof(CAPTURE_MAGIC));
+    header_->version = CAPTURE_VERSION;
+    header_->header_bytes = sizeof(CaptureSegmentHeader);
+    header_->segment_index = index;
+    header_->created_ns = now_ns();
+    offset_ = sizeof(CaptureSegmentHeader);
+    header_->end_offset.store(offset_, std::memory_order_release);
+    segment_index_ = index;
+    return true;
+}
+
+// Trims the sparse tail so the file on disk is exactly the recorded frames
+void FrameCapture::close_segment() {
+    if (!base_) return;
+    munmap(base_, segment_bytes_);
+    if (ftruncate(fd_, static_cast<off_t>(offset_)) != 0) {
+        std::cerr << "⚠️  Frame capture: failed to trim " << segment_path(prefix_, segment_index_) << "\n";
+    }
+    ::close(fd_);
+    fd_ = -1;
+    base_ = nullptr;
+    header_ = nullptr;
+}
+
+void FrameCapture::close() {
+    close_segment();
+}
+
+// ============================================================================
+// HOT PATH
+// ============================================================================
+
+bool FrameCapture::append(int64_t recv_ns, const char* data, size_t len) {
+    uint64_t record = (sizeof(CaptureFrameHeader) + len + 7) & ~uint64_t(7);
+    if (!base_ || record > segment_bytes_ - sizeof(CaptureSegmentHeader)) {
+        frames_dropped_.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+
+    if (offset_ + record > segment_bytes_) {
+        close_segment();
+        if (!open_segment(segment_index_ + 1)) {
+            frames_dropped_.fetch_add(1, std::memory_order_relaxed);
+            return false;
+        }
+    }
+
+    CaptureFrameHeader frame{recv_ns, static_cast<uint32_t>(len), 0};
+    std::memcpy(base_ + offset_, &frame, sizeof(frame));
+    std::memcpy(base_ + offset_ + sizeof(frame), data, len);
+    offset_ += record;
+    header_->end_offset.store(offset_, std::memory_order_release);
+
+    frames_written_.fetch_add(1, std::memory_order_relaxed);
+    return true;
+}
@@ -0,0 +1,125 @@
+#include "replay/ReplayDriver.h"
+#include "utils/EngineClock.h"
+#include <iostream>
+#include <thread>
+
+ReplayDriver::ReplayDriver(
+    PublicFeedClient& client,
+    OrderBookManager& obm,
+    SymbolManager& sm,
+    DataLogger& logger,
+    const ReplayOptions& options
+) : client_(client),
+    orderbook_manager_(obm),
+    symbol_manager_(sm),
+    logger_(logger),
+    options_(options)
+{
+    frame_buffer_.reserve(65536 + SIMDJSON_PADDING);
+
+    if (!options_.trade_symbol.empty()) {
+        symbol_manager_.add_symbol(options_.trade_symbol);
+        trade_symbol_id_ = SymbolRegistry::get_instance().intern(options_.trade_symbol);
+    }
+}
+
+ReplayDriver::~ReplayDriver() {
+    engine_clock::clear_replay_time();
+}
+
+bool ReplayDriver::add_capture(const std::string& path) {
+    auto reader = std::make_unique<CaptureReader>(path);
+    if (!reader->is_open()) return false;
+
+    Source source{std::move(reader), {}, false};
+    source.has_head = source.reader->next(source.head);
+    std::cout << "✓ Replay source: " << source.reader->prefix() << "\n";
+    sources_.push_back(std::move(source));
+    return true;
+}
+
+// Earliest pending frame across all sources (ties go to the lower source index)
+int ReplayDriver::next_source() const {
+    int best = -1;
+    for (size_t i = 0; i < sources_.size(); i++) {
+        if (!sources_[i].has_head) continue;
+        if (best < 0 || sources_[i].head.recv_ns < sources_[best].head.recv_ns) {
+            best = static_cast<int>(i);
+        }
+    }
+    return best;
+}
+
+void ReplayDriver::pace(int64_t capture_offset_ns, std::chrono::steady_clock::time_point wall_start) const {
+    if (options_.speed <= 0.0) return;
+
+    auto target = wall_start + std::chrono::nanoseconds(
+        static_cast<int64_t>(static_cast<double>(capture_offset_ns) / options_.speed));
+
+    for (;;) {
+        auto remaining = target - std::chrono::steady_clock::now();
+        if (remaining <= std::chrono::nanoseconds(0)) return;
+        // Sleep the bulk of long gaps, spin the last stretch for accurate spacing
+        if (remaining > std::chrono::microseconds(200)) {
+            std::this_thread::sleep_for(remaining - std::chrono::microseconds(100));
+        } else {
+            cpu_pause();
+        }
+    }
+}
+
+// The engine constructor waits for a valid book, so it is only created once the
+// replayed feed has produced one.
+void ReplayDriver::maybe_start_engine() {
+    if (engine_ || trade_symbol_id_ == SymbolRegistry::INVALID_ID) return;
+
+    OrderBook* book = orderbook_manager_.get(trade_symbol_id_);
+    TopOfBook top;
+    if (!book || book->get_update_count() == 0 || !book->get_top_of_book(top)) return;
+
+    engine_ = std::make_unique<TradingEngine>(
+        options_.trade_symbol, orderbook_manager_, symbol_manager_, logger_, nullptr, nullptr);
+}
+
+ReplayStats ReplayDriver::run(const std::atomic<bool>& running) {
+    ReplayStats stats;
+    int source = next_source();
+    if (source < 0) return stats;
+
+    const int64_t first_ns = sources_[source].head.recv_ns;
+    int64_t last_ns = first_ns;
+    auto wall_start = std::chrono::steady_clock::now();
+
+    while (source >= 0 && running.load(std::memory_order_relaxed)) {
+        Source& src = sources_[source];
+        const CapturedFrame& frame = src.head;
+
+        pace(frame.recv_ns - first_ns, wall_start);
+        engine_clock::set_replay_time(frame.recv_ns);
+
+        // The mapping is read-only and only 8-byte padded: copy into the padded buffer
+        frame_buffer_.assign(frame.data, frame.length);
+        if (frame_buffer_.capacity() < frame_buffer_.size() + SIMDJSON_PADDING) {
+            frame_buffer_.reserve(frame_buffer_.size() + SIMDJSON_PADDING);
+        }
+        client_.ingest_frame(frame_buffer_.data(), frame_buffer_.size(), frame_buffer_.capacity());
+
+        stats.frames++;
+        stats.bytes += frame.length;
+        last_ns = frame.recv_ns;
+
+        maybe_start_engine();
+        if (engine_) {
+            engine_->run_trading_cycle();
+            stats.trading_cycles++;
+        }
+
+        src.has_head = src.reader->next(src.head);
+        source = next_source();
+    }
+
+    stats.capture_span_ns = last_ns - first_ns;
+    stats.wall_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now() - wall_start).count();
+    return stats;
+}
@@ -0,0 +1,230 @@
+#include "trading/EngineScheduler.h"
+#include "utils/ThreadAffinity.h"
+#include <algorithm>
+#include <iostream>
+
+// ============================================================================
+// SETUP
+// ============================================================================
+
+EngineScheduler::EngineScheduler(
+    OrderBookManager& obm,
+    SymbolManager& sm,
+    DataLogger& logger,
+    BotConfiguration& config,
+    BybitWebSocketClient* trade_client,
+    std::shared_ptr<AeronPublisher> aeron_pub
+) : orderbook_manager_(obm),
+    symbol_manager_(sm),
+    logger_(logger),
+    config_(config),
+    trade_client_(trade_client),
+    aeron_publisher_(std::move(aeron_pub)),
+    engine_by_symbol_(SymbolRegistry::MAX_SYMBOLS, NO_ENGINE),
+    worker_state_(std::make_unique<WorkerState[]>(static_cast<size_t>(std::max(config.engine_workers, 1)))),
+    tick_ns_(static_cast<int64_t>(std::max(config.engine_idle_timeout_us, 1)) * 1000),
+    steal_after_ns_(static_cast<int64_t>(std::max(config.engine_steal_after_us, 0)) * 1000)
+{
+}
+
+EngineScheduler::~EngineScheduler() {
+    stop();
+}
+
+void EngineScheduler::add_engine(const std::string& symbol) {
+    uint32_t id = SymbolRegistry::get_instance().intern(symbol);
+    if (id == SymbolRegistry::INVALID_ID || engine_by_symbol_[id] != NO_ENGINE) return;
+    if (slots_.size() >= NO_ENGINE) return;
+
+    auto slot = std::make_unique<EngineSlot>();
+    slot->engine = std::make_unique<TradingEngine>(
+        symbol, orderbook_manager_, symbol_manager_, logger_, trade_client_, aeron_publisher_,
+        static_cast<uint16_t>(slots_.size()), config_.signal_params, config_.entry_at_microprice);
+    slot->home = slots_.size() % worker_count_config();
+    orderbook_manager_.change_notifier().watch(id, slot->home);     // Book changes ring the home only
+
+    engine_by_symbol_[id] = static_cast<uint16_t>(slots_.size());
+    slots_.push_back(std::move(slot));
+}
+
+void EngineScheduler::attach(BybitWebSocketClient& client) {
+    client.set_order_update_callback([this](std::span<const OrderUpdate> updates) { route_order_updates(updates); });
+}
+
+bool EngineScheduler::wait_for_market_data(std::chrono::milliseconds timeout) {
+    std::cout << "⏳ Waiting for initial market data (" << slots_.size() << " engines)...\n";
+    std::vector<bool> ready(slots_.size(), false);
+    size_t ready_count = 0;
+    auto deadline = std::chrono::steady_clock::now() + timeout;
+
+    while (ready_count < slots_.size() && std::chrono::steady_clock::now() < deadline) {
+        for (size_t i = 0; i < slots_.size(); i++) {
+            if (!ready[i] && slots_[i]->engine->market_data_ready()) {
+                ready[i] = true;
+                ready_count++;
+            }
+        }
+        if (ready_count < slots_.size()) std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    }
+
+    for (size_t i = 0; i < slots_.size(); i++) {
+        if (!ready[i]) {
+            std::cerr << "⚠️ WARNING: " << slots_[i]->engine->get_symbol()
+                      << " started without valid market data. Engine may pause.\n";
+        }
+    }
+    return ready_count == slots_.size();
+}
+
+// ============================================================================
+// LIFECYCLE
+// ============================================================================
+
+void EngineScheduler::start() {
+    if (running_.exchange(true)) return;
+
+    size_t count = worker_count_config();
+    for (size_t w = 0; w < count; w++) {
+        ThreadPlacement placement;
+        placement.core = w < config_.engine_worker_cores.size() ? config_.engine_worker_cores[w] : -1;
+        placement.fifo_priority = config_.engine_fifo_priority;
+        workers_.emplace_back([this, w, placement]() {
+            std::cout << "  ✓ Engine worker " << w << " started"
+                      << thread_affinity::apply_placement("engine-" + std::to_string(w), placement) << "\n";
+            worker_loop(w);
+        });
+    }
+    std::cout << "✓ Engine scheduler: " << slots_.size() << " engine(s) on "
+              << count << " worker(s)\n";
+}
+
+void EngineScheduler::stop() {
+    if (!running_.exchange(false)) return;
+    orderbook_manager_.change_notifier().ring_all();            // Unpark blocked workers
+    for (auto& t : workers_) {
+        if (t.joinable()) t.join();
+    }
+    workers_.clear();
+}
+
+// ============================================================================
+// ROUTING
+// ============================================================================
+
+void EngineScheduler::route_order_updates(std::span<const OrderUpdate> updates) {
+    uint32_t doorbells = 0;
+    for (const OrderUpdate& update : updates) route(update, doorbells);
+
+    // One wakeup per home worker for the batch
+    BookChangeNotifier& notifier = orderbook_manager_.change_notifier();
+    for (size_t i = 0; doorbells != 0; i++, doorbells >>= 1) {
+        if (doorbells & 1) notifier.doorbell(i).ring();
+    }
+}
+
+void EngineScheduler::route(const OrderUpdate& update, uint32_t& doorbells) {
+    auto deliver = [&](EngineSlot& slot) {
+        slot.engine->enqueue_order_update(update);
+        doorbells |= uint32_t(1) << (slot.home % BookChangeNotifier::MAX_DOORBELLS);
+    };
+
+    // Hot path: the engine ID is in the order ID
+    if (update.id.from_this_session()) {
+        if (update.id.engine_id < slots_.size()) deliver(*slots_[update.id.engine_id]);
+        return;
+    }
+
+    // Recovered order of a previous run: its engine/symbol IDs were that process's
+    if (!update.symbol.empty()) {
+        uint32_t id = SymbolRegistry::get_instance().find(update.symbol);
+        if (id != SymbolRegistry::INVALID_ID && engine_by_symbol_[id] != NO_ENGINE) {
+            deliver(*slots_[engine_by_symbol_[id]]);
+        }
+        return;
+    }
+
+    for (auto& slot : slots_) deliver(*slot);
+}
+
+// ============================================================================
+// WORKERS
+// ============================================================================
+
+int64_t EngineScheduler::now_ns() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+// Runs every ready engine of this worker (steal = false) or of the others (steal = true).
+bool EngineScheduler::run_ready(size_t worker, bool steal) {
+    bool ran = false;
+    for (auto& slot_ptr : slots_) {
+        EngineSlot& slot = *slot_ptr;
+        if ((slot.home == worker) == steal) continue;
+
+        int64_t now = now_ns();
+        bool event = slot.engine->has_pending_event();
+        bool tick = now - slot.last_run_ns.load(std::memory_order_relaxed) >= tick_ns_;
+        if (!event && !tick) continue;
+        if (steal && !stealable(slot, now)) continue;
+
+        // acquire/release on the claim hands the engine's state from worker to worker
+        if (slot.busy.exchange(true, std::memory_order_acquire)) continue;
+        worker_state_[worker].in_cycle.store(true, std::memory_order_release);
+        slot.engine->run_trading_cycle();
+        worker_state_[worker].in_cycle.store(false, std::memory_order_release);
+        slot.last_run_ns.store(now_ns(), std::memory_order_relaxed);
+        slot.ready_seen_ns.store(0, std::memory_order_relaxed);
+        slot.busy.store(false, std::memory_order_release);
+
+        cycles_.fetch_add(1, std::memory_order_relaxed);
+        if (!event) timer_ticks_.fetch_add(1, std::memory_order_relaxed);
+        if (steal) steals_.fetch_add(1, std::memory_order_relaxed);
+        ran = true;
+    }
+    return ran;
+}
+
+// Another worker's ready engine: taken at once while its home is inside another
+// engine's cycle, otherwise only after it has waited steal_after_ns_ (counted from the
+// first time a thief saw it ready), so engines stay on their home core.
+bool EngineScheduler::stealable(EngineSlot& slot, int64_t now) {
+    if (worker_state_[slot.home].in_cycle.load(std::memory_order_acquire)) return true;
+
+    int64_t seen = slot.ready_seen_ns.load(std::memory_order_relaxed);
+    if (seen == 0) {
+        slot.ready_seen_ns.compare_exchange_strong(seen, now, std::memory_order_relaxed);
+        return steal_after_ns_ == 0;
+    }
+    return now - seen >= steal_after_ns_;
+}
+
+int64_t EngineScheduler::next_tick_delay_ns(size_t worker, int64_t now) const {
+    int64_t delay = tick_ns_;
+    for (const auto& slot : slots_) {
+        if (slot->home != worker) continue;
+        int64_t due = slot->last_run_ns.load(std::memory_order_relaxed) + tick_ns_ - now;
+        delay = std::min(delay, std::max<int64_t>(due, 0));
+    }
+    return delay;
+}
+
+void EngineScheduler::worker_loop(size_t worker) {
+    Doorbell& doorbell = orderbook_manager_.change_notifier().doorbell(worker);
+
+    while (running_.load(std::memory_order_acquire)) {
+        uint32_t seen = doorbell.sequence();
+
+        // Own engines first; steal only when there is nothing local to do and another
+        // worker cannot keep up (see stealable())
+        if (run_ready(worker, false)) continue;
+        if (run_ready(worker, true)) continue;
+
+        int64_t delay = next_tick_delay_ns(worker, now_ns());
+        if (delay > 0) {
+            doorbell.wait(seen, config_.engine_wait_mode,
+                          std::chrono::duration_cast<std::chrono::microseconds>(
+                              std::chrono::nanoseconds(delay)));
+        }
+    }
+}
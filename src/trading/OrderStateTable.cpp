@@ -0,0 +1,222 @@
+#include "trading/OrderStateTable.h"
+#include "utils/CpuPause.h"
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <iostream>
+#include <vector>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/file.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+namespace {
+int64_t unix_ns() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::system_clock::now().time_since_epoch()).count();
+}
+
+// Seqlock write (same protocol as OrderBook::begin_write/end_write)
+void write_slot(OrderSlot& slot, const OpenOrder& order) {
+    uint64_t version = slot.version.load(std::memory_order_relaxed);
+    slot.version.store(version + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    slot.order = order;
+    slot.version.store(version + 2, std::memory_order_release);
+}
+
+void raise_limit(OrderTableHeader& header, uint32_t symbol_id) {
+    if (symbol_id + 1 > header.symbol_limit.load(std::memory_order_relaxed)) {
+        header.symbol_limit.store(symbol_id + 1, std::memory_order_release);
+    }
+}
+}
+
+const char* order_slot_state_name(OrderSlotState state) {
+    switch (state) {
+        case OrderSlotState::EMPTY:    return "EMPTY";
+        case OrderSlotState::PENDING:  return "PENDING";
+        case OrderSlotState::WORKING:  return "WORKING";
+        case OrderSlotState::POSITION: return "POSITION";
+        case OrderSlotState::CLOSING:  return "CLOSING";
+    }
+    return "UNKNOWN";
+}
+
+// ============================================================================
+// WRITER
+// ============================================================================
+
+OrderStateTable::OrderStateTable()
+    : local_(std::make_unique<Layout>()),
+      layout_(local_.get()) {}
+
+OrderStateTable::~OrderStateTable() {
+    if (mapped_) munmap(mapped_, sizeof(Layout));     // The records stay for the next run
+    if (fd_ >= 0) ::close(fd_);
+}
+
+bool OrderStateTable::open(const std::string& path) {
+    if (mapped_) return true;
+
+    int fd = ::open(path.c_str(), O_RDWR | O_CREAT, 0644);
+    if (fd < 0) {
+        std::cerr << "❌ Order state: cannot open " << path << "\n";
+        return false;
+    }
+    // One writing process per table: a second bot on the same file would fight over the slots
+    if (flock(fd, LOCK_EX | LOCK_NB) != 0) {
+        std::cerr << "❌ Order state: " << path << " is in use by another process\n";
+        ::close(fd);
+        return false;
+    }
+
+    struct stat st;
+    bool reuse = fstat(fd, &st) == 0 && static_cast<size_t>(st.st_size) == sizeof(Layout);
+    if (!reuse && (ftruncate(fd, 0) != 0 || ftruncate(fd, static_cast<off_t>(sizeof(Layout))) != 0)) {
+        std::cerr << "❌ Order state: cannot size " << path << "\n";
+        ::close(fd);
+        return false;
+    }
+    void* mem = mmap(nullptr, sizeof(Layout), PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    if (mem == MAP_FAILED) {
+        std::cerr << "❌ Order state: mmap failed for " << path << "\n";
+        ::close(fd);
+        return false;
+    }
+
+    Layout* layout = static_cast<Layout*>(mem);
+    OrderTableHeader& h = layout->header;
+    if (reuse && (h.magic != MAGIC || h.version != VERSION || h.max_symbols != MAX_SYMBOLS)) {
+        std::cout << "⚠️  Order state: " << path << " is from another version, starting empty\n";
+        h.magic = 0;
+        std::memset(static_cast<void*>(layout->slots.data()), 0, sizeof(layout->slots));
+        h.symbol_limit.store(0, std::memory_order_relaxed);
+    }
+    if (h.magic == MAGIC) rekey(*layout);
+
+    h.version = VERSION;
+    h.max_symbols = MAX_SYMBOLS;
+    h.pid = static_cast<int32_t>(getpid());
+    h.opened_unix_ns = unix_ns();
+
+    // Magic last: a reader that sees it sees a complete header
+    std::atomic_thread_fence(std::memory_order_release);
+    h.magic = MAGIC;
+
+    mapped_ = mem;
+    layout_ = layout;
+    fd_ = fd;
+    path_ = path;
+    std::cout << "✓ Order state table: " << path << "\n";
+    return true;
+}
+
+// Previous run's records, moved to the slots of this run's symbol IDs. Cold path, before
+// any engine exists; a slot left odd by a writer that died mid-write is discarded.
+void OrderStateTable::rekey(Layout& layout) {
+    struct Record { uint32_t from; uint32_t to; OpenOrder order; };
+    std::vector<Record> records;
+
+    uint32_t limit = std::min(layout.header.symbol_limit.load(std::memory_order_relaxed), MAX_SYMBOLS);
+    for (uint32_t id = 0; id < limit; id++) {
+        OrderSlot& slot = layout.slots[id];
+        uint64_t version = slot.version.load(std::memory_order_relaxed);
+        if (version & 1) {
+            std::cerr << "⚠️  Order state: slot " << id << " was torn by a crash, discarded\n";
+            slot.order = OpenOrder{};
+            slot.version.store(version + 1, std::memory_order_relaxed);
+            continue;
+        }
+        if (slot.order.state == OrderSlotState::EMPTY) continue;
+
+        OpenOrder order = slot.order;
+        order.symbol[sizeof(order.symbol) - 1] = '\0';
+        uint32_t to = SymbolRegistry::get_instance().intern(order.symbol);
+        if (to == SymbolRegistry::INVALID_ID || to >= MAX_SYMBOLS) {
+            std::cerr << "⚠️  Order state: no symbol ID for " << order.symbol << ", record dropped\n";
+            write_slot(slot, OpenOrder{});
+            continue;
+        }
+        records.push_back({id, to, order});
+    }
+
+    // Sources first, so a record moving into a slot another one is leaving is not lost
+    for (const Record& r : records) {
+        if (r.from != r.to) write_slot(layout.slots[r.from], OpenOrder{});
+    }
+    layout.header.symbol_limit.store(0, std::memory_order_relaxed);
+    for (const Record& r : records) {
+        if (r.from != r.to) write_slot(layout.slots[r.to], r.order);
+        raise_limit(layout.header, r.to);
+        std::cout << "  ↳ Open order: " << r.order.symbol << " " << order_slot_state_name(r.order.state)
+                  << " (" << r.order.order_link_id << ")\n";
+    }
+}
+
+void OrderStateTable::store(uint32_t symbol_id, const OpenOrder& order) {
+    if (symbol_id >= MAX_SYMBOLS) return;
+    write_slot(layout_->slots[symbol_id], order);
+    raise_limit(layout_->header, symbol_id);
+}
+
+void OrderStateTable::clear(uint32_t symbol_id) {
+    if (symbol_id >= MAX_SYMBOLS) return;
+    if (layout_->slots[symbol_id].order.state == OrderSlotState::EMPTY) return;    // Own slot: no race
+    write_slot(layout_->slots[symbol_id], OpenOrder{});
+}
+
+bool OrderStateTable::load(uint32_t symbol_id, OpenOrder& out) const {
+    return load(*layout_, symbol_id, out);
+}
+
+// ============================================================================
+// READER
+// ============================================================================
+
+bool OrderStateTable::load(const Layout& layout, uint32_t symbol_id, OpenOrder& out) {
+    if (symbol_id >= MAX_SYMBOLS) return false;
+    const OrderSlot& slot = layout.slots[symbol_id];
+
+    for (int attempt = 0; attempt < READ_ATTEMPTS; attempt++) {
+        uint64_t before = slot.version.load(std::memory_order_acquire);
+        if (before & 1) {           // Writer in progress
+            cpu_pause();
+            continue;
+        }
+        std::memcpy(&out, &slot.order, sizeof(OpenOrder));
+
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (slot.version.load(std::memory_order_relaxed) == before) return out.state != OrderSlotState::EMPTY;
+        cpu_pause();
+    }
+    return false;
+}
+
+const OrderStateTable::Layout* OrderStateTable::map_readonly(const std::string& path) {
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) return nullptr;
+
+    struct stat st;
+    if (fstat(fd, &st) != 0 || static_cast<size_t>(st.st_size) < sizeof(Layout)) {
+        ::close(fd);
+        return nullptr;
+    }
+    void* mem = mmap(nullptr, sizeof(Layout), PROT_READ, MAP_SHARED, fd, 0);
+    ::close(fd);
+    if (mem == MAP_FAILED) return nullptr;
+
+    const Layout* layout = static_cast<const Layout*>(mem);
+    if (layout->header.magic != MAGIC || layout->header.version != VERSION ||
+        layout->header.max_symbols != MAX_SYMBOLS) {
+        munmap(mem, sizeof(Layout));
+        return nullptr;
+    }
+    std::atomic_thread_fence(std::memory_order_acquire);
+    return layout;
+}
+
+void OrderStateTable::unmap(const Layout* layout) {
+    if (layout) munmap(const_cast<Layout*>(layout), sizeof(Layout));
+}
@@ -0,0 +1,118 @@
+#include "trading/RiskGate.h"
+#include "utils/Tsc.h"
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+
+const char* risk_verdict_name(RiskVerdict verdict) {
+    switch (verdict) {
+        case RiskVerdict::PASS:             return "PASS";
+        case RiskVerdict::MARTINGALE_LIMIT: return "MARTINGALE_LIMIT";
+        case RiskVerdict::ORDER_NOTIONAL:   return "ORDER_NOTIONAL";
+        case RiskVerdict::POSITION_LIMIT:   return "POSITION_LIMIT";
+        case RiskVerdict::SYMBOL_RATE:      return "SYMBOL_RATE";
+        case RiskVerdict::GLOBAL_RATE:      return "GLOBAL_RATE";
+        case RiskVerdict::COUNT:            break;
+    }
+    return "UNKNOWN";
+}
+
+// ============================================================================
+// CONFIGURATION (cold path)
+// ============================================================================
+
+void RiskGate::configure(const RiskLimits& limits) {
+    limits_ = limits;
+    global_rate_ = make_rate(limits.global_orders_per_second, limits.global_burst, limits.reduce_reserve);
+    symbol_rate_ = make_rate(limits.symbol_orders_per_second, limits.symbol_burst, limits.reduce_reserve);
+
+    std::cout << "✓ Risk gate: " << limits.global_orders_per_second << " orders/s global, "
+              << limits.symbol_orders_per_second << "/s per symbol (" << limits.reduce_reserve
+              << " reserved for reducing orders)";
+    if (limits.max_order_notional > 0.0) std::cout << ", max order $" << limits.max_order_notional;
+    if (limits.max_position_notional > 0.0) std::cout << ", max position $" << limits.max_position_notional;
+    if (limits.max_martingale_steps >= 0) std::cout << ", martingale <= " << limits.max_martingale_steps << " steps";
+    std::cout << "\n";
+}
+
+RiskGate::Rate RiskGate::make_rate(int per_second, int burst, int reserve) {
+    Rate rate;
+    if (per_second <= 0) return rate;
+    double ticks_per_second = 1e9 / tsc::calibration().ns_per_tick;
+    rate.interval = std::max<uint64_t>(static_cast<uint64_t>(ticks_per_second / per_second), 1);
+    int slack = std::max(burst, 1) - 1;
+    rate.tolerance = rate.interval * static_cast<uint64_t>(slack);
+    rate.open_tolerance = rate.interval * static_cast<uint64_t>(std::max(slack - std::max(reserve, 0), 0));
+    return rate;
+}
+
+// ============================================================================
+// CHECK (send path)
+// ============================================================================
+
+RiskVerdict RiskGate::check(uint32_t symbol_id, const InstrumentSpec& instrument, OrderIntent intent,
+                            bool is_buy, int64_t qty_lots, int64_t price_ticks, int64_t position_lots,
+                            int martingale_step) {
+    // 1. Exposure: only orders that can grow the position
+    if (intent == OrderIntent::OPEN) {
+        if (limits_.max_martingale_steps >= 0 && martingale_step > limits_.max_martingale_steps) {
+            return reject(RiskVerdict::MARTINGALE_LIMIT);
+        }
+
+        double price = instrument.ticks_to_price(price_ticks);
+        if (limits_.max_order_notional > 0.0 &&
+            instrument.lots_to_qty(qty_lots) * price > limits_.max_order_notional) {
+            return reject(RiskVerdict::ORDER_NOTIONAL);
+        }
+
+        int64_t projected = position_lots + (is_buy ? qty_lots : -qty_lots);
+        if (limits_.max_position_notional > 0.0 &&
+            instrument.lots_to_qty(projected < 0 ? -projected : projected) * price > limits_.max_position_notional) {
+            return reject(RiskVerdict::POSITION_LIMIT);
+        }
+    }
+
+    // 2. Rates: every request counts against the exchange's limits
+    if (symbol_rate_.interval || global_rate_.interval) {
+        uint64_t now = tsc::now();
+        bool open = intent == OrderIntent::OPEN;
+        Bucket* symbol = symbol_id < MAX_SYMBOLS ? &symbols_[symbol_id] : nullptr;
+        if (symbol_rate_.interval && symbol &&
+            !take(*symbol, symbol_rate_, open ? symbol_rate_.open_tolerance : symbol_rate_.tolerance, now)) {
+            return reject(RiskVerdict::SYMBOL_RATE);
+        }
+        if (global_rate_.interval &&
+            !take(global_, global_rate_, open ? global_rate_.open_tolerance : global_rate_.tolerance, now)) {
+            if (symbol_rate_.interval && symbol) give_back(*symbol, symbol_rate_);
+            return reject(RiskVerdict::GLOBAL_RATE);
+        }
+    }
+
+    passed_.fetch_add(1, std::memory_order_relaxed);
+    return RiskVerdict::PASS;
+}
+
+// GCRA: admitted while the TAT runs at most `tolerance` ahead of now
+bool RiskGate::take(Bucket& bucket, const Rate& rate, uint64_t tolerance, uint64_t now) {
+    uint64_t tat = bucket.tat.load(std::memory_order_relaxed);
+    for (;;) {
+        uint64_t start = std::max(tat, now);
+        if (start - now > tolerance) return false;
+        if (bucket.tat.compare_exchange_weak(tat, start + rate.interval, std::memory_order_relaxed)) return true;
+    }
+}
+
+void RiskGate::give_back(Bucket& bucket, const Rate& rate) {
+    bucket.tat.fetch_sub(rate.interval, std::memory_order_relaxed);
+}
+
+RiskVerdict RiskGate::reject(RiskVerdict verdict) {
+    rejected_[static_cast<size_t>(verdict)].fetch_add(1, std::memory_order_relaxed);
+    return verdict;
+}
+
+uint64_t RiskGate::get_rejected_total() const {
+    uint64_t total = 0;
+    for (const auto& count : rejected_) total += count.load(std::memory_order_relaxed);
+    return total;
+}
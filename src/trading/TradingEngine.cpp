@@ -13,6 +13,8 @@
  */
 
 #include "trading/TradingEngine.h"
+#include "utils/LatencyRecorder.h"
+#include <algorithm>
 #include <iostream>
 #include <cmath>
 #include <thread>
@@ -28,13 +30,21 @@ TradingEngine::TradingEngine(
     SymbolManager& sm,
     DataLogger& logger,
     BybitWebSocketClient* trade_client,
-    std::shared_ptr<AeronPublisher> aeron_pub
+    std::shared_ptr<AeronPublisher> aeron_pub,
+    uint16_t engine_id,
+    const SignalParams& signal_params,
+    bool entry_at_microprice
 ) : symbol_(symbol),
+    symbol_id_(SymbolRegistry::get_instance().intern(symbol)),
+    instrument_(InstrumentRegistry::get_instance().get(symbol_id_)),
     orderbook_manager_(obm),
     symbol_manager_(sm),
     logger_(logger),
     trade_client_(trade_client),
-    aeron_publisher_(aeron_pub)
+    aeron_publisher_(aeron_pub),
+    engine_id_(engine_id),
+    order_sequence_(ClientOrderId::session_start()),
+    entry_at_microprice_(entry_at_microprice)
 {
     // Print Strategy Banner
     std::cout << "\n╔════════════════════════════════════════════════════╗\n";
@@ -46,13 +56,28 @@ TradingEngine::TradingEngine(
     std::cout << "Stop Loss:        -0.10% (-0.001)\n\n";
 
     // --- 1. Initialize Risk Parameters ---
-    base_quantity_ = 0.01;          // Starting trade size (e.g., 0.001 BTC)
+    // Starting trade size (e.g., 0.001 BTC), in whole lots and never below the exchange minimum
+    base_quantity_ = std::max(instrument_.qty_to_lots(0.01), instrument_.min_qty_lots);
     current_qty_ = base_quantity_;   // Current trade size (will double on loss)
     martingale_step_ = 0;            // Tracks consecutive losses
-    max_martingale_steps_ = 100000;       // Stop doubling after 6 losses to prevent blow-up
     profit_target_percent_ = 0.001; // 0.05% gain target
     stop_loss_percent_ = -0.0005;     // -0.05% loss limit
     cumulative_loss_ = 0.0;          // Total dollars lost in current sequence
+
+    // Book features, kept up to date by the feed thread; VWAPs priced for our order size
+    SignalParams book_signals = signal_params;
+    book_signals.vwap_target_lots = base_quantity_;
+    if (OrderBook* ob = orderbook_manager_.get_or_create(symbol_id_)) ob->enable_signals(book_signals);
+
+    // Price offsets in ticks (at least one tick, so they still mean something on coarse grids)
+    entry_offset_ticks_ = std::max<int64_t>(instrument_.price_to_ticks(0.1), 1);
+    chase_threshold_ticks_ = std::max<int64_t>(instrument_.price_to_ticks(0.05), 1);
+    exit_slippage_ticks_ = std::max<int64_t>(instrument_.price_to_ticks(100.0), 1);
+    if (!instrument_.known) {
+        std::cerr << "⚠️  [" << symbol << "] No instrument metadata: orders are not snapped to the exchange tick\n";
+    }
+    LatencyRecorder::get_instance().prepare_symbol(symbol_id_);   // Per-symbol stage histograms
+    telemetry_ = &telemetry::TelemetrySegment::get_instance().symbol(symbol_id_);
     
     // --- 2. Initialize State Variables ---
     is_short_ = false;               // Direction flag (false=Long/Buy, true=Short/Sell)
@@ -60,53 +85,87 @@ TradingEngine::TradingEngine(
     waiting_for_close_ = false;      // Are we currently trying to exit?
     last_orderbook_update_ = 0;      // Tracks staleness of market data
 
-    // --- 3. Initial Market Data Wait Loop ---
-    // The bot cannot trade without knowing the price. We wait up to 10 seconds.
-    std::cout << "⏳ Waiting for initial market data...\n";
-    int wait_count = 0;
-    while (wait_count < 100) {  // 100 * 100ms = 10 seconds
-        auto ob = orderbook_manager_.get(symbol_);
-        
-        // Check if OrderBook exists and has received at least one update
-        if (ob && ob->get_update_count() > 0) {
-            double bid, ask, dummy;
-            // Check if we can read valid best Bid/Ask prices
-            if (ob->get_best_bid(bid, dummy) && ob->get_best_ask(ask, dummy)) {
-                if (bid < ask) {  // Ensure spread is valid (Bid must be lower than Ask)
-                    std::cout << "✅ Market data ready: Bid=" << bid 
-                              << " Ask=" << ask 
-                              << " Spread=$" << (ask - bid) << "\n";
-                    last_orderbook_update_ = ob->get_update_count();
-                    break; // Exit loop, we are ready!
-                }
-            }
-        }
-        std::this_thread::sleep_for(std::chrono::milliseconds(100)); // Sleep to save CPU
-        wait_count++;
-    }
-    
-    if (wait_count >= 100) {
-        std::cerr << "⚠️ WARNING: Started without valid market data. Bot may pause.\n";
-    }
-
     // --- 4. State Recovery ---
-    // If the bot crashed, check Aeron buffer for active orders to resume management.
+    // If the bot crashed, its order state table slot has the orders to resume managing.
     reconcile_state_on_startup();
 
-    // --- 5. Register Callback ---
-    // Tell the WebSocket client to call OUR function (on_order_update) when an order changes status.
-    if (trade_client_) {
-        trade_client_->set_order_update_callback(
-            [this](const std::string& id, const std::string& status, const std::string& sym) {
-                // Only process updates for OUR active order ID or symbol
-                if (sym == symbol_ || (sym.empty() && id == active_order_id_)) {
-                    this->on_order_update(id, status);
+    // --- 5. Order updates ---
+    // Whoever owns the private channels (EngineScheduler) routes execution reports
+    // into enqueue_order_update() and rings our doorbell; they are applied on the
+    // engine thread.
+
+    // --- 6. Event-driven wakeup: feed threads ring us when this book changes ---
+    orderbook_manager_.change_notifier().watch(symbol_id_);
+}
+
+// ============================================================================
+// STARTUP: MARKET DATA READINESS
+// ============================================================================
+/**
+ * @brief Non-blocking check that the book has a valid, uncrossed top of book.
+ * The bot cannot trade without knowing the price; the scheduler polls this for all
+ * engines with one shared deadline before starting the workers.
+ */
+bool TradingEngine::market_data_ready() {
+    auto ob = orderbook_manager_.get(symbol_id_);
+
+    // Check if OrderBook exists and has received at least one update
+    if (!ob || ob->get_update_count() == 0) return false;
+
+    TopOfBook top;
+    // Check if we can read valid best Bid/Ask prices
+    if (!ob->get_top_of_book(top)) return false;
+    int64_t bid = top.bid_price, ask = top.ask_price;
+    if (bid >= ask) return false;  // Ensure spread is valid (Bid must be lower than Ask)
+
+    std::cout << "✅ [" << symbol_ << "] Market data ready: Bid=" << instrument_.ticks_to_price(bid)
+              << " Ask=" << instrument_.ticks_to_price(ask)
+              << " Spread=" << (ask - bid) << " ticks\n";
+    last_orderbook_update_ = ob->get_update_count();
+    return true;
+}
+
+// ============================================================================
+// EVENT INBOX (any thread -> engine thread)
+// ============================================================================
+
+// Producers copy a POD event into the MPSC ring. Execution reports must never be lost,
+// so a full ring makes the producer wait for the engine instead of dropping.
+void TradingEngine::push_event(const EngineEvent& event) {
+    while (!inbox_.try_push(event)) {
+        inbox_full_waits_.fetch_add(1, std::memory_order_relaxed);
+        cpu_pause();
+    }
+}
+
+void TradingEngine::enqueue_order_update(const OrderUpdate& update) {
+    push_event(EngineEvent::order_update(update));
+}
+
+// Engine thread: applies every queued event in arrival order. This is the only place
+// (besides the cycle itself) that touches the order state, so no field needs a lock.
+void TradingEngine::drain_inbox() {
+    EngineEvent event;
+    while (inbox_.try_pop(event)) {
+        switch (event.type) {
+            case EngineEventType::ORDER_UPDATE: {
+                // Only process updates for our live order IDs (an integer compare)
+                const ClientOrderId& id = event.order_id;
+                bool ours = !id.empty() && (id == active_order_id_ || id == active_exit_order_id_);
+                if (ours) {
+                    if (order_sent_tick_ != 0) record_round_trip(event.rx_tick);
+                    on_order_update(event);
                 }
+                break;
             }
-        );
+        }
     }
 }
 
+bool TradingEngine::has_pending_event() const {
+    return !inbox_.empty() || orderbook_manager_.change_notifier().is_dirty(symbol_id_);
+}
+
 // ============================================================================
 // MAIN LOOP: THE HEARTBEAT
 // ============================================================================
@@ -115,12 +174,17 @@ TradingEngine::TradingEngine(
  * This function is called repeatedly by the main program loop.
  */
 void TradingEngine::run_trading_cycle() {
-    
+
+    // 0. Apply queued execution reports/commands, then take the book-changed flag
+    drain_inbox();
+    orderbook_manager_.change_notifier().consume(symbol_id_);
+    publish_telemetry();
+
     // 1. Safety Check: Ensure Market Data is Fresh
     if (!validate_market_data()) return;
 
     // 2. Status Logging: Print state every 5 seconds so user knows bot is alive
-    auto now = std::chrono::steady_clock::now();
+    auto now = engine_clock::now();
     if (std::chrono::duration_cast<std::chrono::seconds>(now - last_status_log_).count() >= 5) {
         log_status();
         last_status_log_ = now;
@@ -128,7 +192,7 @@ void TradingEngine::run_trading_cycle() {
 
     // 3. State Machine Switch
     // The bot performs different actions depending on its current state.
-    switch (current_state_.load()) {
+    switch (current_state_) {
         
         case BotState::IDLE:
             // Waiting for a signal. If not closing a previous trade, look for entry.
@@ -168,11 +232,21 @@ void TradingEngine::run_trading_cycle() {
  */
 bool TradingEngine::validate_market_data() {
     if (symbol_.empty()) return false;
-    if (!symbol_manager_.is_subscribed(symbol_)) return false;
+    if (!symbol_manager_.is_subscribed(symbol_id_)) return false;
 
-    auto ob = orderbook_manager_.get(symbol_);
+    auto ob = orderbook_manager_.get(symbol_id_);
     if (!ob) return false;
 
+    // 0. Book is mid-resync (sequence gap) - never trade on it
+    if (!ob->is_valid()) {
+        auto now = engine_clock::now();
+        if (std::chrono::duration_cast<std::chrono::seconds>(now - last_resync_log_).count() > 5) {
+            std::cout << "⚠ [" << symbol_ << "] Orderbook resyncing (sequence gap) - Pausing...\n";
+            last_resync_log_ = now;
+        }
+        return false;
+    }
+
     // 1. Check Update Count
     uint64_t current_update = ob->get_update_count();
     
@@ -183,18 +257,18 @@ bool TradingEngine::validate_market_data() {
     }
     last_orderbook_update_ = current_update;
 
-    // 2. Fetch Prices (Thread-Safe Access)
-    double bid, ask, bid_qty, ask_qty;
-    bool has_bid = ob->get_best_bid(bid, bid_qty);
-    bool has_ask = ob->get_best_ask(ask, ask_qty);
+    // 2. Fetch Prices (one seqlock-consistent view of both sides)
+    TopOfBook top;
+    bool has_top = ob->get_top_of_book(top);
+    int64_t bid = top.bid_price, ask = top.ask_price;
+    int64_t bid_qty = top.bid_qty, ask_qty = top.ask_qty;
 
     // 3. Check for Empty Book
-    if (!has_bid || !has_ask) {
-        static auto last_log = std::chrono::steady_clock::now();
-        auto now = std::chrono::steady_clock::now();
-        if (std::chrono::duration_cast<std::chrono::seconds>(now - last_log).count() > 5) {
-            std::cout << "⚠ Orderbook Empty (Waiting for liquidity)...\n";
-            last_log = now;
+    if (!has_top) {
+        auto now = engine_clock::now();
+        if (std::chrono::duration_cast<std::chrono::seconds>(now - last_empty_log_).count() > 5) {
+            std::cout << "⚠ [" << symbol_ << "] Orderbook Empty (Waiting for liquidity)...\n";
+            last_empty_log_ = now;
         }
         return false;
     }
@@ -204,11 +278,10 @@ bool TradingEngine::validate_market_data() {
 
     // 5. Check for Crossed Market (Bid >= Ask) - Data Error
     if (bid > ask ) {  
-        static auto last_log = std::chrono::steady_clock::now();
-        auto now = std::chrono::steady_clock::now();
-        if (std::chrono::duration_cast<std::chrono::seconds>(now - last_log).count() > 5) {
-            std::cout << "⚠ Crossed/Tight Market (Data Invalid) - Pausing...\n";
-            last_log = now;
+        auto now = engine_clock::now();
+        if (std::chrono::duration_cast<std::chrono::seconds>(now - last_crossed_log_).count() > 5) {
+            std::cout << "⚠ [" << symbol_ << "] Crossed/Tight Market (Data Invalid) - Pausing...\n";
+            last_crossed_log_ = now;
         }
         return false;
     }
@@ -225,30 +298,32 @@ bool TradingEngine::validate_market_data() {
 // In src/trading/TradingEngine.cpp
 
 void TradingEngine::evaluate_entry_signal() {
-    auto ob = orderbook_manager_.get(symbol_);
-    double best_bid, best_ask, dummy;
-    if (!ob->get_best_bid(best_bid, dummy) || !ob->get_best_ask(best_ask, dummy)) return;
+    auto ob = orderbook_manager_.get(symbol_id_);
+    TopOfBook top;  // One consistent view of both sides
+    if (!ob->get_top_of_book(top)) return;
+    int64_t best_bid = top.bid_price, best_ask = top.ask_price;
 
-    double price = 0.0;
+    int64_t price = 0;
     
     // STRATEGY: Mid-Market (Faster Fills for Maker)
-    // We calculate the middle of the spread.
-    double mid_price = (best_bid + best_ask) / 2.0;
+    // We calculate the middle of the spread (in ticks, so every price is on the grid).
+    // With entry_at_microprice the anchor is the microprice, when the book's features
+    // are available.
+    int64_t mid_price = (best_bid + best_ask) / 2;
+    if (ob->get_signals(signals_) && entry_at_microprice_) mid_price = std::llround(signals_.microprice);
 
     if (!is_short_) {
         // Buying: Offer slightly above middle
-        price = mid_price - 0.1; 
-        if (price >= best_ask) price = best_ask - 0.005; // Safety cap
+        price = mid_price - entry_offset_ticks_; 
+        if (price >= best_ask) price = best_ask - 1; // Safety cap: one tick inside
     } else {
         // Selling: Offer slightly below middle
-        price = mid_price + 0.1;
-        if (price <= best_bid) price = best_bid + 0.005; // Safety cap
+        price = mid_price + entry_offset_ticks_;
+        if (price <= best_bid) price = best_bid + 1; // Safety cap: one tick inside
     }
     
-    std::cout << "🤝 MID-MARKET ENTRY: Placing order at " << price << "\n";
-    
     // Still using Maker (PostOnly) to save fees
-    place_order(price, is_short_, true); 
+    place_order(price, is_short_, true);
 }
 
 // ============================================================================
@@ -259,16 +334,16 @@ void TradingEngine::evaluate_entry_signal() {
  * Only runs if state is WORKING.
  */
 void TradingEngine::monitor_working_order() {
-    auto now = std::chrono::steady_clock::now();
+    auto now = engine_clock::now();
     auto elapsed_ms = std::chrono::duration_cast<std::chrono::milliseconds>(now - state_entry_time_).count();
 
     // 1. TIME LIMIT CHECK (The Fix)
     // If the order is older than 3000ms (3 seconds) and hasn't filled, CANCEL IT.
     // This forces the bot to "wake up" and re-evaluate the price.
     if (elapsed_ms > 10000) {
-        std::cout << "⏰ Order stale (" << elapsed_ms << "ms). Cancelling to refresh...\n";
-        if (trade_client_) {
-            trade_client_->cancel_order(symbol_, active_order_id_);
+        if (trade_client_ && risk_check(OrderIntent::CANCEL, false, 0, 0) == RiskVerdict::PASS &&
+            trade_client_->cancel_order(symbol_, active_order_id_.encode().view())) {
+            std::cout << "⏰ Order stale (" << elapsed_ms << "ms). Cancelling to refresh...\n";
             current_state_ = BotState::CANCELLING;
             state_entry_time_ = now;
         }
@@ -279,31 +354,32 @@ void TradingEngine::monitor_working_order() {
     // Only run this if the order is "young" (less than 3 seconds)
     if (elapsed_ms < 500) return; // Wait 0.5s before checking price
 
-    auto ob = orderbook_manager_.get(symbol_);
-    double best_bid, best_ask, dummy;
-    if (!ob->get_best_bid(best_bid, dummy) || !ob->get_best_ask(best_ask, dummy)) return;
+    auto ob = orderbook_manager_.get(symbol_id_);
+    TopOfBook top;  // One consistent view of both sides
+    if (!ob->get_top_of_book(top)) return;
+    int64_t best_bid = top.bid_price, best_ask = top.ask_price;
 
     bool chase_needed = false;
 
     if (!is_short_) { 
         // Buying: If Best Bid moves ABOVE us, we are losing.
         // Make this sensitive: If we are beaten by even $0.05, chase.
-        if (best_bid > active_order_price_ + 0.05) { 
-            std::cout << "📉 Lost Top Spot! (Bid: " << best_bid << "). Chasing...\n";
+        if (best_bid > active_order_price_ + chase_threshold_ticks_) { 
+            std::cout << "📉 Lost Top Spot! (Bid: " << instrument_.ticks_to_price(best_bid) << "). Chasing...\n";
             chase_needed = true;
         }
     } 
     else { 
         // Selling: If Best Ask moves BELOW us, we are losing.
-        if (best_ask < active_order_price_ - 0.05) {
-            std::cout << "📈 Lost Top Spot! (Ask: " << best_ask << "). Chasing...\n";
+        if (best_ask < active_order_price_ - chase_threshold_ticks_) {
+            std::cout << "📈 Lost Top Spot! (Ask: " << instrument_.ticks_to_price(best_ask) << "). Chasing...\n";
             chase_needed = true;
         }
     }
 
     if (chase_needed) {
-        if (trade_client_) {
-            trade_client_->cancel_order(symbol_, active_order_id_);
+        if (trade_client_ && risk_check(OrderIntent::CANCEL, false, 0, 0) == RiskVerdict::PASS &&
+            trade_client_->cancel_order(symbol_, active_order_id_.encode().view())) {
             current_state_ = BotState::CANCELLING; 
             state_entry_time_ = now;
         }
@@ -319,36 +395,42 @@ void TradingEngine::monitor_working_order() {
 void TradingEngine::manage_open_position() {
     if (!position_filled_) return;
 
-    auto now = std::chrono::steady_clock::now();
+    auto now = engine_clock::now();
     auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(now - state_entry_time_).count();
     if (elapsed < 500) return; // Wait 1 second for market to settle
     // 1. Get Market Data
-    auto ob = orderbook_manager_.get(symbol_);
-    double best_bid, best_ask, dummy;
-    if (!ob->get_best_bid(best_bid, dummy) || !ob->get_best_ask(best_ask, dummy)) return;
+    auto ob = orderbook_manager_.get(symbol_id_);
+    TopOfBook top;  // One consistent view of both sides
+    if (!ob->get_top_of_book(top)) return;
+    int64_t best_bid = top.bid_price, best_ask = top.ask_price;
 
-    double current_market_price = is_short_ ? best_ask : best_bid;  
+    int64_t current_market_price = is_short_ ? best_ask : best_bid;  
+    if (entry_price_ <= 0) return;
     
-    // 2. Calculate PnL
+    // 2. Calculate PnL (a ratio of tick counts: the tick size cancels out)
     double pnl_percent = 0.0;
     if (is_short_) {
-        pnl_percent = (entry_price_ - current_market_price) / entry_price_;
+        pnl_percent = static_cast<double>(entry_price_ - current_market_price) / static_cast<double>(entry_price_);
     } else {
-        pnl_percent = (current_market_price - entry_price_) / entry_price_;
+        pnl_percent = static_cast<double>(current_market_price - entry_price_) / static_cast<double>(entry_price_);
     }
 
     last_pnl_percent_ = pnl_percent;
-    last_pnl_dollars_ = pnl_percent * entry_price_ * current_qty_;
+    last_pnl_dollars_ = pnl_percent * instrument_.ticks_to_price(entry_price_) * instrument_.lots_to_qty(position_lots_);
 
     // 3. CHECK STOP LOSS
     if (pnl_percent <= stop_loss_percent_) {
-        std::cout << "\n🛑 STOP LOSS HIT: " << (pnl_percent * 100) << "% (Price: " << current_market_price << ")\n";
+        std::cout << "\n🛑 STOP LOSS HIT: " << (pnl_percent * 100) << "% (Price: "
+                  << instrument_.ticks_to_price(current_market_price) << ")\n";
 
         // A. Cancel the resting Profit Order first (Unlock the coins)
         if (trade_client_ && !active_exit_order_id_.empty()) {
-            std::cout << "  ⚡ Cancelling Profit Order (" << active_exit_order_id_ << ") to execute Stop Loss...\n";
-            trade_client_->cancel_order(symbol_, active_exit_order_id_);
-            active_exit_order_id_ = ""; 
+            // Never close while the exit still rests: both are retried next cycle
+            if (risk_check(OrderIntent::CANCEL, false, 0, 0) != RiskVerdict::PASS) return;
+            ClientOrderId::Text exit_id = active_exit_order_id_.encode();
+            if (!trade_client_->cancel_order(symbol_, exit_id.view())) return;
+            std::cout << "  ⚡ Cancelling Profit Order (" << exit_id.chars << ") to execute Stop Loss...\n";
+            active_exit_order_id_ = {};
         }
 
         
@@ -358,9 +440,17 @@ void TradingEngine::manage_open_position() {
         trigger_martingale_on_close_ = true; 
              
         close_position(); // Send Market Exit
+        return;
+    }
+
+    // 4. Take profit refused by the risk gate, or lost in a restart: post it again once
+    //    its backoff expired. One the exchange cancelled stays down (stop loss still applies).
+    if (exit_repost_pending_ && active_exit_order_id_.empty() && !trigger_martingale_on_close_ &&
+        now >= next_exit_retry_) {
+        post_exit_order();
     }
 }
-/*void TradingEngine::execute_average_down(double current_market_price) {
+/*void TradingEngine::execute_average_down(int64_t current_market_price) {
     if (!trade_client_) return;
 
     // 1. Calculate how much to add (Doubling: Add equal to current holdings)
@@ -369,13 +459,13 @@ void TradingEngine::manage_open_position() {
     double quantity_to_add = current_qty_; 
 
     // 2. Prepare Order
-    active_order_id_ = generate_id();
+    active_order_id_ = next_order_id();
     std::string side = is_short_ ? "Sell" : "Buy"; // SAME DIRECTION
     
     // 3. Set Flags
     is_averaging_ = true;             // Tell system we are adding, not entering new
     current_state_ = BotState::PLACING_ORDER;
-    state_entry_time_ = std::chrono::steady_clock::now();
+    state_entry_time_ = engine_clock::now();
     active_order_price_ = current_market_price; // Track for chase logic if needed
 
     std::cout << "➕ AVERAGING: Adding " << quantity_to_add << " " << side 
@@ -432,11 +522,11 @@ void TradingEngine::close_position_and_reset() {
 void TradingEngine::apply_martingale_recovery() {
     // This function runs AFTER a loss is closed
     martingale_step_++;
-    current_qty_ *= 2.0;       // Double the size
+    current_qty_ *= 2;         // Double the size
     is_short_ = !is_short_;    // Reverse Strategy (If Long failed, go Short)
     
     std::cout << "⚡ MARTINGALE STEP " << martingale_step_ 
-              << " | New Qty: " << current_qty_ 
+              << " | New Qty: " << instrument_.lots_to_qty(current_qty_) 
               << " | Reversing to " << (is_short_ ? "SHORT" : "LONG") << "...\n";
               
     current_state_ = BotState::IDLE; // Ready to enter immediately
@@ -446,65 +536,115 @@ void TradingEngine::apply_martingale_recovery() {
  * @brief Sends the Market Order to exit the position.
  */
 void TradingEngine::close_position() {
-    if (!trade_client_) return;
+    if (!trade_client_ || !trade_client_->is_connected()) return;   // Retried next cycle
     
     std::string side = is_short_ ? "Buy" : "Sell"; // To close Short, we Buy.
-    auto ob = orderbook_manager_.get(symbol_);
-    double best_bid, best_ask, dummy;
-    if (!ob->get_best_bid(best_bid, dummy) || !ob->get_best_ask(best_ask, dummy)) {
+    auto ob = orderbook_manager_.get(symbol_id_);
+    TopOfBook top;
+    if (!ob->get_top_of_book(top)) {
         std::cerr << "❌ Cannot close - no market data\n";
         return;
     }
     
-    // Aggressive Exit Price calculation
-    double price = is_short_ ? best_ask + 100.0 : best_bid - 100.0;
+    // Aggressive Exit Price calculation (a limit far through the touch)
+    int64_t price = is_short_ ? top.ask_price + exit_slippage_ticks_
+                              : std::max<int64_t>(top.bid_price - exit_slippage_ticks_, 1);
 
-    active_order_id_ = generate_id();
+    // Refused: still IN_POSITION, so the next cycle tries again
+    if (risk_check(OrderIntent::REDUCE, is_short_, position_lots_, price) != RiskVerdict::PASS) return;
+
+    DecisionStamp decision = stamp_decision();
+    active_order_id_ = next_order_id();
     waiting_for_close_ = true; // Flag tells OnOrderUpdate this is an EXIT
     
     // Lock state so we don't double-close
     current_state_ = BotState::PLACING_ORDER;
-    state_entry_time_ = std::chrono::steady_clock::now();
-
-    std::cout << "📤 CLOSING Position (" << side << " @ " << price 
-              << ") Entry was: " << entry_price_ << "\n";
-              
-    trade_client_->place_order(symbol_, side, current_qty_, price, active_order_id_,false);
-    
-    // Clean up Aeron buffer
-    if (aeron_publisher_) aeron_publisher_->remove_order_from_buffer(symbol_);
+    state_entry_time_ = engine_clock::now();
+    persist_order_state(OrderSlotState::CLOSING);
+
+    uint64_t sent_tick = trade_client_->place_order(symbol_, side, position_lots_, price,
+                                                    active_order_id_.encode().view(), false);
+    if (!sent_tick) {
+        // Never queued: still IN_POSITION, the next cycle closes again
+        waiting_for_close_ = false;
+        current_state_ = BotState::IN_POSITION;
+        persist_order_state(OrderSlotState::POSITION);
+        return;
+    }
+    record_send_latency(decision, sent_tick);
 }
 
 // ============================================================================
 // EXECUTION: SENDING ORDERS
 // ============================================================================
-void TradingEngine::place_order(double price, bool is_short,bool is_maker) {
-    if (!trade_client_) return;
+bool TradingEngine::place_order(int64_t price, bool is_short,bool is_maker) {
+    if (!trade_client_ || !trade_client_->is_connected()) return false;
+
+    // The step cap (risk_limits.max_martingale_steps) lives in the gate only
+    RiskVerdict verdict = risk_check(OrderIntent::OPEN, !is_short, current_qty_, price);
+    bool exposure = verdict == RiskVerdict::ORDER_NOTIONAL || verdict == RiskVerdict::POSITION_LIMIT;
+    if (verdict == RiskVerdict::MARTINGALE_LIMIT || (exposure && current_qty_ > base_quantity_)) {
+        // The gate caps the doubling (steps or size): give up on this sequence, so the
+        // next entry is at base size instead of the same refused order again
+        std::cout << "⚠️ [" << symbol_ << "] Martingale size refused (" << risk_verdict_name(verdict)
+                  << "). Hard Resetting Risk.\n";
+        martingale_step_ = 0;
+        current_qty_ = base_quantity_;
+        cumulative_loss_ = 0.0;
+        return false;
+    }
+    if (verdict != RiskVerdict::PASS) return false;
+
+    DecisionStamp decision = stamp_decision();
 
-    active_order_id_ = generate_id();
+    active_order_id_ = next_order_id();
+    ClientOrderId::Text order_id = active_order_id_.encode();
     active_order_price_ = price; 
     std::string side = is_short ? "Sell" : "Buy";
 
     // Update State Variables
     current_state_ = BotState::PLACING_ORDER; // Critical: Prevents duplicate orders
-    state_entry_time_ = std::chrono::steady_clock::now();
+    state_entry_time_ = engine_clock::now();
     entry_price_ = price;
     is_short_ = is_short;
     position_filled_ = false;
+    persist_order_state(OrderSlotState::PENDING);   // Before the send: a crash right after it still finds the order
 
-    std::cout << "📤 Sending " << side << " @ " << price << " (ID: " << active_order_id_ << ")\n";
-    trade_client_->place_order(symbol_, side, current_qty_, price, active_order_id_,is_maker);
+    uint64_t sent_tick = trade_client_->place_order(symbol_, side, current_qty_, price, order_id.view(), is_maker);
+    if (!sent_tick) {
+        // Never queued (the workers share the connection's send queue): nothing to wait for
+        current_state_ = BotState::IDLE;
+        persist_order_state(OrderSlotState::EMPTY);
+        return false;
+    }
+    record_send_latency(decision, sent_tick);
 
     // SBE Logging (High Speed Binary Logging via Aeron)
     if (aeron_publisher_) {
         uint64_t now_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(
             std::chrono::system_clock::now().time_since_epoch()).count();
 
-        sbe_encoder_.encode_order(
-            now_ns, active_order_id_, symbol_, side, price, current_qty_, true
-        );
-        aeron_publisher_->publish(sbe_encoder_.data(), sbe_encoder_.size());
+        size_t length = SBEEncoder::encode_order(
+            sbe_encoder_.scratch(), SBEEncoder::SCRATCH_SIZE, now_ns, symbol_id_, symbol_,
+            instrument_, order_id.view(), !is_short, price, current_qty_, true);
+        if (length) aeron_publisher_->publish(sbe_encoder_.scratch(), length);
     }
+    return true;
+}
+
+// Pre-trade gate (RiskGate) in front of every request; a refusal is logged when the
+// verdict changes, not on every retry
+RiskVerdict TradingEngine::risk_check(OrderIntent intent, bool is_buy, int64_t qty_lots, int64_t price_ticks) {
+    int64_t position = is_short_ ? -position_lots_ : position_lots_;
+    RiskVerdict verdict = RiskGate::get_instance().check(symbol_id_, instrument_, intent, is_buy, qty_lots,
+                                                         price_ticks, position, martingale_step_);
+    if (verdict != RiskVerdict::PASS && verdict != last_risk_verdict_) {
+        std::cerr << "🛡️  [" << symbol_ << "] Risk gate refused " << (is_buy ? "Buy" : "Sell") << " "
+                  << instrument_.lots_to_qty(qty_lots) << " @ " << instrument_.ticks_to_price(price_ticks)
+                  << ": " << risk_verdict_name(verdict) << "\n";
+    }
+    last_risk_verdict_ = verdict;
+    return verdict;
 }
 
 // ============================================================================
@@ -520,175 +660,406 @@ void TradingEngine::place_order(double price, bool is_short,bool is_maker) {
  * @brief Called by BybitWebSocketClient when an order status changes.
  * IMPLEMENTS: Stop-and-Reverse Martingale & Instant Exit Posting
  */
-void TradingEngine::on_order_update(const std::string& order_id, const std::string& status) {
-    // 1. START TIMER (Measure Latency correctly)
-    auto start_time = std::chrono::high_resolution_clock::now();
+void TradingEngine::on_order_update(const EngineEvent& event) {
+    // 1. START TIMER (recorded as LatencyStage::ORDER_UPDATE)
+    uint64_t start_tick = tsc::now();
 
     // 2. Ignore updates for orders we don't care about
     // We check both the active entry ID and the active exit ID
+    const ClientOrderId& order_id = event.order_id;
     if (order_id != active_order_id_ && order_id != active_exit_order_id_) {
         return;
     }
 
-    std::cout << "⚡ Update [" << order_id.substr(0, 15) << "...]: " << status << "\n";
+    std::cout << "⚡ Update [" << order_id.encode().chars << "]: " << order_event_name(event.order_event) << "\n";
+
+    // The active order opens the position unless we are closing; executions of the exit
+    // (take profit) and of the closing order reduce it
+    bool is_entry = order_id == active_order_id_ && !waiting_for_close_;
+
+    switch (event.order_event) {
+        // ---------------------------------------------------------
+        // ACK (Order Accepted)
+        // ---------------------------------------------------------
+        case OrderEventType::ACK:
+            if (current_state_ == BotState::PLACING_ORDER && order_id == active_order_id_) {
+                std::cout << "  ↳ Order accepted, now working...\n";
+                current_state_ = BotState::WORKING;
+                state_entry_time_ = engine_clock::now();
+                persist_order_state(waiting_for_close_ ? OrderSlotState::CLOSING : OrderSlotState::WORKING);
+            }
+            break;
 
-    // ---------------------------------------------------------
-    // STATUS: NEW (Order Accepted)
-    // ---------------------------------------------------------
-    if (status == "New") {
-        if (current_state_ == BotState::PLACING_ORDER && order_id == active_order_id_) {
-            std::cout << "  ↳ Order accepted, now working...\n";
-            current_state_ = BotState::WORKING;
-            state_entry_time_ = std::chrono::steady_clock::now();
+        // ---------------------------------------------------------
+        // PARTIAL FILL / FILL (Trade Executed)
+        // ---------------------------------------------------------
+        case OrderEventType::PARTIAL_FILL:
+        case OrderEventType::FILL: {
+            if (is_duplicate_execution(event.exec_id)) {
+                std::cout << "  ↳ Duplicate execution ignored\n";
+                break;
+            }
+            int64_t lots = 0;
+            int64_t price = 0;
+            if (!instrument_.qty_to_lots(event.exec_qty, lots)) lots = 0;
+            if (!instrument_.price_to_ticks(event.exec_price, price)) price = 0;
+            bool last = event.order_event == OrderEventType::FILL;
+
+            if (is_entry) {
+                apply_entry_fill(lots, price);
+                if (last) {
+                    on_entry_filled();
+                } else {
+                    std::cout << "  ↳ Partial fill " << instrument_.lots_to_qty(lots) << " @ "
+                              << instrument_.ticks_to_price(price) << " (holding "
+                              << instrument_.lots_to_qty(position_lots_) << ")\n";
+                    persist_order_state(OrderSlotState::WORKING);
+                }
+            } else {
+                position_lots_ = std::max<int64_t>(position_lots_ - lots, 0);
+                if (last || position_lots_ == 0) {
+                    on_position_closed();
+                } else {
+                    std::cout << "  ↳ Partial exit " << instrument_.lots_to_qty(lots) << " (remaining "
+                              << instrument_.lots_to_qty(position_lots_) << ")\n";
+                    persist_order_state(waiting_for_close_ ? OrderSlotState::CLOSING : OrderSlotState::POSITION);
+                }
+            }
+            break;
         }
-    }
-    // ---------------------------------------------------------
-    // STATUS: FILLED (Trade Executed)
-    // ---------------------------------------------------------
-    else if (status == "Filled") {
-        
-        // CASE A: We just CLOSED a position (Profit Take or Stop Loss)
-        if (waiting_for_close_) {
-            std::cout << "✅ Position Closed.\n";
-            
-            // Clear flags
-            waiting_for_close_ = false;
-            position_filled_ = false;
-            active_exit_order_id_ = ""; 
-
-            // LOGIC: Check if this was a Stop Loss that requires Reversal
-            if (trigger_martingale_on_close_) {
-                std::cout << "⚡ LOSS REALIZED. Triggering Stop-and-Reverse...\n";
-                
-                // 1. Martingale Math: Flip Side, Double Size
-                martingale_step_++;
-                current_qty_ *= 2.0;       // Double the size
-                is_short_ = !is_short_;    // Flip Direction (Long <-> Short)
-                
-                // 2. Reset Trigger Flag
-                trigger_martingale_on_close_ = false;
-
-                // 3. Set State to IDLE 
-                // This forces the main loop to call evaluate_entry_signal() IMMEDIATELY,
-                // which will place the new reversed order at the new size.
-                current_state_ = BotState::IDLE; 
-                
-                std::cout << "🚀 REVERSING: New Qty " << current_qty_ 
-                          << " | Direction: " << (is_short_ ? "SHORT" : "LONG") << "\n";
-            } 
+
+        // ---------------------------------------------------------
+        // CANCEL / REJECT
+        // ---------------------------------------------------------
+        case OrderEventType::CANCEL:
+        case OrderEventType::REJECT:
+            std::cout << "🚫 Order " << order_event_name(event.order_event) << ".\n";
+
+            // If the Exit Order was cancelled (e.g., manually or by Stop Loss logic), we are still in position
+            if (order_id == active_exit_order_id_) {
+                 std::cout << "  ↳ Exit order cancelled. Position is UNLOCKED.\n";
+                 active_exit_order_id_ = {};
+                 // We stay IN_POSITION so manage_open_position can execute the Stop Loss market order
+                 current_state_ = BotState::IN_POSITION; 
+                 persist_order_state(OrderSlotState::POSITION);
+            }
+            // If the Closing (Market) order failed
+            else if (waiting_for_close_) {
+                 std::cout << "  ↳ Critical: Closing order failed. Retrying...\n";
+                 // Stay in position, loop will retry close
+                 current_state_ = BotState::IN_POSITION;
+                 waiting_for_close_ = false;
+                 persist_order_state(OrderSlotState::POSITION);
+            }
+            // Entry cancelled after partial fills (chase / timeout): manage what we hold
+            else if (position_lots_ > 0) {
+                std::cout << "  ↳ Entry cancelled with " << instrument_.lots_to_qty(position_lots_) << " filled.\n";
+                on_entry_filled();
+            }
+            // If the Entry order failed
             else {
-                // Standard Profit Take -> Reset to Base Risk
-                std::cout << "💰 Cycle Complete (Profit). Resetting to Base Size.\n";
-                martingale_step_ = 0;
-                current_qty_ = base_quantity_; 
+                std::cout << "  ↳ Entry failed. Back to IDLE.\n";
                 current_state_ = BotState::IDLE;
+                position_filled_ = false;
+                persist_order_state(OrderSlotState::EMPTY);
             }
-        }
-        
-        // CASE B: We just OPENED a position (Entry Filled)
-        // Action: Post the Exit Order IMMEDIATELY
-        else if (order_id == active_order_id_) {
+            break;
+    }
 
-            if (position_filled_) return;
-            std::cout << "✅ Entry Filled. Placing Exit Order IMMEDIATELY...\n";
-            position_filled_ = true;
-            current_state_ = BotState::IN_POSITION;
+    // 4. STOP TIMER: into the histograms, never to the console on the hot path
+    LatencyRecorder::get_instance().record_ticks(LatencyStage::ORDER_UPDATE, symbol_id_, start_tick, tsc::now());
+}
 
-            // 1. Calculate Target Price (Take Profit)
-            double target_price;
-            if (is_short_) {
-                // If Short, buy back lower
-                target_price = entry_price_ * (1.0 - profit_target_percent_);
-            } else {
-                // If Long, sell higher
-                target_price = entry_price_ * (1.0 + profit_target_percent_);
-            }
+bool TradingEngine::is_duplicate_execution(uint64_t exec_id) {
+    if (exec_id == 0) return false;     // No execId to tell copies apart
+    for (uint64_t seen : recent_exec_ids_) {
+        if (seen == exec_id) return true;
+    }
+    recent_exec_ids_[next_exec_slot_] = exec_id;
+    next_exec_slot_ = (next_exec_slot_ + 1) % RECENT_EXECUTIONS;
+    return false;
+}
 
-            // 2. Generate ID and Send the Exit Order NOW
-            std::string exit_side = is_short_ ? "Buy" : "Sell";
-            active_exit_order_id_ = generate_id(); 
+// Entry price becomes the volume-weighted average of the entry's executions (in ticks)
+void TradingEngine::apply_entry_fill(int64_t lots, int64_t price) {
+    if (lots <= 0) return;
+    if (price > 0) {
+        entry_price_ = position_lots_ == 0
+            ? price
+            : std::llround((static_cast<double>(entry_price_) * static_cast<double>(position_lots_) +
+                            static_cast<double>(price) * static_cast<double>(lots)) /
+                           static_cast<double>(position_lots_ + lots));
+    }
+    position_lots_ += lots;
+}
 
-            std::cout << "⚡ POSTING EXIT: " << exit_side << " @ " << target_price << "\n";
-            
-            // Pass 'true' for Maker (PostOnly) to ensure we get paid for liquidity
-            if (trade_client_) {
-                trade_client_->place_order(symbol_, exit_side, current_qty_, target_price, active_exit_order_id_, true);
-            }
-        }
+// The entry is done (fully filled, or cancelled after partial fills): post the exit
+// for what we hold IMMEDIATELY
+void TradingEngine::on_entry_filled() {
+    if (position_filled_) return;
+    std::cout << "✅ Entry Filled. Placing Exit Order IMMEDIATELY...\n";
+    position_filled_ = true;
+    current_state_ = BotState::IN_POSITION;
+    if (position_lots_ <= 0) position_lots_ = current_qty_;    // Fill without a usable execQty
+    persist_order_state(OrderSlotState::POSITION);
+    post_exit_order();
+}
+
+void TradingEngine::post_exit_order() {
+    // 1. Calculate Target Price (Take Profit), rounded to the nearest tick
+    int64_t target_price;
+    if (is_short_) {
+        // If Short, buy back lower
+        target_price = std::llround(static_cast<double>(entry_price_) * (1.0 - profit_target_percent_));
+    } else {
+        // If Long, sell higher
+        target_price = std::llround(static_cast<double>(entry_price_) * (1.0 + profit_target_percent_));
     }
-    // ---------------------------------------------------------
-    // STATUS: CANCELLED / REJECTED
-    // ---------------------------------------------------------
-    else if (status == "Cancelled" || status == "Rejected") {
-        std::cout << "🚫 Order " << status << ".\n";
-        
-        // If the Exit Order was cancelled (e.g., manually or by Stop Loss logic), we are still in position
-        if (order_id == active_exit_order_id_) {
-             std::cout << "  ↳ Exit order cancelled. Position is UNLOCKED.\n";
-             active_exit_order_id_ = "";
-             // We stay IN_POSITION so manage_open_position can execute the Stop Loss market order
-             current_state_ = BotState::IN_POSITION; 
-        }
-        // If the Closing (Market) order failed
-        else if (waiting_for_close_) {
-             std::cout << "  ↳ Critical: Closing order failed. Retrying...\n";
-             // Stay in position, loop will retry close
-             current_state_ = BotState::IN_POSITION;
-             waiting_for_close_ = false;
-        }
-        // If the Entry order failed
-        else {
-            std::cout << "  ↳ Entry failed. Back to IDLE.\n";
-            current_state_ = BotState::IDLE;
-            position_filled_ = false;
-        }
+
+    // PostOnly: never on the far side of the current touch, so it rests instead of being
+    // cancelled for crossing (the market may have run past the target)
+    TopOfBook top;
+    auto ob = orderbook_manager_.get(symbol_id_);
+    if (ob && ob->get_top_of_book(top)) {
+        target_price = is_short_ ? std::min(target_price, top.bid_price) : std::max(target_price, top.ask_price);
+    }
+
+    // 2. Generate ID and Send the Exit Order NOW
+    std::string exit_side = is_short_ ? "Buy" : "Sell";
+    if (!trade_client_ || !trade_client_->is_connected() ||
+        risk_check(OrderIntent::REDUCE, is_short_, position_lots_, target_price) != RiskVerdict::PASS) {
+        schedule_exit_retry();
+        return;
+    }
+    active_exit_order_id_ = next_order_id();
+    persist_order_state(OrderSlotState::POSITION);
+
+    // Pass 'true' for Maker (PostOnly) to ensure we get paid for liquidity
+    uint64_t sent_tick = trade_client_->place_order(symbol_, exit_side, position_lots_, target_price,
+                                                    active_exit_order_id_.encode().view(), true);
+    if (!sent_tick) {
+        active_exit_order_id_ = {};
+        persist_order_state(OrderSlotState::POSITION);
+        schedule_exit_retry();
+        return;
+    }
+    exit_repost_pending_ = false;
+    exit_retry_ms_ = 0;
+    note_order_sent(sent_tick);
+}
+
+// Take profit not sent: manage_open_position() tries again after the backoff
+void TradingEngine::schedule_exit_retry() {
+    exit_retry_ms_ = exit_retry_ms_ ? std::min(exit_retry_ms_ * 2, EXIT_RETRY_MAX_MS) : EXIT_RETRY_MIN_MS;
+    next_exit_retry_ = engine_clock::now() + std::chrono::milliseconds(exit_retry_ms_);
+    exit_repost_pending_ = true;
+}
+
+// We just CLOSED the position (Profit Take or Stop Loss)
+void TradingEngine::on_position_closed() {
+    std::cout << "✅ Position Closed.\n";
+
+    // Clear flags
+    waiting_for_close_ = false;
+    position_filled_ = false;
+    position_lots_ = 0;
+    active_exit_order_id_ = {};
+    exit_repost_pending_ = false;
+    exit_retry_ms_ = 0;
+    persist_order_state(OrderSlotState::EMPTY);
+
+    // LOGIC: Check if this was a Stop Loss that requires Reversal
+    if (trigger_martingale_on_close_) {
+        std::cout << "⚡ LOSS REALIZED. Triggering Stop-and-Reverse...\n";
+
+        // 1. Martingale Math: Flip Side, Double Size
+        martingale_step_++;
+        current_qty_ *= 2;         // Double the size
+        is_short_ = !is_short_;    // Flip Direction (Long <-> Short)
+
+        // 2. Reset Trigger Flag
+        trigger_martingale_on_close_ = false;
+
+        // 3. Set State to IDLE 
+        // This forces the main loop to call evaluate_entry_signal() IMMEDIATELY,
+        // which will place the new reversed order at the new size.
+        current_state_ = BotState::IDLE; 
+
+        std::cout << "🚀 REVERSING: New Qty " << instrument_.lots_to_qty(current_qty_) 
+                  << " | Direction: " << (is_short_ ? "SHORT" : "LONG") << "\n";
+    } 
+    else {
+        // Standard Profit Take -> Reset to Base Risk
+        std::cout << "💰 Cycle Complete (Profit). Resetting to Base Size.\n";
+        martingale_step_ = 0;
+        current_qty_ = base_quantity_; 
+        current_state_ = BotState::IDLE;
+    }
+}
+
+// ============================================================================
+// LATENCY STAMPS
+// ============================================================================
+
+// Taken when the engine has decided to send: the book update the decision was based on
+// is read now, before a newer one can overwrite its stamps.
+TradingEngine::DecisionStamp TradingEngine::stamp_decision() const {
+    DecisionStamp stamp;
+    stamp.tick = tsc::now();
+    if (auto ob = orderbook_manager_.get(symbol_id_)) {
+        stamp.book_rx_tick = ob->get_rx_tick();
+        stamp.book_applied_tick = ob->get_applied_tick();
     }
+    return stamp;
+}
 
-    // 4. STOP TIMER (Measure actual processing time)
-    auto end_time = std::chrono::high_resolution_clock::now();
+void TradingEngine::record_send_latency(const DecisionStamp& decision, uint64_t sent_tick) {
+    if (sent_tick == 0) return;     // Not sent
+    note_order_sent(sent_tick);
+    LatencyRecorder& latency = LatencyRecorder::get_instance();
+    latency.record_ticks(LatencyStage::BOOK_TO_DECISION, symbol_id_, decision.book_applied_tick, decision.tick);
+    latency.record_ticks(LatencyStage::DECISION_TO_SEND, symbol_id_, decision.tick, sent_tick);
+    latency.record_ticks(LatencyStage::WIRE_TO_SEND, symbol_id_, decision.book_rx_tick, sent_tick);
+}
 
-    // 5. CALCULATE IN NANOSECONDS
-    auto duration = std::chrono::duration_cast<std::chrono::nanoseconds>(end_time - start_time).count();
+void TradingEngine::note_order_sent(uint64_t sent_tick) {
+    if (sent_tick == 0) return;
+    order_sent_tick_ = sent_tick;
+    telemetry::bump(telemetry_->orders_sent);
+}
 
-    std::cout << "⚡ Internal Logic Latency: " << duration << " nanoseconds\n";
+// Send -> first execution report, measured at the report's arrival (not when this
+// engine got around to draining it)
+void TradingEngine::record_round_trip(uint64_t report_tick) {
+    uint64_t ns = tsc::to_ns(order_sent_tick_, report_tick);
+    order_sent_tick_ = 0;
+    LatencyRecorder::get_instance().record(LatencyStage::ORDER_ROUND_TRIP, symbol_id_, ns);
+
+    telemetry::bump(telemetry_->order_rtt_count);
+    telemetry::store(telemetry_->order_rtt_sum_ns, telemetry_->order_rtt_sum_ns.load(std::memory_order_relaxed) + ns);
+    telemetry::store(telemetry_->order_rtt_last_ns, ns);
+    if (ns > telemetry_->order_rtt_max_ns.load(std::memory_order_relaxed)) {
+        telemetry::store(telemetry_->order_rtt_max_ns, ns);
+    }
+}
+
+// Three relaxed stores per cycle: what an external reader sees of this engine
+void TradingEngine::publish_telemetry() {
+    telemetry_->engine_state.store(static_cast<int32_t>(current_state_), std::memory_order_relaxed);
+    int64_t position = is_short_ ? -position_lots_ : position_lots_;
+    telemetry_->position_lots.store(position, std::memory_order_relaxed);
+    telemetry::store(telemetry_->inbox_full_waits, inbox_full_waits_.load(std::memory_order_relaxed));
 }
 
 // ============================================================================
 // UTILITIES
 // ============================================================================
 void TradingEngine::handle_timeout() {
-    auto now = std::chrono::steady_clock::now();
+    auto now = engine_clock::now();
     auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(now - state_entry_time_).count();
     
     // If waiting for confirmation > 5 seconds, cancel and reset.
     if (elapsed > ORDER_TIMEOUT_MS) {
         std::cerr << "⏰ Timeout (" << elapsed << "ms)! Forcing cancel...\n";
-        if (trade_client_) {
-            trade_client_->cancel_order(symbol_, active_order_id_);
+        if (trade_client_ && risk_check(OrderIntent::CANCEL, false, 0, 0) == RiskVerdict::PASS) {
+            trade_client_->cancel_order(symbol_, active_order_id_.encode().view());
         }
         state_entry_time_ = now;
     }
 }
 
+// Cold path: on every order transition, so a restart resumes from the last one
+void TradingEngine::persist_order_state(OrderSlotState state) {
+    OrderStateTable& table = OrderStateTable::get_instance();
+    if (state == OrderSlotState::EMPTY) {
+        table.clear(symbol_id_);
+        return;
+    }
+
+    OpenOrder order{};
+    std::strncpy(order.symbol, symbol_.c_str(), sizeof(order.symbol) - 1);
+    if (!active_order_id_.empty()) {
+        std::memcpy(order.order_link_id, active_order_id_.encode().chars, ClientOrderId::LENGTH);
+    }
+    if (!active_exit_order_id_.empty()) {
+        std::memcpy(order.exit_order_link_id, active_exit_order_id_.encode().chars, ClientOrderId::LENGTH);
+    }
+    order.entry_price_ticks = entry_price_;
+    order.qty_lots = current_qty_;
+    order.position_lots = position_lots_;
+    order.tick = instrument_.tick;
+    order.lot = instrument_.lot;
+    order.updated_unix_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::system_clock::now().time_since_epoch()).count();
+    order.martingale_step = martingale_step_;
+    order.is_short = is_short_ ? 1 : 0;
+    order.state = state;
+    table.store(symbol_id_, order);
+}
+
 void TradingEngine::reconcile_state_on_startup() {
-    // Check if Aeron memory has an active order from a previous crash
-    if (aeron_publisher_ && aeron_publisher_->has_order_in_buffer(symbol_)) {
-        auto rec = aeron_publisher_->get_order_from_buffer(symbol_);
-        std::cout << "🔄 RECOVERING STATE from memory buffer...\n";
-        std::cout << "  Order ID: " << rec.order_id << "\n";
-        std::cout << "  Price: " << rec.price << " | Qty: " << rec.quantity << "\n";
-        
-        active_order_id_ = rec.order_id;
-        current_qty_ = rec.quantity;
-        is_short_ = (std::string(rec.side) == "Sell");
-        entry_price_ = rec.price;
-        position_filled_ = true;
-        current_state_ = BotState::IN_POSITION;
+    // Check if the order state table has an open order from a previous run
+    OpenOrder rec;
+    if (!OrderStateTable::get_instance().load(symbol_id_, rec)) return;
+
+    // Ticks/lots of the grid they were written on (instruments-info may have changed since)
+    InstrumentSpec saved = instrument_;
+    saved.tick = rec.tick;
+    saved.lot = rec.lot;
+    bool same_grid = rec.tick.mantissa == instrument_.tick.mantissa && rec.tick.decimals == instrument_.tick.decimals &&
+                     rec.lot.mantissa == instrument_.lot.mantissa && rec.lot.decimals == instrument_.lot.decimals;
+    int64_t price = same_grid ? rec.entry_price_ticks
+                              : instrument_.price_to_ticks(saved.ticks_to_price(rec.entry_price_ticks));
+    int64_t qty = same_grid ? rec.qty_lots : instrument_.qty_to_lots(saved.lots_to_qty(rec.qty_lots));
+    int64_t held = same_grid ? rec.position_lots : instrument_.qty_to_lots(saved.lots_to_qty(rec.position_lots));
+
+    std::cout << "🔄 RECOVERING STATE from order state table (" << order_slot_state_name(rec.state) << ")...\n";
+    std::cout << "  Order ID: " << rec.order_link_id << "\n";
+    std::cout << "  Price: " << instrument_.ticks_to_price(price) << " | Qty: " << instrument_.lots_to_qty(qty)
+              << " | Held: " << instrument_.lots_to_qty(held) << "\n";
+
+    // Previous-run IDs (routed by symbol, see ClientOrderId); anything else cannot be matched
+    rec.order_link_id[sizeof(rec.order_link_id) - 1] = '\0';
+    rec.exit_order_link_id[sizeof(rec.exit_order_link_id) - 1] = '\0';
+    active_order_id_ = {};
+    active_exit_order_id_ = {};
+    if (!ClientOrderId::decode(rec.order_link_id, active_order_id_)) {
+        std::cerr << "⚠️  [" << symbol_ << "] Unrecognised order ID: its reports will be ignored\n";
+    }
+    ClientOrderId::decode(rec.exit_order_link_id, active_exit_order_id_);
+    active_order_price_ = price;
+    entry_price_ = price;
+    current_qty_ = std::max(qty, instrument_.min_qty_lots);
+    position_lots_ = std::max<int64_t>(held, 0);
+    martingale_step_ = rec.martingale_step;
+    is_short_ = rec.is_short != 0;
+    state_entry_time_ = engine_clock::now();
+
+    switch (rec.state) {
+        case OrderSlotState::PENDING:
+        case OrderSlotState::WORKING:
+            // The entry may still rest: its report settles it, or the stale-order timer cancels it
+            position_filled_ = false;
+            current_state_ = BotState::WORKING;
+            break;
+        case OrderSlotState::POSITION:
+            position_filled_ = true;
+            current_state_ = BotState::IN_POSITION;
+            exit_repost_pending_ = active_exit_order_id_.empty();   // Take profit never made it out
+            break;
+        case OrderSlotState::CLOSING:
+            // Closing order in flight: its fill completes the cycle, a timeout retries the close
+            position_filled_ = true;
+            waiting_for_close_ = true;
+            current_state_ = BotState::PLACING_ORDER;
+            break;
+        case OrderSlotState::EMPTY:
+            break;
     }
 }
 
-std::string TradingEngine::generate_id() {
-    return "BOT_" + std::to_string(std::chrono::system_clock::now().time_since_epoch().count());
+ClientOrderId TradingEngine::next_order_id() {
+    return {engine_id_, static_cast<uint16_t>(symbol_id_), ++order_sequence_};
 }
 
 void TradingEngine::print_statistics() {
@@ -700,7 +1071,7 @@ void TradingEngine::print_statistics() {
 
 void TradingEngine::log_status() {
     std::cout << "💓 Heartbeat [" << symbol_ << "] State: ";
-    switch (current_state_.load()) {
+    switch (current_state_) {
         case BotState::IDLE: std::cout << "IDLE"; break;
         case BotState::PLACING_ORDER: std::cout << "PLACING"; break;
         case BotState::WORKING: std::cout << "WORKING"; break;
@@ -713,5 +1084,9 @@ void TradingEngine::log_status() {
         std::cout << " | PnL: " << std::fixed << std::setprecision(2) 
                   << (last_pnl_percent_ * 100) << "% ($" << last_pnl_dollars_ << ")";
     }
+    if (signals_.valid) {
+        std::cout << " | Imb: " << std::fixed << std::setprecision(2) << signals_.imbalance
+                  << " Spread: " << signals_.ewma_spread << "t Vol: " << signals_.ewma_volatility_bps << "bps";
+    }
     std::cout << "\n";
 }
\ No newline at end of file
@@ -1,57 +1,122 @@
 // src/utils/AeronSpy.cpp
+// Book stream monitor built on MarketDataConsumer: decodes the gateway's SBE book
+// messages, keeps the local books and prints their top of book.
+//
+//   aeron_spy [--channel C] [--stream N] [--symbol SYM]... [--idle spin|yield|backoff|sleep]
+//             [--limit N] [--every MS] [--quiet]
 #include <iostream>
-#include <thread>
 #include <atomic>
+#include <chrono>
 #include <csignal>
-#include "Aeron.h"
+#include <cstdlib>
+#include <iomanip>
+#include <string>
+#include <thread>
+#include <unordered_map>
 
-using namespace aeron;
+#include "messaging/MarketDataConsumer.h"
 
 // Handle Ctrl+C to stop cleanly
 std::atomic<bool> running(true);
 void sig_handler(int) { running = false; }
 
-// Callback function: This runs every time data is found in the buffer
-fragment_handler_t handler = [](AtomicBuffer& buffer, util::index_t offset, util::index_t length, Header& header) {
-    std::cout << "📨 RECEIVED [" << length << " bytes] from Session " << header.sessionId() << "\n";
-    
-    // Read the raw data as a string (assuming you sent text/json)
-    // If you sent SBE binary, this will look like garbage characters, but it proves arrival.
-    std::string data(reinterpret_cast<const char*>(buffer.buffer() + offset), length);
-    std::cout << "   Payload: " << data.substr(0, 100) << (data.length() > 100 ? "..." : "") << "\n\n";
-};
-
-int main() {
+static void print_usage() {
+    std::cerr << "Usage: aeron_spy [--channel C] [--stream N] [--symbol SYM]... [--idle spin|yield|backoff|sleep]\n"
+              << "                 [--limit N] [--every MS] [--quiet]\n"
+              << "  --channel C   Aeron channel (default aeron:ipc)\n"
+              << "  --stream N    Book stream (default 1001)\n"
+              << "  --symbol SYM  Only keep these books (repeatable, default all)\n"
+              << "  --idle MODE   Between empty polls (default backoff)\n"
+              << "  --limit N     Fragments per poll (default 10)\n"
+              << "  --every MS    Print each book at most every MS ms (default 1000, 0 = every update)\n"
+              << "  --quiet       Counters only\n";
+}
+
+static bool parse_idle(const std::string& name, ConsumerIdle& out) {
+    if (name == "spin") out = ConsumerIdle::BUSY_SPIN;
+    else if (name == "yield") out = ConsumerIdle::YIELD;
+    else if (name == "backoff") out = ConsumerIdle::BACKOFF;
+    else if (name == "sleep") out = ConsumerIdle::SLEEP;
+    else return false;
+    return true;
+}
+
+int main(int argc, char** argv) {
     std::signal(SIGINT, sig_handler);
 
+    ConsumerOptions options;
+    int64_t every_ms = 1000;
+    bool quiet = false;
+
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        if (arg == "--channel" && i + 1 < argc) {
+            options.channel = argv[++i];
+        } else if (arg == "--stream" && i + 1 < argc) {
+            options.stream_id = std::atoi(argv[++i]);
+        } else if (arg == "--symbol" && i + 1 < argc) {
+            options.symbols.push_back(argv[++i]);
+        } else if (arg == "--idle" && i + 1 < argc && parse_idle(argv[i + 1], options.idle)) {
+            ++i;
+        } else if (arg == "--limit" && i + 1 < argc) {
+            options.fragment_limit = std::atoi(argv[++i]);
+        } else if (arg == "--every" && i + 1 < argc) {
+            every_ms = std::atoll(argv[++i]);
+        } else if (arg == "--quiet") {
+            quiet = true;
+        } else {
+            print_usage();
+            return 1;
+        }
+    }
+
     std::cout << "🕵️‍♂️  STARTING AERON SPY...\n";
-    std::cout << "    Channel: aeron:ipc\n";
-    std::cout << "    Stream:  1001\n";
+    std::cout << "    Channel: " << options.channel << "\n";
+    std::cout << "    Stream:  " << options.stream_id << "\n";
 
     // 1. Connect to the same Media Driver your bot uses
-    Context context;
-    std::shared_ptr<Aeron> aeron = Aeron::connect(context);
+    MarketDataConsumer consumer(options);
+    if (!consumer.connect()) return 1;
+    std::cout << "✅ Subscribed! Waiting for books...\n";
+
+    // 2. Print books as they change (throttled per symbol)
+    using clock = std::chrono::steady_clock;
+    std::unordered_map<std::string, clock::time_point> last_print;
+    consumer.set_book_callback([&](const LocalBook& book, BookUpdate update) {
+        if (update == BookUpdate::GAP) {
+            std::cout << "⚠️  " << book.symbol << " gap after u=" << book.update_id
+                      << ", waiting for the next snapshot\n";
+            return;
+        }
+        if (quiet) return;
 
-    // 2. Add a Subscriber to the specific channel
-    std::int64_t id = aeron->addSubscription("aeron:ipc", 1001);
-    std::shared_ptr<Subscription> subscription = aeron->findSubscription(id);
+        auto now = clock::now();
+        auto& last = last_print[book.symbol];
+        if (update == BookUpdate::DELTA && every_ms > 0 && now - last < std::chrono::milliseconds(every_ms)) return;
+        last = now;
 
-    // 3. Wait for the subscription to be ready
-    while (!subscription) {
-        std::this_thread::yield();
-        subscription = aeron->findSubscription(id);
-    }
-    std::cout << "✅ Connected to Buffer! Waiting for data...\n";
+        std::cout << (update == BookUpdate::SNAPSHOT ? "📸 " : "📨 ") << std::left << std::setw(14) << book.symbol
+                  << std::right << " u=" << book.update_id << std::setprecision(10)
+                  << "  bid " << book.best_bid() << " x " << (book.bid_count ? book.quantity(book.bids[0].quantity) : 0.0)
+                  << "  ask " << book.best_ask() << " x " << (book.ask_count ? book.quantity(book.asks[0].quantity) : 0.0)
+                  << "  (" << book.bid_count << "/" << book.ask_count << " levels, session " << book.session_id << ")\n";
+    });
+
+    // 3. Poll on a worker thread, report counters here
+    std::thread poller([&] { consumer.run(running); });
 
-    // 4. Constant loop to poll for new data
     while (running) {
-        // poll(handler, limit) -> Returns number of fragments read
-        int fragments_read = subscription->poll(handler, 10);
-        if (fragments_read == 0) {
-            std::this_thread::sleep_for(std::chrono::milliseconds(1)); // Don't burn 100% CPU waiting
+        std::this_thread::sleep_for(std::chrono::seconds(1));
+        if (quiet) {
+            std::cout << "📊 messages " << consumer.get_messages() << "  snapshots " << consumer.get_snapshots()
+                      << "  deltas " << consumer.get_deltas() << "  gaps " << consumer.get_gaps()
+                      << "  filtered " << consumer.get_filtered() << "  stale " << consumer.get_stale()
+                      << "  malformed " << consumer.get_malformed() << "\n";
         }
     }
+    poller.join();
 
-    std::cout << "🛑 Spy stopping.\n";
+    std::cout << "🛑 Spy stopping. " << consumer.get_messages() << " messages, "
+              << consumer.get_gaps() << " gaps, " << consumer.get_malformed() << " malformed\n";
     return 0;
-}
\ No newline at end of file
+}
@@ -0,0 +1,62 @@
+#include "utils/AllocationCounter.h"
+#include <cstdlib>
+#include <new>
+
+// ============================================================================
+// THREAD-LOCAL COUNTER
+// ============================================================================
+// Plain integer with constant initialization: no TLS constructor runs, so it is
+// safe to touch from inside operator new during static initialization.
+namespace {
+    thread_local uint64_t t_allocations = 0;
+
+    void* counted_malloc(std::size_t size) {
+        t_allocations++;
+        if (size == 0) size = 1;
+        if (void* p = std::malloc(size)) return p;
+        throw std::bad_alloc();
+    }
+
+    void* counted_aligned_malloc(std::size_t size, std::align_val_t align) {
+        t_allocations++;
+        std::size_t alignment = static_cast<std::size_t>(align);
+        // aligned_alloc requires size to be a multiple of the alignment
+        size = (size + alignment - 1) / alignment * alignment;
+        if (size == 0) size = alignment;
+        if (void* p = std::aligned_alloc(alignment, size)) return p;
+        throw std::bad_alloc();
+    }
+}
+
+uint64_t alloc_counter::thread_allocations() {
+    return t_allocations;
+}
+
+// ============================================================================
+// GLOBAL OPERATOR NEW / DELETE REPLACEMENTS
+// ============================================================================
+// The array and nothrow forms of the standard library forward to these.
+
+void* operator new(std::size_t size) {
+    return counted_malloc(size);
+}
+
+void* operator new(std::size_t size, std::align_val_t align) {
+    return counted_aligned_malloc(size, align);
+}
+
+void operator delete(void* p) noexcept {
+    std::free(p);
+}
+
+void operator delete(void* p, std::size_t) noexcept {
+    std::free(p);
+}
+
+void operator delete(void* p, std::align_val_t) noexcept {
+    std::free(p);
+}
+
+void operator delete(void* p, std::size_t, std::align_val_t) noexcept {
+    std::free(p);
+}
@@ -1,44 +1,99 @@
 #include "utils/DataLogger.h"
+#include "utils/CpuPause.h"
 #include <iostream>
 #include <sstream>
 #include <iomanip>
 #include <chrono>
 #include <ctime>
+#include <cstdlib>
+#include <cstring>
+#include <cerrno>
 #include <algorithm>
+#include <fcntl.h>
+#include <unistd.h>
 #include <sys/stat.h> // Required for mkdir
 
-DataLogger::DataLogger(const std::string& filename) {
+namespace {
+std::atomic<uint64_t> next_logger_id{1};
+
+// Per-thread cache of "which ring do I write to", keyed by logger instance
+thread_local uint64_t t_logger_id = 0;
+thread_local void* t_producer = nullptr;
+}
+
+DataLogger::DataLogger(const std::string& filename, const AsyncLogOptions& options)
+    : options_(options),
+      logger_id_(next_logger_id.fetch_add(1, std::memory_order_relaxed)) {
     auto now = std::chrono::system_clock::now();
     auto time = std::chrono::system_clock::to_time_t(now);
-    
+
     std::stringstream ss;
     ss << std::put_time(std::localtime(&time), "%Y%m%d_%H%M%S");
     log_file_path = "logs/" + ss.str() + "_" + filename;
-    
+
     // Create logs directory (Linux/macOS)
     mkdir("logs", 0777);
-    
-    log_file.open(log_file_path, std::ios::app);
-    if (log_file.is_open()) {
-        log_file << "========================================\n";
-        log_file << "Bybit Trading Bot - Data Log\n";
-        log_file << "Start Time: " << ss.str() << "\n";
-        log_file << "========================================\n\n";
-        log_file.flush();
-        std::cout << "✓ Data logger initialized: " << log_file_path << "\n";
-    } else {
+
+    int flags = O_WRONLY | O_CREAT;
+#ifdef O_DIRECT
+    if (options_.direct_io) flags |= O_DIRECT;
+#else
+    options_.direct_io = false;
+#endif
+    fd_ = open(log_file_path.c_str(), flags, 0644);
+    if (fd_ < 0 && options_.direct_io) {
+        // Filesystem without O_DIRECT support (tmpfs, some overlays)
+        std::cerr << "⚠️  O_DIRECT not supported for " << log_file_path << ", using buffered writes\n";
+        options_.direct_io = false;
+        fd_ = open(log_file_path.c_str(), O_WRONLY | O_CREAT, 0644);
+    }
+    if (fd_ < 0) {
         std::cerr << "Failed to open log file: " << log_file_path << "\n";
+        return;
     }
+
+    off_t end = lseek(fd_, 0, SEEK_END);
+    file_offset_ = end > 0 ? static_cast<uint64_t>(end) : 0;
+    if (options_.direct_io && (file_offset_ % DIRECT_IO_ALIGN) != 0) {
+        // Appending to an unaligned tail is not possible with O_DIRECT
+        fcntl(fd_, F_SETFL, fcntl(fd_, F_GETFL) & ~O_DIRECT);
+        options_.direct_io = false;
+    }
+
+    batch_ = static_cast<char*>(std::aligned_alloc(DIRECT_IO_ALIGN, BATCH_BYTES + DIRECT_IO_ALIGN));
+
+    auto wall_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(
+        now.time_since_epoch()).count();
+    wall_minus_mono_ns_ = wall_ns - monotonic_ns();
+
+    std::string banner = "========================================\n"
+                         "Bybit Trading Bot - Data Log\n"
+                         "Start Time: " + ss.str() + "\n"
+                         "========================================\n\n";
+    push(RECORD_RAW, {}, banner);
+
+    running_.store(true, std::memory_order_release);
+    writer_thread_ = std::thread(&DataLogger::writer_loop, this);
+    std::cout << "✓ Data logger initialized: " << log_file_path
+              << (options_.direct_io ? " (async, O_DIRECT)" : " (async)") << "\n";
 }
 
 DataLogger::~DataLogger() {
-    if (log_file.is_open()) {
-        log_file << "\n========================================\n";
-        log_file << "Log session ended\n";
-        log_file << "========================================\n";
-        log_file.flush();
-        log_file.close();
-    }
+    if (fd_ < 0) return;
+
+    push(RECORD_RAW, {},
+         "\n========================================\n"
+         "Log session ended\n"
+         "========================================\n");
+
+    running_.store(false, std::memory_order_release);
+    if (writer_thread_.joinable()) writer_thread_.join();
+
+    close(fd_);
+    std::free(batch_);
+
+    uint64_t dropped = dropped_.load();
+    if (dropped) std::cerr << "⚠️  Data logger dropped " << dropped << " records (ring full)\n";
 }
 
 std::string DataLogger::get_timestamp() const {
@@ -49,81 +104,261 @@ std::string DataLogger::get_timestamp() const {
     return ss.str();
 }
 
+int64_t DataLogger::monotonic_ns() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+// ============================================================================
+// PRODUCER SIDE (any thread)
+// ============================================================================
+
+DataLogger::Producer* DataLogger::producer_for_this_thread() {
+    if (t_logger_id == logger_id_) return static_cast<Producer*>(t_producer);
+
+    // Cold path: first record from this thread (or the thread last used another logger)
+    std::lock_guard<std::mutex> lock(register_mutex_);
+    Producer* producer = nullptr;
+    for (auto& existing : producer_storage_) {
+        if (existing->owner == std::this_thread::get_id()) producer = existing.get();
+    }
+
+    if (!producer) {
+        size_t count = producer_count_.load(std::memory_order_relaxed);
+        if (count == MAX_PRODUCERS) return nullptr;
+
+        producer_storage_.push_back(std::make_unique<Producer>(options_.ring_bytes));
+        producer = producer_storage_.back().get();
+        producers_[count].store(producer, std::memory_order_release);
+        producer_count_.store(count + 1, std::memory_order_release);
+    }
+
+    t_logger_id = logger_id_;
+    t_producer = producer;
+    return producer;
+}
+
+// Copies one record into the calling thread's ring. No lock, no syscall, no allocation.
+void DataLogger::push(uint16_t flags, std::string_view tag, std::string_view message) {
+    if (fd_ < 0) return;
+
+    Producer* producer = producer_for_this_thread();
+    if (!producer) {
+        dropped_.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+
+    tag = tag.substr(0, UINT16_MAX);
+    size_t len = sizeof(RecordHeader) + tag.size() + message.size();
+    if (len + SpscByteRing::HEADER_SIZE > producer->ring.capacity()) {
+        dropped_.fetch_add(1, std::memory_order_relaxed);       // Can never fit
+        return;
+    }
+
+    SpscByteRing& ring = producer->ring;
+    if (options_.full_policy == LogFullPolicy::SAMPLE &&
+        ring.used_bytes() > ring.capacity() / 2 &&
+        (producer->sample_counter++ % options_.sample_every) != 0) {
+        dropped_.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+
+    char* out = ring.try_claim(static_cast<uint32_t>(len));
+    if (!out && options_.full_policy == LogFullPolicy::BLOCK) {
+        while (!out && running_.load(std::memory_order_relaxed)) {
+            cpu_pause();
+            out = ring.try_claim(static_cast<uint32_t>(len));
+        }
+    }
+    if (!out) {
+        dropped_.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+
+    RecordHeader header{monotonic_ns(), flags, static_cast<uint16_t>(tag.size()),
+                        static_cast<uint32_t>(message.size())};
+    std::memcpy(out, &header, sizeof(header));
+    std::memcpy(out + sizeof(header), tag.data(), tag.size());
+    std::memcpy(out + sizeof(header) + tag.size(), message.data(), message.size());
+    ring.commit();
+}
+
+// [FIXED] Updated to use correct member variables
+// Called on the market-data and order-entry hot paths: only copies the views into the
+// thread's ring; the timestamp is rendered later by the writer thread.
+void DataLogger::log(std::string_view tag, std::string_view message) {
+    push(RECORD_TAGGED, tag, message);
+}
+
+// Cold-path records are still formatted on the caller (same text as before) and
+// journaled verbatim through the same ring, so they stay in order with the thread's
+// hot-path records.
 void DataLogger::log_orderbook(
     const std::string& symbol,
     double mid_price,
     const std::vector<std::pair<double, double>>& bids,
     const std::vector<std::pair<double, double>>& asks
 ) {
-    std::lock_guard<std::mutex> lock(log_mutex);
-    if (!log_file.is_open()) return;
-    
-    log_file << "[" << get_timestamp() << "] "
-              << symbol << " | Fair Price: $" << std::fixed 
-              << std::setprecision(2) << mid_price << "\n";
-    
-    log_file << "  BIDS: ";
+    std::ostringstream out;
+    out << "[" << get_timestamp() << "] "
+        << symbol << " | Fair Price: $" << std::fixed
+        << std::setprecision(2) << mid_price << "\n";
+
+    out << "  BIDS: ";
     for (size_t i = 0; i < std::min(size_t(5), bids.size()); ++i) {
-        log_file << bids[i].first << "(" << bids[i].second << ") ";
+        out << bids[i].first << "(" << bids[i].second << ") ";
     }
-    log_file << "\n";
-    
-    log_file << "  ASKS: ";
+    out << "\n";
+
+    out << "  ASKS: ";
     for (size_t i = 0; i < std::min(size_t(5), asks.size()); ++i) {
-        log_file << asks[i].first << "(" << asks[i].second << ") ";
+        out << asks[i].first << "(" << asks[i].second << ") ";
     }
-    log_file << "\n";
-    log_file.flush();
+    out << "\n";
+    push(RECORD_RAW, {}, out.str());
 }
 
 void DataLogger::log_symbol_subscription(const std::vector<std::string>& symbols) {
-    std::lock_guard<std::mutex> lock(log_mutex);
-    if (!log_file.is_open()) return;
-    
-    log_file << "\n[SUBSCRIPTION] Total symbols: " << symbols.size() << "\n";
-    log_file << "Symbols: ";
+    std::ostringstream out;
+    out << "\n[SUBSCRIPTION] Total symbols: " << symbols.size() << "\n";
+    out << "Symbols: ";
     for (size_t i = 0; i < symbols.size(); ++i) {
-        log_file << symbols[i];
-        if (i < symbols.size() - 1) log_file << ", ";
-        if ((i + 1) % 10 == 0) log_file << "\n          ";
+        out << symbols[i];
+        if (i < symbols.size() - 1) out << ", ";
+        if ((i + 1) % 10 == 0) out << "\n          ";
     }
-    log_file << "\n\n";
-    log_file.flush();
+    out << "\n\n";
+    push(RECORD_RAW, {}, out.str());
 }
 
 void DataLogger::log_statistics(uint64_t messages, uint64_t aeron_published, size_t active_symbols) {
-    std::lock_guard<std::mutex> lock(log_mutex);
-    if (!log_file.is_open()) return;
-    
-    log_file << "\n[STATS] " << get_timestamp()
-              << " | Messages: " << messages
-              << " | Aeron Published: " << aeron_published
-              << " | Active Symbols: " << active_symbols << "\n";
-    log_file.flush();
+    std::ostringstream out;
+    out << "\n[STATS] " << get_timestamp()
+        << " | Messages: " << messages
+        << " | Aeron Published: " << aeron_published
+        << " | Active Symbols: " << active_symbols << "\n";
+    push(RECORD_RAW, {}, out.str());
 }
 
 void DataLogger::log_error(const std::string& error_message) {
-    std::lock_guard<std::mutex> lock(log_mutex);
-    if (!log_file.is_open()) return;
-    
-    log_file << "\n[ERROR] " << get_timestamp() 
-              << " | " << error_message << "\n";
-    log_file.flush();
+    std::ostringstream out;
+    out << "\n[ERROR] " << get_timestamp()
+        << " | " << error_message << "\n";
+    push(RECORD_RAW, {}, out.str());
 }
 
 std::string DataLogger::get_log_path() const {
     return log_file_path;
 }
 
-// [FIXED] Updated to use correct member variables
-void DataLogger::log(const std::string& tag, const std::string& message) {
-    std::lock_guard<std::mutex> lock(log_mutex); // Fixed: file_mutex_ -> log_mutex
-    
-    if (log_file.is_open()) { // Fixed: log_file_ -> log_file
-        log_file << "[" << get_timestamp() << "] " // Fixed: get_current_time -> get_timestamp
-                  << "[" << tag << "] "
-                  << message << "\n";
-        
-        log_file.flush(); 
-    }
-}
\ No newline at end of file
+// ============================================================================
+// WRITER THREAD
+// ============================================================================
+
+void DataLogger::writer_loop() {
+    std::string placed = thread_affinity::apply_placement("log-writer", options_.writer);
+    if (!placed.empty()) std::cout << "  ✓ Log writer thread started" << placed << "\n";
+
+    while (running_.load(std::memory_order_acquire)) {
+        size_t records = drain_all();
+        if (batch_len_) flush_batch(false);
+        if (records == 0) std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+
+    // Shutdown: everything pushed before the stop flag is on disk
+    drain_all();
+    flush_batch(true);
+}
+
+size_t DataLogger::drain_all() {
+    size_t records = 0;
+    size_t count = producer_count_.load(std::memory_order_acquire);
+    for (size_t i = 0; i < count; ++i) {
+        Producer* producer = producers_[i].load(std::memory_order_acquire);
+        records += producer->ring.drain([this](const char* record, uint32_t len) {
+            render(record, len);
+        });
+    }
+    return records;
+}
+
+// Text formatter: same "[HH:MM:SS] [TAG] message" lines the synchronous logger wrote
+void DataLogger::render(const char* record, uint32_t len) {
+    RecordHeader header;
+    std::memcpy(&header, record, sizeof(header));
+    const char* tag = record + sizeof(header);
+    const char* message = tag + header.tag_len;
+    (void)len;
+
+    if (header.flags == RECORD_RAW) {
+        append_batch(message, header.message_len);
+        return;
+    }
+
+    int64_t wall_s = (header.mono_ns + wall_minus_mono_ns_) / 1000000000;
+    if (wall_s != cached_second_) {
+        std::time_t time = static_cast<std::time_t>(wall_s);
+        std::tm tm_buf;
+        localtime_r(&time, &tm_buf);
+        cached_ts_len_ = std::strftime(cached_ts_, sizeof(cached_ts_), "%H:%M:%S", &tm_buf);
+        cached_second_ = wall_s;
+    }
+
+    append_batch("[", 1);
+    append_batch(cached_ts_, cached_ts_len_);
+    append_batch("] [", 3);
+    append_batch(tag, header.tag_len);
+    append_batch("] ", 2);
+    append_batch(message, header.message_len);
+    append_batch("\n", 1);
+}
+
+void DataLogger::append_batch(const char* data, size_t len) {
+    while (len > 0) {
+        if (batch_len_ == BATCH_BYTES) flush_batch(false);
+        size_t chunk = std::min(len, BATCH_BYTES - batch_len_);
+        std::memcpy(batch_ + batch_len_, data, chunk);
+        batch_len_ += chunk;
+        data += chunk;
+        len -= chunk;
+    }
+}
+
+// One write per batch. With O_DIRECT only whole blocks go out; the partial tail stays
+// in the buffer until more data arrives, or is zero-padded and truncated at shutdown.
+void DataLogger::flush_batch(bool final_block) {
+    size_t to_write = batch_len_;
+    if (options_.direct_io) {
+        to_write = batch_len_ & ~(DIRECT_IO_ALIGN - 1);
+        if (final_block && to_write < batch_len_) {
+            to_write += DIRECT_IO_ALIGN;
+            std::memset(batch_ + batch_len_, 0, to_write - batch_len_);
+        }
+    }
+
+    size_t done = 0;
+    while (done < to_write) {
+        ssize_t n = pwrite(fd_, batch_ + done, to_write - done, file_offset_ + done);
+        if (n <= 0) {
+            if (n < 0 && errno == EINTR) continue;
+            break;          // Disk full / IO error: drop the batch rather than stall producers
+        }
+        done += static_cast<size_t>(n);
+    }
+
+    size_t logical = std::min(to_write, batch_len_);
+    written_bytes_.fetch_add(logical, std::memory_order_relaxed);
+
+    if (options_.direct_io && final_block) {
+        file_offset_ += batch_len_;
+        if (ftruncate(fd_, static_cast<off_t>(file_offset_)) != 0) {
+            std::cerr << "⚠️  Failed to trim log padding: " << log_file_path << "\n";
+        }
+        batch_len_ = 0;
+        return;
+    }
+
+    file_offset_ += logical;
+    std::memmove(batch_, batch_ + logical, batch_len_ - logical);
+    batch_len_ -= logical;
+}
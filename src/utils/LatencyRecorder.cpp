@@ -0,0 +1,107 @@
+#include "utils/LatencyRecorder.h"
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+
+// ============================================================================
+// REGISTRATION (cold path)
+// ============================================================================
+
+void LatencyRecorder::prepare_symbol(uint32_t symbol_id) {
+    if (symbol_id >= SymbolRegistry::MAX_SYMBOLS) return;
+    std::lock_guard<std::mutex> lock(prepare_mutex_);
+    if (owned_[symbol_id]) return;
+    owned_[symbol_id] = std::make_unique<SymbolStages>();
+    symbols_[symbol_id].store(owned_[symbol_id].get(), std::memory_order_release);
+}
+
+const LatencyRecorder::SymbolStages* LatencyRecorder::symbol(uint32_t symbol_id) const {
+    if (symbol_id >= SymbolRegistry::MAX_SYMBOLS) return nullptr;
+    return symbols_[symbol_id].load(std::memory_order_acquire);
+}
+
+const char* LatencyRecorder::stage_name(LatencyStage stage) {
+    switch (stage) {
+        case LatencyStage::WIRE_TO_PARSE:    return "wire_to_parse";
+        case LatencyStage::PARSE_TO_BOOK:    return "parse_to_book";
+        case LatencyStage::BOOK_TO_DECISION: return "book_to_decision";
+        case LatencyStage::DECISION_TO_SEND: return "decision_to_send";
+        case LatencyStage::WIRE_TO_SEND:     return "wire_to_send";
+        case LatencyStage::MATCH_TO_PUSH:    return "match_to_push";
+        case LatencyStage::PUSH_TO_WIRE:     return "push_to_wire";
+        case LatencyStage::ORDER_UPDATE:     return "order_update";
+        case LatencyStage::ORDER_ROUND_TRIP: return "order_round_trip";
+        case LatencyStage::SEND_QUEUE:       return "send_queue";
+        case LatencyStage::COUNT:            break;
+    }
+    return "unknown";
+}
+
+// ============================================================================
+// EXPORT
+// ============================================================================
+
+namespace {
+
+template <typename Histogram>
+void write_stage(std::ofstream& out, const char* name, const Histogram& h) {
+    char buf[256];
+    std::snprintf(buf, sizeof(buf),
+                  "\"%s\":{\"count\":%llu,\"mean\":%llu,\"p50\":%llu,\"p90\":%llu,"
+                  "\"p99\":%llu,\"p999\":%llu,\"max\":%llu}",
+                  name,
+                  static_cast<unsigned long long>(h.count()),
+                  static_cast<unsigned long long>(h.mean()),
+                  static_cast<unsigned long long>(h.percentile(50.0)),
+                  static_cast<unsigned long long>(h.percentile(90.0)),
+                  static_cast<unsigned long long>(h.percentile(99.0)),
+                  static_cast<unsigned long long>(h.percentile(99.9)),
+                  static_cast<unsigned long long>(h.max()));
+    out << buf;
+}
+
+} // namespace
+
+// {"timestamp_ns":..., "unit":"ns", "stages":{"wire_to_parse":{...}, ...},
+//  "symbols":{"BTCUSDT":{"wire_to_parse":{...}, ...}, ...}}
+// Written to a temp file and renamed, so a reader never sees a torn export
+bool LatencyRecorder::write_json(const std::string& path) const {
+    std::string tmp_path = path + ".tmp";
+    {
+        std::ofstream out(tmp_path, std::ios::trunc);
+        if (!out) return false;
+
+        auto now = std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::system_clock::now().time_since_epoch()).count();
+        out << "{\"timestamp_ns\":" << now << ",\"unit\":\"ns\",\"stages\":{";
+        for (size_t s = 0; s < LATENCY_STAGES; s++) {
+            if (s) out << ',';
+            write_stage(out, stage_name(static_cast<LatencyStage>(s)), totals_[s]);
+        }
+        out << "},\"symbols\":{";
+
+        bool first_symbol = true;
+        for (uint32_t id = 0; id < SymbolRegistry::MAX_SYMBOLS; id++) {
+            const SymbolStages* per = symbol(id);
+            if (!per) continue;
+
+            bool first_stage = true;
+            for (size_t s = 0; s < LATENCY_STAGES; s++) {
+                if (per->stages[s].count() == 0) continue;
+                if (first_stage) {
+                    if (!first_symbol) out << ',';
+                    out << '"' << SymbolRegistry::get_instance().name(id) << "\":{";
+                    first_symbol = false;
+                } else {
+                    out << ',';
+                }
+                write_stage(out, stage_name(static_cast<LatencyStage>(s)), per->stages[s]);
+                first_stage = false;
+            }
+            if (!first_stage) out << '}';
+        }
+        out << "}}\n";
+        if (!out) return false;
+    }
+    return std::rename(tmp_path.c_str(), path.c_str()) == 0;
+}
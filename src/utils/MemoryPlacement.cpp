@@ -0,0 +1,94 @@
+#include "utils/MemoryPlacement.h"
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <cstring>
+#include <iostream>
+#include <new>
+#include <utility>
+#include <sys/mman.h>
+#include <unistd.h>
+
+#if defined(__linux__)
+#include <sys/syscall.h>
+#endif
+
+namespace {
+    constexpr size_t HUGE_PAGE_BYTES = 2 * 1024 * 1024;
+    std::atomic<bool> g_huge_pages{false};
+
+    size_t round_up(size_t bytes, size_t unit) { return (bytes + unit - 1) / unit * unit; }
+}
+
+void memory_placement::set_huge_pages(bool enabled) {
+    g_huge_pages.store(enabled, std::memory_order_relaxed);
+}
+
+bool memory_placement::huge_pages_enabled() {
+    return g_huge_pages.load(std::memory_order_relaxed);
+}
+
+bool memory_placement::prefer_node(int node) {
+    if (node < 0) return false;
+
+#if defined(__linux__) && defined(SYS_set_mempolicy)
+    // set_mempolicy(2) directly: no libnuma dependency for one call
+    constexpr int MPOL_PREFERRED_MODE = 1;
+    unsigned long mask = 0;
+    if (node >= static_cast<int>(sizeof(mask) * 8)) return false;
+    mask = 1UL << node;
+    if (syscall(SYS_set_mempolicy, MPOL_PREFERRED_MODE, &mask, sizeof(mask) * 8 + 1) != 0) {
+        std::cerr << "⚠️  Failed to prefer NUMA node " << node << " (" << std::strerror(errno) << ")\n";
+        return false;
+    }
+    return true;
+#else
+    std::cerr << "⚠️  NUMA placement not supported on this platform (node " << node << " ignored)\n";
+    return false;
+#endif
+}
+
+// ============================================================================
+// MAPPED REGION
+// ============================================================================
+
+MappedRegion::MappedRegion(size_t bytes) {
+    size_t page = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+    bool huge_pages = memory_placement::huge_pages_enabled();
+    size_ = round_up(std::max<size_t>(bytes, 1), huge_pages ? HUGE_PAGE_BYTES : page);
+
+    void* addr = MAP_FAILED;
+#if defined(MAP_HUGETLB)
+    if (huge_pages) {
+        // Reserved pool first; ENOMEM just means none are reserved
+        addr = mmap(nullptr, size_, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+        huge_ = addr != MAP_FAILED;
+    }
+#endif
+    if (addr == MAP_FAILED) {
+        addr = mmap(nullptr, size_, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        if (addr == MAP_FAILED) throw std::bad_alloc();
+#if defined(MADV_HUGEPAGE)
+        if (huge_pages) madvise(addr, size_, MADV_HUGEPAGE);
+#endif
+    }
+    data_ = static_cast<char*>(addr);
+}
+
+MappedRegion::~MappedRegion() {
+    if (data_) munmap(data_, size_);
+}
+
+MappedRegion::MappedRegion(MappedRegion&& other) noexcept
+    : data_(std::exchange(other.data_, nullptr)), size_(std::exchange(other.size_, 0)),
+      huge_(std::exchange(other.huge_, false)) {}
+
+MappedRegion& MappedRegion::operator=(MappedRegion&& other) noexcept {
+    if (this != &other) {
+        if (data_) munmap(data_, size_);
+        data_ = std::exchange(other.data_, nullptr);
+        size_ = std::exchange(other.size_, 0);
+        huge_ = std::exchange(other.huge_, false);
+    }
+    return *this;
+}
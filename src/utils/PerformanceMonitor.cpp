@@ -1,33 +1,115 @@
 #include "utils/PerformanceMonitor.h"
+#include "utils/LatencyRecorder.h"
+#include "utils/TelemetrySegment.h"
+#include "trading/EngineScheduler.h"
+#include "trading/RiskGate.h"
+#include "messaging/AeronPublisher.h"
+#include <algorithm>
+#include <cstdio>
 #include <iostream>
 #include <thread>
 #include <chrono>
 
 PerformanceMonitor::PerformanceMonitor(
-    BybitWebSocketClient& ws,
+    FeedHandlerPool& feed,
     OrderBookManager& obm,
-    DataLogger& logger
-) : ws_client_(ws), orderbook_manager_(obm), data_logger_(logger) {}
+    DataLogger& logger,
+    const BotConfiguration& config
+) : feed_pool_(feed), orderbook_manager_(obm), data_logger_(logger), config_(config) {}
 
 void PerformanceMonitor::run() {
+    auto report_interval = std::chrono::seconds(std::max(config_.perf_report_interval_s, 1));
+    auto sample_interval = std::chrono::milliseconds(std::max(config_.telemetry_interval_ms, 10));
+    auto next_report = std::chrono::steady_clock::now() + report_interval;
+    auto next_sample = std::chrono::steady_clock::now();
+
     while (running_) {
-        std::this_thread::sleep_for(std::chrono::seconds(5));
-        
-        uint64_t messages = ws_client_.get_message_count();
-        uint64_t aeron_pub = ws_client_.get_aeron_count();
-        size_t symbols = orderbook_manager_.size();
-        
-        std::cout << "\n========== PERFORMANCE STATS ==========\n";
-        std::cout << "Messages received: " << messages << "\n";
-        std::cout << "Aeron published: " << aeron_pub << "\n";
-        std::cout << "Active symbols: " << symbols << "\n";
-        std::cout << "======================================\n\n";
-        
-        data_logger_.log_statistics(messages, aeron_pub, symbols);
+        auto now = std::chrono::steady_clock::now();
+        if (config_.telemetry_enabled && now >= next_sample) {
+            sample_telemetry();
+            next_sample += sample_interval;
+        }
+        if (now >= next_report) {
+            report();
+            next_report += report_interval;
+        }
+        // Short naps so stop() is honoured promptly
+        std::this_thread::sleep_for(std::min<std::chrono::milliseconds>(sample_interval, std::chrono::milliseconds(100)));
     }
 }
 
+// Copies counters that already exist (atomics owned by their threads) into the segment
+void PerformanceMonitor::sample_telemetry() {
+    using telemetry::Counter;
+    telemetry::TelemetrySegment& seg = telemetry::TelemetrySegment::get_instance();
+
+    seg.set(Counter::MESSAGES, feed_pool_.get_message_count());
+    seg.set(Counter::BOOKS, orderbook_manager_.size());
+    seg.set(Counter::BOOK_RESYNCS, feed_pool_.get_resync_count());
+    seg.set(Counter::DUPLICATES, feed_pool_.get_duplicate_count());
+    seg.set(Counter::PARSE_ERRORS, feed_pool_.get_parse_error_count());
+    seg.set(Counter::HOT_PATH_ALLOCATIONS, feed_pool_.get_hot_path_allocations());
+    seg.set(Counter::RECONNECTS_PUBLIC, feed_pool_.get_reconnect_count());
+    seg.set(Counter::MAX_RECOVERY_MS, feed_pool_.get_max_recovery_ms());
+    seg.set(Counter::LOG_DROPPED, data_logger_.get_dropped_count());
+    seg.set(Counter::RISK_REJECTS, RiskGate::get_instance().get_rejected_total());
+
+    uint64_t published = feed_pool_.get_aeron_count();
+    uint64_t backpressure = feed_pool_.get_aeron_backpressure();
+    if (aeron_) {
+        published += aeron_->get_messages_sent();
+        backpressure += aeron_->get_offer_failures();
+    }
+    seg.set(Counter::AERON_PUBLISHED, published);
+    seg.set(Counter::AERON_BACKPRESSURE, backpressure);
+
+    uint64_t private_reconnects = 0;
+    for (const auto* client : private_clients_) private_reconnects += client->get_reconnect_count();
+    seg.set(Counter::RECONNECTS_PRIVATE, private_reconnects);
+
+    if (scheduler_) {
+        seg.set(Counter::ENGINE_CYCLES, scheduler_->get_cycles());
+        seg.set(Counter::ENGINE_STEALS, scheduler_->get_steals());
+    }
+
+    for (const auto& entry : orderbook_manager_.get_all()) {
+        telemetry::SymbolCounters& slot = seg.symbol(entry.id);
+        telemetry::store(slot.messages, feed_pool_.get_symbol_messages(entry.id));
+        telemetry::store(slot.parse_errors, feed_pool_.get_symbol_parse_errors(entry.id));
+        telemetry::store(slot.book_updates, entry.book->get_update_count());
+        telemetry::store(slot.book_valid, entry.book->is_valid() ? 1 : 0);
+    }
+    seg.heartbeat();
+}
+
+void PerformanceMonitor::report() {
+    LatencyRecorder& latency = LatencyRecorder::get_instance();
+
+    if (latency.enabled()) {
+        std::cout << "\n⏱️  Latency (us)          count      p50      p99    p99.9      max\n";
+        for (size_t s = 0; s < LATENCY_STAGES; s++) {
+            auto stage = static_cast<LatencyStage>(s);
+            const auto& h = latency.total(stage);
+            if (h.count() == 0) continue;
+
+            char line[128];
+            std::snprintf(line, sizeof(line), "  %-18s %10llu %8.1f %8.1f %8.1f %8.1f\n",
+                          LatencyRecorder::stage_name(stage),
+                          static_cast<unsigned long long>(h.count()),
+                          h.percentile(50.0) / 1000.0, h.percentile(99.0) / 1000.0,
+                          h.percentile(99.9) / 1000.0, h.max() / 1000.0);
+            std::cout << line;
+        }
+
+        if (!config_.latency_export_path.empty() && !latency.write_json(config_.latency_export_path)) {
+            std::cerr << "⚠️  Could not write latency export " << config_.latency_export_path << "\n";
+        }
+    }
+
+    data_logger_.log_statistics(feed_pool_.get_message_count(), feed_pool_.get_aeron_count(),
+                                orderbook_manager_.size());
+}
+
 void PerformanceMonitor::stop() {
     running_ = false;
 }
-
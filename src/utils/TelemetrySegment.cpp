@@ -0,0 +1,162 @@
+#include "utils/TelemetrySegment.h"
+#include <chrono>
+#include <cstring>
+#include <iostream>
+#include <new>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+namespace telemetry {
+
+namespace {
+int64_t unix_ns() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::system_clock::now().time_since_epoch()).count();
+}
+}
+
+const char* counter_name(Counter counter) {
+    switch (counter) {
+        case Counter::MESSAGES:             return "messages";
+        case Counter::BOOKS:                return "books";
+        case Counter::BOOK_RESYNCS:         return "book_resyncs";
+        case Counter::DUPLICATES:           return "duplicates";
+        case Counter::PARSE_ERRORS:         return "parse_errors";
+        case Counter::HOT_PATH_ALLOCATIONS: return "hot_path_allocations";
+        case Counter::AERON_PUBLISHED:      return "aeron_published";
+        case Counter::AERON_BACKPRESSURE:   return "aeron_backpressure";
+        case Counter::RECONNECTS_PUBLIC:    return "reconnects_public";
+        case Counter::RECONNECTS_PRIVATE:   return "reconnects_private";
+        case Counter::MAX_RECOVERY_MS:      return "max_recovery_ms";
+        case Counter::ENGINE_CYCLES:        return "engine_cycles";
+        case Counter::ENGINE_STEALS:        return "engine_steals";
+        case Counter::LOG_DROPPED:          return "log_dropped";
+        case Counter::RISK_REJECTS:         return "risk_rejects";
+        case Counter::COUNT:                break;
+    }
+    return "unknown";
+}
+
+const char* engine_state_name(int32_t state) {
+    static const char* const names[] = {
+        "IDLE", "PLACING_ORDER", "WORKING", "IN_POSITION", "CANCELLING", "RECOVERING"
+    };
+    if (state < 0) return "-";
+    if (static_cast<size_t>(state) >= sizeof(names) / sizeof(names[0])) return "UNKNOWN";
+    return names[state];
+}
+
+// ============================================================================
+// WRITER
+// ============================================================================
+
+TelemetrySegment::TelemetrySegment()
+    : local_(std::make_unique<Layout>()),
+      layout_(local_.get())
+{
+    for (auto& slot : layout_->symbols) slot.engine_state.store(-1, std::memory_order_relaxed);
+}
+
+TelemetrySegment::~TelemetrySegment() {
+    if (mapped_) {
+        munmap(mapped_, sizeof(Layout));
+        unlink(path_.c_str());      // A clean exit leaves nothing behind in /dev/shm
+    }
+}
+
+bool TelemetrySegment::open(const std::string& path, const std::string& instance) {
+    if (mapped_) return true;
+
+    int fd = ::open(path.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644);
+    if (fd < 0) {
+        std::cerr << "❌ Telemetry: cannot create " << path << "\n";
+        return false;
+    }
+    if (ftruncate(fd, static_cast<off_t>(sizeof(Layout))) != 0) {
+        std::cerr << "❌ Telemetry: cannot size " << path << "\n";
+        ::close(fd);
+        return false;
+    }
+    void* mem = mmap(nullptr, sizeof(Layout), PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    ::close(fd);
+    if (mem == MAP_FAILED) {
+        std::cerr << "❌ Telemetry: mmap failed for " << path << "\n";
+        return false;
+    }
+
+    // The file is zero-filled, which is every atomic's initial value
+    Layout* layout = static_cast<Layout*>(mem);
+    for (auto& slot : layout->symbols) slot.engine_state.store(-1, std::memory_order_relaxed);
+
+    Header& h = layout->header;
+    h.version = VERSION;
+    h.max_symbols = MAX_SYMBOLS;
+    h.counter_count = static_cast<uint32_t>(COUNTERS);
+    h.pid = static_cast<int32_t>(getpid());
+    h.start_unix_ns = unix_ns();
+    std::strncpy(h.instance, instance.c_str(), sizeof(h.instance) - 1);
+    h.heartbeat_unix_ns.store(h.start_unix_ns, std::memory_order_relaxed);
+
+    // Magic last: a reader that sees it sees a complete header
+    std::atomic_thread_fence(std::memory_order_release);
+    h.magic = MAGIC;
+
+    mapped_ = mem;
+    layout_ = layout;
+    path_ = path;
+    std::cout << "✓ Telemetry segment: " << path << "\n";
+    return true;
+}
+
+SymbolCounters& TelemetrySegment::symbol(uint32_t symbol_id) {
+    if (symbol_id >= MAX_SYMBOLS) return overflow_;
+    SymbolCounters& slot = layout_->symbols[symbol_id];
+    if (slot.active.load(std::memory_order_acquire)) return slot;
+
+    const std::string& name = SymbolRegistry::get_instance().name(symbol_id);
+    std::strncpy(slot.symbol, name.c_str(), sizeof(slot.symbol) - 1);
+    slot.active.store(1, std::memory_order_release);
+
+    uint32_t limit = layout_->header.symbol_limit.load(std::memory_order_relaxed);
+    if (symbol_id + 1 > limit) layout_->header.symbol_limit.store(symbol_id + 1, std::memory_order_release);
+    return slot;
+}
+
+void TelemetrySegment::heartbeat() {
+    layout_->header.heartbeat_unix_ns.store(unix_ns(), std::memory_order_release);
+}
+
+// ============================================================================
+// READER
+// ============================================================================
+
+const Layout* TelemetrySegment::map_readonly(const std::string& path) {
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) return nullptr;
+
+    struct stat st;
+    if (fstat(fd, &st) != 0 || static_cast<size_t>(st.st_size) < sizeof(Layout)) {
+        ::close(fd);
+        return nullptr;
+    }
+    void* mem = mmap(nullptr, sizeof(Layout), PROT_READ, MAP_SHARED, fd, 0);
+    ::close(fd);
+    if (mem == MAP_FAILED) return nullptr;
+
+    const Layout* layout = static_cast<const Layout*>(mem);
+    if (layout->header.magic != MAGIC || layout->header.version != VERSION ||
+        layout->header.max_symbols != MAX_SYMBOLS) {
+        munmap(mem, sizeof(Layout));
+        return nullptr;
+    }
+    std::atomic_thread_fence(std::memory_order_acquire);
+    return layout;
+}
+
+void TelemetrySegment::unmap(const Layout* layout) {
+    if (layout) munmap(const_cast<Layout*>(layout), sizeof(Layout));
+}
+
+} // namespace telemetry
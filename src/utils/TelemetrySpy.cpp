@@ -0,0 +1,256 @@
+// src/utils/TelemetrySpy.cpp
+// Reads the shared-memory telemetry segments (BotConfiguration::telemetry_enabled) of
+// running bots, without touching their hot paths.
+//
+//   telemetry_spy [--watch SECONDS] [--prometheus [--out FILE]] [--symbols N] [<path>...]
+//
+// <path> is a segment file or a directory scanned for trading_bot.*.telemetry
+// (default /dev/shm, so every instance on the host is shown). --prometheus prints the
+// text exposition format; with --watch and --out it keeps FILE up to date for the
+// node_exporter textfile collector.
+#include <iostream>
+#include <atomic>
+#include <algorithm>
+#include <chrono>
+#include <csignal>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+#include <dirent.h>
+#include <sys/stat.h>
+
+#include "utils/TelemetrySegment.h"
+
+using telemetry::Counter;
+using telemetry::Layout;
+using telemetry::SymbolCounters;
+
+std::atomic<bool> running(true);
+void sig_handler(int) { running = false; }
+
+static void print_usage() {
+    std::cerr << "Usage: telemetry_spy [--watch SECONDS] [--prometheus [--out FILE]] [--symbols N] [<path>...]\n"
+              << "  --watch S     Refresh every S seconds (rates are per second over the interval)\n"
+              << "  --prometheus  Prometheus text format instead of the table\n"
+              << "  --out FILE    Write to FILE (atomically) instead of stdout\n"
+              << "  --symbols N   Busiest N symbols in the table (default 10; engines always shown)\n"
+              << "  <path>        Segment file or directory (default /dev/shm)\n";
+}
+
+static int64_t unix_ns() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::system_clock::now().time_since_epoch()).count();
+}
+
+static uint64_t load(const std::atomic<uint64_t>& v) { return v.load(std::memory_order_relaxed); }
+
+// Counters that are levels rather than running totals
+static bool is_gauge(Counter c) { return c == Counter::BOOKS || c == Counter::MAX_RECOVERY_MS; }
+
+static std::vector<std::string> find_segments(const std::vector<std::string>& paths) {
+    std::vector<std::string> files;
+    for (const auto& path : paths) {
+        struct stat st;
+        if (stat(path.c_str(), &st) != 0) continue;
+        if (!S_ISDIR(st.st_mode)) {
+            files.push_back(path);
+            continue;
+        }
+        DIR* dir = opendir(path.c_str());
+        if (!dir) continue;
+        while (dirent* e = readdir(dir)) {
+            std::string name = e->d_name;
+            if (name.rfind("trading_bot.", 0) == 0 && name.size() > 10 &&
+                name.compare(name.size() - 10, 10, ".telemetry") == 0) {
+                files.push_back(path + "/" + name);
+            }
+        }
+        closedir(dir);
+    }
+    std::sort(files.begin(), files.end());
+    return files;
+}
+
+// ============================================================================
+// TABLE
+// ============================================================================
+
+// Previous message counts per file/symbol for the rate column
+using RateMemory = std::unordered_map<std::string, std::vector<uint64_t>>;
+
+static void print_table(std::ostream& out, const std::string& path, const Layout& seg,
+                        RateMemory& previous, double interval_s, size_t top_symbols) {
+    const auto& h = seg.header;
+    double age_s = (unix_ns() - h.heartbeat_unix_ns.load(std::memory_order_acquire)) / 1e9;
+    double uptime_s = (unix_ns() - h.start_unix_ns) / 1e9;
+
+    out << "═══ " << h.instance << " (pid " << h.pid << ", " << path << ")\n";
+    char line[256];
+    std::snprintf(line, sizeof(line), "    up %.0fs, heartbeat %.1fs ago%s\n",
+                  uptime_s, age_s, age_s > 5.0 ? "  ⚠️ STALE" : "");
+    out << line;
+
+    for (size_t c = 0; c < telemetry::COUNTERS; c++) {
+        std::snprintf(line, sizeof(line), "    %-22s %llu\n", telemetry::counter_name(static_cast<Counter>(c)),
+                      static_cast<unsigned long long>(load(seg.counters[c])));
+        out << line;
+    }
+
+    uint32_t limit = std::min(h.symbol_limit.load(std::memory_order_acquire), telemetry::MAX_SYMBOLS);
+    auto& prev = previous[path];
+    prev.resize(telemetry::MAX_SYMBOLS, 0);
+
+    struct Row { uint32_t id; double rate; };
+    std::vector<Row> rows;
+    for (uint32_t id = 0; id < limit; id++) {
+        const SymbolCounters& s = seg.symbols[id];
+        if (!s.active.load(std::memory_order_acquire)) continue;
+        uint64_t msgs = load(s.messages);
+        double rate = interval_s > 0 && prev[id] ? (msgs - prev[id]) / interval_s : 0.0;
+        prev[id] = msgs;
+        rows.push_back({id, rate});
+    }
+    std::sort(rows.begin(), rows.end(), [&](const Row& a, const Row& b) {
+        bool ea = seg.symbols[a.id].engine_state.load(std::memory_order_relaxed) >= 0;
+        bool eb = seg.symbols[b.id].engine_state.load(std::memory_order_relaxed) >= 0;
+        if (ea != eb) return ea;
+        if (a.rate != b.rate) return a.rate > b.rate;
+        return load(seg.symbols[a.id].messages) > load(seg.symbols[b.id].messages);
+    });
+
+    out << "    symbol          msg/s    messages  updates  errs valid state          position  orders  rtt avg/max (us)\n";
+    size_t shown = 0;
+    for (const auto& row : rows) {
+        const SymbolCounters& s = seg.symbols[row.id];
+        int32_t state = s.engine_state.load(std::memory_order_relaxed);
+        if (state < 0 && shown >= top_symbols) continue;
+        shown++;
+
+        uint64_t rtt_n = load(s.order_rtt_count);
+        double rtt_avg = rtt_n ? load(s.order_rtt_sum_ns) / static_cast<double>(rtt_n) / 1000.0 : 0.0;
+        std::snprintf(line, sizeof(line), "    %-14.14s %7.1f %11llu %8llu %5llu %5s %-14s %8lld %7llu  %.0f/%.0f\n",
+                      s.symbol, row.rate,
+                      static_cast<unsigned long long>(load(s.messages)),
+                      static_cast<unsigned long long>(load(s.book_updates)),
+                      static_cast<unsigned long long>(load(s.parse_errors)),
+                      load(s.book_valid) ? "yes" : "NO",
+                      telemetry::engine_state_name(state),
+                      static_cast<long long>(s.position_lots.load(std::memory_order_relaxed)),
+                      static_cast<unsigned long long>(load(s.orders_sent)),
+                      rtt_avg, load(s.order_rtt_max_ns) / 1000.0);
+        out << line;
+    }
+    out << "\n";
+}
+
+// ============================================================================
+// PROMETHEUS
+// ============================================================================
+
+static void print_prometheus(std::ostream& out, const Layout& seg) {
+    const auto& h = seg.header;
+    std::string inst = std::string("instance_name=\"") + h.instance + "\"";
+    double age_s = (unix_ns() - h.heartbeat_unix_ns.load(std::memory_order_acquire)) / 1e9;
+
+    out << "trading_bot_heartbeat_age_seconds{" << inst << "} " << age_s << "\n";
+    for (size_t c = 0; c < telemetry::COUNTERS; c++) {
+        Counter counter = static_cast<Counter>(c);
+        out << "trading_bot_" << telemetry::counter_name(counter) << (is_gauge(counter) ? "" : "_total")
+            << "{" << inst << "} " << load(seg.counters[c]) << "\n";
+    }
+
+    uint32_t limit = std::min(h.symbol_limit.load(std::memory_order_acquire), telemetry::MAX_SYMBOLS);
+    for (uint32_t id = 0; id < limit; id++) {
+        const SymbolCounters& s = seg.symbols[id];
+        if (!s.active.load(std::memory_order_acquire)) continue;
+        std::string labels = "{" + inst + ",symbol=\"" + s.symbol + "\"}";
+
+        out << "trading_bot_symbol_messages_total" << labels << " " << load(s.messages) << "\n";
+        out << "trading_bot_symbol_book_updates_total" << labels << " " << load(s.book_updates) << "\n";
+        out << "trading_bot_symbol_parse_errors_total" << labels << " " << load(s.parse_errors) << "\n";
+        out << "trading_bot_symbol_book_valid" << labels << " " << load(s.book_valid) << "\n";
+
+        int32_t state = s.engine_state.load(std::memory_order_relaxed);
+        if (state < 0) continue;      // No engine on this symbol
+        out << "trading_bot_symbol_engine_state" << labels << " " << state << "\n";
+        out << "trading_bot_symbol_position_lots" << labels << " "
+            << s.position_lots.load(std::memory_order_relaxed) << "\n";
+        out << "trading_bot_symbol_orders_sent_total" << labels << " " << load(s.orders_sent) << "\n";
+        out << "trading_bot_symbol_order_rtt_seconds_count" << labels << " " << load(s.order_rtt_count) << "\n";
+        out << "trading_bot_symbol_order_rtt_seconds_sum" << labels << " " << load(s.order_rtt_sum_ns) / 1e9 << "\n";
+        out << "trading_bot_symbol_order_rtt_last_seconds" << labels << " " << load(s.order_rtt_last_ns) / 1e9 << "\n";
+        out << "trading_bot_symbol_order_rtt_max_seconds" << labels << " " << load(s.order_rtt_max_ns) / 1e9 << "\n";
+        out << "trading_bot_symbol_inbox_full_waits_total" << labels << " " << load(s.inbox_full_waits) << "\n";
+    }
+}
+
+// ============================================================================
+// MAIN
+// ============================================================================
+
+int main(int argc, char** argv) {
+    std::signal(SIGINT, sig_handler);
+    std::signal(SIGTERM, sig_handler);
+
+    double watch_s = 0.0;
+    bool prometheus = false;
+    size_t top_symbols = 10;
+    std::string out_path;
+    std::vector<std::string> paths;
+
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        if (arg == "--watch" && i + 1 < argc) {
+            watch_s = std::atof(argv[++i]);
+        } else if (arg == "--prometheus") {
+            prometheus = true;
+        } else if (arg == "--out" && i + 1 < argc) {
+            out_path = argv[++i];
+        } else if (arg == "--symbols" && i + 1 < argc) {
+            top_symbols = static_cast<size_t>(std::atoi(argv[++i]));
+        } else if (!arg.empty() && arg[0] == '-') {
+            print_usage();
+            return 1;
+        } else {
+            paths.push_back(arg);
+        }
+    }
+    if (paths.empty()) paths.push_back("/dev/shm");
+
+    RateMemory previous;
+    do {
+        std::ostringstream out;
+        auto files = find_segments(paths);
+        for (const auto& file : files) {
+            // Re-mapped every pass: instances come and go, files are replaced on restart
+            const Layout* seg = telemetry::TelemetrySegment::map_readonly(file);
+            if (!seg) continue;
+            if (prometheus) print_prometheus(out, *seg);
+            else print_table(out, file, *seg, previous, watch_s, top_symbols);
+            telemetry::TelemetrySegment::unmap(seg);
+        }
+        if (files.empty() && !prometheus) out << "No telemetry segments found\n";
+
+        if (out_path.empty()) {
+            std::cout << out.str() << std::flush;
+        } else {
+            std::string tmp_path = out_path + ".tmp";
+            std::ofstream(tmp_path, std::ios::trunc) << out.str();
+            std::rename(tmp_path.c_str(), out_path.c_str());
+        }
+
+        if (watch_s > 0) {
+            auto until = std::chrono::steady_clock::now() + std::chrono::duration<double>(watch_s);
+            while (running && std::chrono::steady_clock::now() < until) {
+                std::this_thread::sleep_for(std::chrono::milliseconds(50));
+            }
+        }
+    } while (watch_s > 0 && running);
+
+    return 0;
+}
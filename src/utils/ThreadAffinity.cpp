@@ -0,0 +1,90 @@
+#include "utils/ThreadAffinity.h"
+#include <iostream>
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <pthread.h>
+
+#if defined(__linux__)
+#include <sched.h>
+#include <dirent.h>
+#endif
+
+bool thread_affinity::pin_current_thread(int core) {
+    if (core < 0) return false;
+
+#if defined(__linux__)
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    CPU_SET(core, &set);
+    int rc = pthread_setaffinity_np(pthread_self(), sizeof(set), &set);
+    if (rc != 0) {
+        std::cerr << "⚠️  Failed to pin thread to core " << core << " (error " << rc << ")\n";
+        return false;
+    }
+    return true;
+#else
+    std::cerr << "⚠️  Thread pinning not supported on this platform (core " << core << " ignored)\n";
+    return false;
+#endif
+}
+
+bool thread_affinity::set_current_thread_fifo(int priority) {
+    if (priority <= 0) return false;
+
+#if defined(__linux__)
+    sched_param param{};
+    param.sched_priority = std::min(priority, sched_get_priority_max(SCHED_FIFO));
+    int rc = pthread_setschedparam(pthread_self(), SCHED_FIFO, &param);
+    if (rc != 0) {
+        std::cerr << "⚠️  Failed to set SCHED_FIFO " << priority << " (" << std::strerror(rc)
+                  << "; needs CAP_SYS_NICE or an rtprio limit)\n";
+        return false;
+    }
+    return true;
+#else
+    std::cerr << "⚠️  SCHED_FIFO not supported on this platform (priority " << priority << " ignored)\n";
+    return false;
+#endif
+}
+
+void thread_affinity::set_current_thread_name(const std::string& name) {
+#if defined(__linux__)
+    pthread_setname_np(pthread_self(), name.substr(0, 15).c_str());
+#elif defined(__APPLE__)
+    pthread_setname_np(name.c_str());
+#endif
+}
+
+std::string thread_affinity::apply_placement(const std::string& name, const ThreadPlacement& placement) {
+    if (!name.empty()) set_current_thread_name(name);
+    bool pinned = pin_current_thread(placement.core);
+    bool fifo = set_current_thread_fifo(placement.fifo_priority);
+
+    std::string applied;
+    if (pinned) applied = "core " + std::to_string(placement.core);
+    if (fifo) applied += (applied.empty() ? "FIFO " : ", FIFO ") + std::to_string(placement.fifo_priority);
+    return applied.empty() ? applied : " (" + applied + ")";
+}
+
+int thread_affinity::numa_node_of_core(int core) {
+    if (core < 0) return -1;
+
+#if defined(__linux__)
+    // /sys/devices/system/cpu/cpuN/ holds a "nodeK" link on NUMA kernels
+    std::string path = "/sys/devices/system/cpu/cpu" + std::to_string(core);
+    DIR* dir = opendir(path.c_str());
+    if (!dir) return -1;
+    int node = -1;
+    while (dirent* entry = readdir(dir)) {
+        if (std::strncmp(entry->d_name, "node", 4) == 0 && entry->d_name[4] >= '0' && entry->d_name[4] <= '9') {
+            node = std::atoi(entry->d_name + 4);
+            break;
+        }
+    }
+    closedir(dir);
+    return node;
+#else
+    return -1;
+#endif
+}